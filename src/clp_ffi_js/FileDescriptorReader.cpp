@@ -0,0 +1,126 @@
+#include "FileDescriptorReader.hpp"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstddef>
+#include <format>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include <clp/ErrorCode.hpp>
+#include <spdlog/spdlog.h>
+
+#include <clp_ffi_js/ClpFfiJsException.hpp>
+
+namespace clp_ffi_js {
+FileDescriptorReader::FileDescriptorReader(std::string const& path)
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg)
+        : m_fd{::open(path.c_str(), O_RDONLY)} {
+    if (-1 == m_fd) {
+        throw ClpFfiJsException{
+                clp::ErrorCode::ErrorCode_errno,
+                __FILENAME__,
+                __LINE__,
+                std::format(
+                        "Failed to open {}: {}",
+                        path,
+                        std::generic_category().message(errno)
+                )
+        };
+    }
+}
+
+FileDescriptorReader::~FileDescriptorReader() {
+    if (0 != ::close(m_fd)) {
+        SPDLOG_ERROR(
+                "Failed to close file descriptor: {}",
+                std::generic_category().message(errno)
+        );
+    }
+}
+
+auto FileDescriptorReader::read_file(std::string const& path) -> std::vector<char> {
+    FileDescriptorReader reader{path};
+    std::vector<char> data(reader.get_size());
+    size_t num_bytes_read{0};
+    if (false == data.empty()) {
+        auto const error_code{reader.try_read(data.data(), data.size(), num_bytes_read)};
+        if (clp::ErrorCode_Success != error_code || data.size() != num_bytes_read) {
+            throw ClpFfiJsException{
+                    clp::ErrorCode::ErrorCode_Truncated,
+                    __FILENAME__,
+                    __LINE__,
+                    std::format(
+                            "Failed to read {}: read {} of {} bytes",
+                            path,
+                            num_bytes_read,
+                            data.size()
+                    )
+            };
+        }
+    }
+    return data;
+}
+
+auto FileDescriptorReader::try_read(char* buf, size_t num_bytes_to_read, size_t& num_bytes_read)
+        -> clp::ErrorCode {
+    if (nullptr == buf && num_bytes_to_read > 0) {
+        return clp::ErrorCode_BadParam;
+    }
+
+    num_bytes_read = 0;
+    while (num_bytes_read < num_bytes_to_read) {
+        auto const result{::read(m_fd, buf + num_bytes_read, num_bytes_to_read - num_bytes_read)};
+        if (-1 == result) {
+            if (EINTR == errno) {
+                continue;
+            }
+            return clp::ErrorCode_errno;
+        }
+        if (0 == result) {
+            break;
+        }
+        num_bytes_read += static_cast<size_t>(result);
+    }
+    m_pos += num_bytes_read;
+
+    if (0 == num_bytes_read && num_bytes_to_read > 0) {
+        return clp::ErrorCode_EndOfFile;
+    }
+    return clp::ErrorCode_Success;
+}
+
+auto FileDescriptorReader::try_seek_from_begin(size_t pos) -> clp::ErrorCode {
+    if (-1 == ::lseek(m_fd, static_cast<off_t>(pos), SEEK_SET)) {
+        return clp::ErrorCode_errno;
+    }
+    m_pos = pos;
+    return clp::ErrorCode_Success;
+}
+
+auto FileDescriptorReader::try_get_pos(size_t& pos) -> clp::ErrorCode {
+    pos = m_pos;
+    return clp::ErrorCode_Success;
+}
+
+auto FileDescriptorReader::get_size() const -> size_t {
+    struct stat file_stat{};
+    if (0 != ::fstat(m_fd, &file_stat)) {
+        throw ClpFfiJsException{
+                clp::ErrorCode::ErrorCode_errno,
+                __FILENAME__,
+                __LINE__,
+                std::format(
+                        "Failed to get the file's size: {}",
+                        std::generic_category().message(errno)
+                )
+        };
+    }
+    return static_cast<size_t>(file_stat.st_size);
+}
+}  // namespace clp_ffi_js
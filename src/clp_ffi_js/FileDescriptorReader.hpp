@@ -0,0 +1,86 @@
+#ifndef CLP_FFI_JS_FILEDESCRIPTORREADER_HPP
+#define CLP_FFI_JS_FILEDESCRIPTORREADER_HPP
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <clp/ErrorCode.hpp>
+#include <clp/ReaderInterface.hpp>
+
+namespace clp_ffi_js {
+/**
+ * A `clp::ReaderInterface` that reads a file through a POSIX file descriptor, so that only the
+ * bytes a caller asks for are held in memory at a time.
+ *
+ * In Node.js builds, the module is linked with `NODERAWFS`, so paths refer to the host's
+ * filesystem.
+ */
+class FileDescriptorReader : public clp::ReaderInterface {
+public:
+    // Constructors
+    /**
+     * Opens the file at the given path for reading.
+     * @param path
+     * @throw ClpFfiJsException if the file couldn't be opened.
+     */
+    explicit FileDescriptorReader(std::string const& path);
+
+    // Disable copy/move constructors and assignment operators since the instance owns the file
+    // descriptor.
+    FileDescriptorReader(FileDescriptorReader const&) = delete;
+    FileDescriptorReader(FileDescriptorReader&&) = delete;
+    auto operator=(FileDescriptorReader const&) -> FileDescriptorReader& = delete;
+    auto operator=(FileDescriptorReader&&) -> FileDescriptorReader& = delete;
+
+    // Destructor
+    ~FileDescriptorReader() override;
+
+    /**
+     * Reads an entire file into memory.
+     * @param path
+     * @return The file's contents.
+     * @throw ClpFfiJsException if the file couldn't be opened or read.
+     */
+    [[nodiscard]] static auto read_file(std::string const& path) -> std::vector<char>;
+
+    // Methods implementing `clp::ReaderInterface`
+    /**
+     * @param buf
+     * @param num_bytes_to_read
+     * @param num_bytes_read Returns the number of bytes read.
+     * @return clp::ErrorCode_EndOfFile if the end of the file was reached.
+     * @return clp::ErrorCode_errno if the file couldn't be read.
+     * @return clp::ErrorCode_Success on success.
+     */
+    [[nodiscard]] auto try_read(char* buf, size_t num_bytes_to_read, size_t& num_bytes_read)
+            -> clp::ErrorCode override;
+
+    /**
+     * @param pos
+     * @return clp::ErrorCode_errno if the file couldn't be seeked.
+     * @return clp::ErrorCode_Success on success.
+     */
+    [[nodiscard]] auto try_seek_from_begin(size_t pos) -> clp::ErrorCode override;
+
+    /**
+     * @param pos Returns the current position in the file.
+     * @return clp::ErrorCode_Success
+     */
+    [[nodiscard]] auto try_get_pos(size_t& pos) -> clp::ErrorCode override;
+
+    // Methods
+    /**
+     * @return The size of the file, in bytes.
+     * @throw ClpFfiJsException if the file's size couldn't be determined.
+     */
+    [[nodiscard]] auto get_size() const -> size_t;
+
+private:
+    // Variables
+    int m_fd;
+    size_t m_pos{0};
+};
+}  // namespace clp_ffi_js
+
+#endif  // CLP_FFI_JS_FILEDESCRIPTORREADER_HPP
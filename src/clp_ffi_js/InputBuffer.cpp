@@ -0,0 +1,38 @@
+#include "InputBuffer.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include <emscripten/bind.h>
+#include <emscripten/val.h>
+
+#include <clp_ffi_js/binding_types.hpp>
+
+namespace clp_ffi_js {
+auto InputBuffer::get_view() -> DataArrayTsType {
+    // NOLINTBEGIN(cppcoreguidelines-pro-type-reinterpret-cast)
+    return DataArrayTsType{emscripten::val{emscripten::typed_memory_view(
+            m_buffer.size(),
+            reinterpret_cast<uint8_t*>(m_buffer.data())
+    )}};
+    // NOLINTEND(cppcoreguidelines-pro-type-reinterpret-cast)
+}
+
+EMSCRIPTEN_BINDINGS(ClpInputBuffer) {
+    emscripten::class_<InputBuffer>("ClpInputBuffer")
+            .constructor(
+                    emscripten::optional_override([](js_size_t size) {
+                        return std::make_unique<InputBuffer>(from_js_size(size));
+                    }),
+                    emscripten::return_value_policy::take_ownership()
+            )
+            .function("getView", &InputBuffer::get_view)
+            .function(
+                    "getSize",
+                    emscripten::optional_override([](InputBuffer const& self) {
+                        return to_js_size(self.get_size());
+                    })
+            );
+}
+}  // namespace clp_ffi_js
@@ -0,0 +1,59 @@
+#ifndef CLP_FFI_JS_INPUTBUFFER_HPP
+#define CLP_FFI_JS_INPUTBUFFER_HPP
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include <clp_ffi_js/binding_types.hpp>
+
+namespace clp_ffi_js {
+/**
+ * A buffer allocated in the WASM heap that JavaScript can fill directly (e.g., from a `fetch`
+ * response or `fs.read`), and that readers can then take ownership of without copying it.
+ */
+class InputBuffer {
+public:
+    // Constructors
+    /**
+     * @param size The size of the buffer, in bytes.
+     */
+    explicit InputBuffer(size_t size) : m_buffer(size) {}
+
+    // Disable copy constructor and assignment operator
+    InputBuffer(InputBuffer const&) = delete;
+    auto operator=(InputBuffer const&) -> InputBuffer& = delete;
+
+    // Default move constructor and assignment operator
+    InputBuffer(InputBuffer&&) = default;
+    auto operator=(InputBuffer&&) -> InputBuffer& = default;
+
+    // Destructor
+    ~InputBuffer() = default;
+
+    // Methods
+    /**
+     * NOTE: The returned view is invalidated if the WASM memory grows, or if the buffer is released
+     * to a reader; so it should be re-acquired rather than held across calls into the module.
+     *
+     * @return A writable `Uint8Array` view of the buffer.
+     */
+    [[nodiscard]] auto get_view() -> DataArrayTsType;
+
+    /**
+     * @return The size of the buffer, in bytes, or 0 if it has been released.
+     */
+    [[nodiscard]] auto get_size() const -> size_t { return m_buffer.size(); }
+
+    /**
+     * Releases the ownership of the underlying buffer, leaving this instance empty.
+     * @return The underlying buffer.
+     */
+    [[nodiscard]] auto release() -> std::vector<char> { return std::exchange(m_buffer, {}); }
+
+private:
+    std::vector<char> m_buffer;
+};
+}  // namespace clp_ffi_js
+
+#endif  // CLP_FFI_JS_INPUTBUFFER_HPP
@@ -1,8 +1,60 @@
+#include "binding_types.hpp"
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <limits>
+#include <span>
+#include <vector>
+
+#include <clp/ErrorCode.hpp>
 #include <emscripten/bind.h>
+#include <emscripten/val.h>
 
-#include <clp_ffi_js/binding_types.hpp>
+#include <clp_ffi_js/ClpFfiJsException.hpp>
 
 namespace clp_ffi_js {
+auto from_js_size(js_size_t value) -> size_t {
+    // 2^N, where N is `size_t`'s width, is exactly representable as a double, unlike `SIZE_MAX` in
+    // Memory64 builds.
+    static auto const cSizeLimit{std::ldexp(1.0, std::numeric_limits<size_t>::digits)};
+    if (false == (value >= 0) || value >= cSizeLimit || value != std::trunc(value)) {
+        throw ClpFfiJsException{
+                clp::ErrorCode::ErrorCode_BadParam,
+                __FILENAME__,
+                __LINE__,
+                std::format("{} isn't a valid size or index.", value)
+        };
+    }
+    return static_cast<size_t>(value);
+}
+
+auto to_js_array(std::vector<size_t> const& values) -> emscripten::val {
+#ifdef __wasm64__
+    std::vector<js_size_t> const js_values(values.cbegin(), values.cend());
+    return emscripten::val::array(js_values);
+#else
+    return emscripten::val::array(values);
+#endif
+}
+
+auto get_data_array_length(DataArrayTsType const& data_array) -> size_t {
+    return from_js_size(data_array["length"].as<js_size_t>());
+}
+
+auto copy_data_array(DataArrayTsType const& data_array, std::span<char> dest) -> void {
+    // Copy through a view of the destination, rather than passing `set` an offset into `HEAPU8`,
+    // since pointers aren't JavaScript numbers in Memory64 builds.
+    // NOLINTBEGIN(cppcoreguidelines-pro-type-reinterpret-cast)
+    emscripten::val{emscripten::typed_memory_view(
+                            dest.size(),
+                            reinterpret_cast<uint8_t*>(dest.data())
+                    )}
+            .call<void>("set", data_array);
+    // NOLINTEND(cppcoreguidelines-pro-type-reinterpret-cast)
+}
+
 EMSCRIPTEN_BINDINGS(ClpFfiJsBindingTypes) {
     // JS types used as inputs
     emscripten::register_type<DataArrayTsType>("Uint8Array");
@@ -1,6 +1,10 @@
 #ifndef CLP_FFI_JS_BINDING_TYPES_HPP
 #define CLP_FFI_JS_BINDING_TYPES_HPP
 
+#include <cstddef>
+#include <span>
+#include <vector>
+
 #include <emscripten/val.h>
 
 namespace clp_ffi_js {
@@ -9,6 +13,49 @@ EMSCRIPTEN_DECLARE_VAL_TYPE(DataArrayTsType);
 
 // JS types used as outputs
 EMSCRIPTEN_DECLARE_VAL_TYPE(StringArrayTsType);
+
+/**
+ * The type that sizes and indices are exchanged with JavaScript as.
+ *
+ * Embind maps `size_t` to `bigint` in Memory64 builds, whereas the JavaScript API uses `number` in
+ * every build, so sizes and indices are converted at the boundary. A `double` represents every
+ * integer up to 2^53 exactly.
+ */
+using js_size_t = double;
+
+/**
+ * @param value
+ * @return `value` as a JavaScript number.
+ */
+[[nodiscard]] inline auto to_js_size(size_t value) -> js_size_t {
+    return static_cast<js_size_t>(value);
+}
+
+/**
+ * @param value A size or index received from JavaScript.
+ * @return `value` as a `size_t`.
+ * @throw ClpFfiJsException if `value` isn't a non-negative integer within `size_t`'s range.
+ */
+[[nodiscard]] auto from_js_size(js_size_t value) -> size_t;
+
+/**
+ * @param values
+ * @return A JavaScript array of `values` as numbers.
+ */
+[[nodiscard]] auto to_js_array(std::vector<size_t> const& values) -> emscripten::val;
+
+/**
+ * @param data_array
+ * @return The length of `data_array`, in bytes.
+ */
+[[nodiscard]] auto get_data_array_length(DataArrayTsType const& data_array) -> size_t;
+
+/**
+ * Copies a JavaScript `Uint8Array` into the WASM heap.
+ * @param data_array
+ * @param dest The destination, which must be exactly as long as `data_array`.
+ */
+auto copy_data_array(DataArrayTsType const& data_array, std::span<char> dest) -> void;
 }  // namespace clp_ffi_js
 
 #endif  // CLP_FFI_JS_BINDING_TYPES_HPP
@@ -0,0 +1,122 @@
+#!/usr/bin/env node
+/**
+ * Command-line tool that builds a sidecar index for an IR stream file. Passing the index as the
+ * `index` reader option when the stream is opened skips deserializing it.
+ *
+ * Usage: clp-ffi-js-build-index [options] <stream-path> <index-path>
+ *
+ * @module
+ */
+import process from "node:process";
+import {parseArgs} from "node:util";
+
+import mainModuleFactory from "#clp-ffi-js/node";
+
+
+const USAGE = `Usage: clp-ffi-js-build-index [options] <stream-path> <index-path>
+
+Options:
+  --checkpoint-interval <n>  Number of log events between checkpoints (default: 10000).
+  --log-level-key <key>      Dot-separated path of the log level's key.
+  --timestamp-key <key>      Dot-separated path of the timestamp's key.
+  --utc-offset-key <key>     Dot-separated path of the UTC offset's key.
+  -h, --help                 Print this message.
+
+Keys are user-generated unless their path starts with "auto-generated.". A path may also start
+with "user-generated." to select a user-generated key whose first part is "auto-generated".
+`;
+
+const AUTO_GENERATED_KEY_PREFIX = "auto-generated.";
+const USER_GENERATED_KEY_PREFIX = "user-generated.";
+
+/**
+ * Converts a dot-separated key into a schema-tree path. Like the fields of format templates, the
+ * key selects an auto-generated key if it's prefixed with `auto-generated.`, and a user-generated
+ * key if it's prefixed with `user-generated.` or unprefixed.
+ *
+ * @param key
+ * @return The path, or null if `key` is undefined.
+ * @throws {Error} if the key's path is empty or has an empty part.
+ */
+const toSchemaTreePath = (
+    key: string | undefined
+): {isAutoGenerated: boolean; parts: string[]} | null => {
+    if ("undefined" === typeof key) {
+        return null;
+    }
+
+    let isAutoGenerated = false;
+    let path = key;
+    if (key.startsWith(AUTO_GENERATED_KEY_PREFIX)) {
+        isAutoGenerated = true;
+        path = key.slice(AUTO_GENERATED_KEY_PREFIX.length);
+    } else if (key.startsWith(USER_GENERATED_KEY_PREFIX)) {
+        path = key.slice(USER_GENERATED_KEY_PREFIX.length);
+    }
+
+    const parts = path.split(".");
+    if (parts.includes("")) {
+        throw new Error(`Invalid key: "${key}"`);
+    }
+
+    return {isAutoGenerated, parts};
+};
+
+/**
+ * Parses the command-line arguments, builds the index, and reports the result.
+ *
+ * @return The process's exit code.
+ */
+const main = async (): Promise<number> => {
+    const {values, positionals} = parseArgs({
+        allowPositionals: true,
+        options: {
+            "checkpoint-interval": {type: "string"},
+            "help": {type: "boolean", short: "h"},
+            "log-level-key": {type: "string"},
+            "timestamp-key": {type: "string"},
+            "utc-offset-key": {type: "string"},
+        },
+    });
+    if (true === values.help) {
+        process.stdout.write(USAGE);
+
+        return 0;
+    }
+
+    const [streamPath, indexPath] = positionals;
+    if ("undefined" === typeof streamPath || "undefined" === typeof indexPath ||
+        2 !== positionals.length) {
+        process.stderr.write(USAGE);
+
+        return 1;
+    }
+
+    let checkpointInterval: number | null = null;
+    if ("undefined" !== typeof values["checkpoint-interval"]) {
+        checkpointInterval = Number(values["checkpoint-interval"]);
+        if (false === Number.isInteger(checkpointInterval) || 1 > checkpointInterval) {
+            process.stderr.write("The checkpoint interval must be a positive integer.\n");
+
+            return 1;
+        }
+    }
+
+    const module = await mainModuleFactory();
+    const numEvents = module.ClpStreamReader.buildIndexFile(streamPath, indexPath, {
+        logLevelKey: toSchemaTreePath(values["log-level-key"]),
+        timestampKey: toSchemaTreePath(values["timestamp-key"]),
+        utcOffsetKey: toSchemaTreePath(values["utc-offset-key"]),
+        checkpointInterval,
+    });
+    process.stdout.write(`Indexed ${numEvents} log events from ${streamPath} into ${indexPath}.\n`);
+
+    return 0;
+};
+
+try {
+    process.exitCode = await main();
+} catch (e: unknown) {
+    process.stderr.write(`Failed to build the index: ${String(e)}\n`);
+    process.exitCode = 1;
+}
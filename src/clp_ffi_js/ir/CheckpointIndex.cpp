@@ -0,0 +1,134 @@
+#include "CheckpointIndex.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <format>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include <clp/ErrorCode.hpp>
+#include <clp/ReaderInterface.hpp>
+#include <clp/TraceableException.hpp>
+
+#include <clp_ffi_js/ClpFfiJsException.hpp>
+#include <clp_ffi_js/ir/Snapshot.hpp>
+
+namespace clp_ffi_js::ir {
+auto CheckpointIndex::create(size_t checkpoint_interval, clp::ReaderInterface& reader)
+        -> CheckpointIndex {
+    if (0 == checkpoint_interval) {
+        throw ClpFfiJsException{
+                clp::ErrorCode::ErrorCode_BadParam,
+                __FILENAME__,
+                __LINE__,
+                "The checkpoint interval must be positive."
+        };
+    }
+
+    auto const preamble_end_pos{reader.get_pos()};
+    std::vector<char> preamble(preamble_end_pos);
+    try {
+        // Reading the preamble leaves the reader back at `preamble_end_pos`.
+        reader.seek_from_begin(0);
+        reader.read_exact_length(preamble.data(), preamble.size());
+    } catch (clp::TraceableException const& e) {
+        throw ClpFfiJsException{
+                clp::ErrorCode::ErrorCode_Failure,
+                __FILENAME__,
+                __LINE__,
+                std::format("Failed to read the IR stream's preamble: {}", e.what())
+        };
+    }
+    return CheckpointIndex{checkpoint_interval, std::move(preamble)};
+}
+
+auto CheckpointIndex::read_snapshot(SnapshotReader& reader) -> CheckpointIndex {
+    auto const checkpoint_interval{reader.read_size()};
+    if (0 == checkpoint_interval) {
+        throw_corrupt_snapshot("The snapshot's checkpoint interval isn't positive.");
+    }
+    CheckpointIndex checkpoint_index{checkpoint_interval, reader.read_array<char>()};
+    checkpoint_index.m_replay_units = reader.read_array<char>();
+
+    auto const num_checkpoints{reader.read_size()};
+    for (size_t i{0}; i < num_checkpoints; ++i) {
+        Checkpoint const checkpoint{
+                .log_event_idx = reader.read_size(),
+                .decompressed_pos = reader.read_size(),
+                .replay_units_size = reader.read_size()
+        };
+        // `find_checkpoint` and `get_replay_prefix` rely on these invariants.
+        auto const& checkpoints{checkpoint_index.m_checkpoints};
+        if (checkpoint.replay_units_size > checkpoint_index.m_replay_units.size()
+            || (false == checkpoints.empty()
+                && checkpoint.log_event_idx <= checkpoints.back().log_event_idx))
+        {
+            throw_corrupt_snapshot("The snapshot contains an invalid checkpoint.");
+        }
+        checkpoint_index.m_checkpoints.push_back(checkpoint);
+    }
+    return checkpoint_index;
+}
+
+auto CheckpointIndex::add_checkpoint_if_due(size_t num_log_events, size_t decompressed_pos)
+        -> void {
+    if (0 != num_log_events % m_checkpoint_interval) {
+        return;
+    }
+    if (false == m_checkpoints.empty() && m_checkpoints.back().log_event_idx == num_log_events) {
+        return;
+    }
+    m_checkpoints.push_back({num_log_events, decompressed_pos, m_replay_units.size()});
+}
+
+auto CheckpointIndex::add_replay_unit(std::span<char const> ir_unit) -> void {
+    m_replay_units.insert(m_replay_units.end(), ir_unit.begin(), ir_unit.end());
+}
+
+auto CheckpointIndex::find_checkpoint(size_t log_event_idx) const -> Checkpoint const& {
+    auto const first_greater_it{std::ranges::upper_bound(
+            m_checkpoints,
+            log_event_idx,
+            {},
+            &Checkpoint::log_event_idx
+    )};
+    if (first_greater_it == m_checkpoints.begin()) {
+        throw ClpFfiJsException{
+                clp::ErrorCode::ErrorCode_Failure,
+                __FILENAME__,
+                __LINE__,
+                "No checkpoint precedes the log event."
+        };
+    }
+    return *(first_greater_it - 1);
+}
+
+auto CheckpointIndex::get_replay_prefix(Checkpoint const& checkpoint) const -> std::vector<char> {
+    std::vector<char> prefix;
+    prefix.reserve(m_preamble.size() + checkpoint.replay_units_size);
+    prefix.insert(prefix.end(), m_preamble.begin(), m_preamble.end());
+    prefix.insert(
+            prefix.end(),
+            m_replay_units.begin(),
+            m_replay_units.begin() + static_cast<std::ptrdiff_t>(checkpoint.replay_units_size)
+    );
+    return prefix;
+}
+
+auto CheckpointIndex::write_snapshot(SnapshotWriter& writer) const -> void {
+    writer.write_size(m_checkpoint_interval);
+    writer.write_array(std::span<char const>{m_preamble});
+    writer.write_array(std::span<char const>{m_replay_units});
+    writer.write_size(m_checkpoints.size());
+    for (auto const& checkpoint : m_checkpoints) {
+        writer.write_size(checkpoint.log_event_idx);
+        writer.write_size(checkpoint.decompressed_pos);
+        writer.write_size(checkpoint.replay_units_size);
+    }
+}
+
+CheckpointIndex::CheckpointIndex(size_t checkpoint_interval, std::vector<char> preamble)
+        : m_checkpoint_interval{checkpoint_interval},
+          m_preamble{std::move(preamble)} {}
+}  // namespace clp_ffi_js::ir
@@ -0,0 +1,105 @@
+#ifndef CLP_FFI_JS_IR_CHECKPOINTINDEX_HPP
+#define CLP_FFI_JS_IR_CHECKPOINTINDEX_HPP
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+#include <clp/ReaderInterface.hpp>
+
+#include <clp_ffi_js/ir/Snapshot.hpp>
+
+namespace clp_ffi_js::ir {
+/**
+ * An index of positions in a decompressed IR stream from which deserialization can be resumed,
+ * recorded every `checkpoint_interval` log events.
+ *
+ * Resuming from a checkpoint requires restoring the deserializer's state at that point. Since that
+ * state can only be built by deserializing IR units, the index retains the stream's preamble and
+ * every IR unit that modifies the state (e.g., schema-tree node insertions), so that they can be
+ * replayed before the stream's bytes from the checkpoint onwards (see `get_replay_prefix`).
+ */
+class CheckpointIndex {
+public:
+    // Types
+    struct Checkpoint {
+        // Index of the first log event after the checkpoint.
+        size_t log_event_idx;
+        // Position of the checkpoint in the decompressed stream.
+        size_t decompressed_pos;
+        // Number of bytes of retained IR units that precede the checkpoint.
+        size_t replay_units_size;
+    };
+
+    // Factory function
+    /**
+     * @param checkpoint_interval
+     * @param reader A reader positioned right after the IR stream's preamble. Its position is
+     * restored before returning.
+     * @return A `CheckpointIndex` that retains the preamble read from `reader`.
+     * @throw ClpFfiJsException if `checkpoint_interval` is 0 or the preamble couldn't be read.
+     */
+    [[nodiscard]] static auto create(size_t checkpoint_interval, clp::ReaderInterface& reader)
+            -> CheckpointIndex;
+
+    /**
+     * Reads an index written by `write_snapshot`.
+     * @param reader
+     * @return The read `CheckpointIndex`.
+     * @throw ClpFfiJsException if the snapshot is truncated or the index is invalid.
+     */
+    [[nodiscard]] static auto read_snapshot(SnapshotReader& reader) -> CheckpointIndex;
+
+    // Methods
+    /**
+     * Adds a checkpoint if `num_log_events` is a multiple of the checkpoint interval and there's no
+     * checkpoint for it yet.
+     * @param num_log_events The number of log events before `decompressed_pos`.
+     * @param decompressed_pos The position of the next IR unit in the decompressed stream.
+     */
+    auto add_checkpoint_if_due(size_t num_log_events, size_t decompressed_pos) -> void;
+
+    /**
+     * Retains an IR unit that must be replayed when resuming from any later checkpoint.
+     * @param ir_unit
+     */
+    auto add_replay_unit(std::span<char const> ir_unit) -> void;
+
+    /**
+     * @param log_event_idx
+     * @return The last checkpoint at or before the log event at `log_event_idx`.
+     * @throw ClpFfiJsException if no checkpoint has been added.
+     */
+    [[nodiscard]] auto find_checkpoint(size_t log_event_idx) const -> Checkpoint const&;
+
+    /**
+     * @param checkpoint
+     * @return The bytes that, when followed by the decompressed stream's bytes from `checkpoint`
+     * onwards, form an IR stream that deserializes the same log events from `checkpoint` onwards.
+     */
+    [[nodiscard]] auto get_replay_prefix(Checkpoint const& checkpoint) const -> std::vector<char>;
+
+    /**
+     * @return Every IR unit retained by `add_replay_unit`, in order.
+     */
+    [[nodiscard]] auto get_replay_units() const -> std::span<char const> { return m_replay_units; }
+
+    /**
+     * Writes the index to a snapshot.
+     * @param writer
+     */
+    auto write_snapshot(SnapshotWriter& writer) const -> void;
+
+private:
+    // Constructor
+    CheckpointIndex(size_t checkpoint_interval, std::vector<char> preamble);
+
+    // Variables
+    size_t m_checkpoint_interval;
+    std::vector<char> m_preamble;
+    std::vector<char> m_replay_units;
+    std::vector<Checkpoint> m_checkpoints;
+};
+}  // namespace clp_ffi_js::ir
+
+#endif  // CLP_FFI_JS_IR_CHECKPOINTINDEX_HPP
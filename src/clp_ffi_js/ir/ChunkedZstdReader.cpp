@@ -0,0 +1,110 @@
+#include "ChunkedZstdReader.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include <clp/ErrorCode.hpp>
+
+namespace clp_ffi_js::ir {
+namespace {
+/**
+ * Capacity of the buffer `ZstdDecompressor` uses to read compressed bytes from its input.
+ */
+constexpr size_t cCompressedReadBufferCapacity{64UL * 1024};
+}  // namespace
+
+ChunkedZstdReader::ChunkedZstdReader(std::vector<char> compressed_data)
+        : m_compressed_input{std::move(compressed_data)} {
+    m_decompressor.open(m_compressed_input, cCompressedReadBufferCapacity);
+}
+
+auto ChunkedZstdReader::try_read(char* buf, size_t num_bytes_to_read, size_t& num_bytes_read)
+        -> clp::ErrorCode {
+    if (nullptr == buf && num_bytes_to_read > 0) {
+        return clp::ErrorCode_BadParam;
+    }
+
+    // Serve as much as possible from the retained bytes.
+    auto const num_retained_bytes_to_read{
+            std::min(num_bytes_to_read, m_retained_bytes.size() - m_retained_read_idx)
+    };
+    std::copy_n(
+            m_retained_bytes.cbegin() + static_cast<std::ptrdiff_t>(m_retained_read_idx),
+            num_retained_bytes_to_read,
+            buf
+    );
+    m_retained_read_idx += num_retained_bytes_to_read;
+    num_bytes_read = num_retained_bytes_to_read;
+
+    // Decompress the rest, retaining the decompressed bytes in case they need to be re-read.
+    if (num_bytes_read < num_bytes_to_read) {
+        auto const num_bytes_remaining{num_bytes_to_read - num_bytes_read};
+        auto const old_num_retained_bytes{m_retained_bytes.size()};
+        m_retained_bytes.resize(old_num_retained_bytes + num_bytes_remaining);
+
+        size_t num_bytes_decompressed{0};
+        auto const err{m_decompressor.try_read(
+                m_retained_bytes.data() + old_num_retained_bytes,
+                num_bytes_remaining,
+                num_bytes_decompressed
+        )};
+        m_retained_bytes.resize(old_num_retained_bytes + num_bytes_decompressed);
+        if (clp::ErrorCode_Success != err && clp::ErrorCode_EndOfFile != err) {
+            return err;
+        }
+
+        std::copy_n(
+                m_retained_bytes.cbegin() + static_cast<std::ptrdiff_t>(old_num_retained_bytes),
+                num_bytes_decompressed,
+                buf + num_bytes_read
+        );
+        m_retained_read_idx += num_bytes_decompressed;
+        num_bytes_read += num_bytes_decompressed;
+    }
+
+    if (0 == num_bytes_read && num_bytes_to_read > 0) {
+        return clp::ErrorCode_EndOfFile;
+    }
+    return clp::ErrorCode_Success;
+}
+
+auto ChunkedZstdReader::try_seek_from_begin(size_t pos) -> clp::ErrorCode {
+    if (pos < m_checkpoint_pos) {
+        return clp::ErrorCode_Unsupported;
+    }
+
+    auto const retained_end_pos{m_checkpoint_pos + m_retained_bytes.size()};
+    if (pos <= retained_end_pos) {
+        m_retained_read_idx = pos - m_checkpoint_pos;
+        return clp::ErrorCode_Success;
+    }
+
+    // Decompress (and retain) the bytes up to `pos`.
+    m_retained_read_idx = m_retained_bytes.size();
+    std::vector<char> skipped_bytes(pos - retained_end_pos);
+    size_t num_bytes_read{0};
+    auto const err{try_read(skipped_bytes.data(), skipped_bytes.size(), num_bytes_read)};
+    if (clp::ErrorCode_EndOfFile == err
+        || (clp::ErrorCode_Success == err && num_bytes_read < skipped_bytes.size()))
+    {
+        return clp::ErrorCode_Truncated;
+    }
+    return err;
+}
+
+auto ChunkedZstdReader::try_get_pos(size_t& pos) -> clp::ErrorCode {
+    pos = m_checkpoint_pos + m_retained_read_idx;
+    return clp::ErrorCode_Success;
+}
+
+auto ChunkedZstdReader::checkpoint() -> void {
+    m_retained_bytes.erase(
+            m_retained_bytes.begin(),
+            m_retained_bytes.begin() + static_cast<std::ptrdiff_t>(m_retained_read_idx)
+    );
+    m_checkpoint_pos += m_retained_read_idx;
+    m_retained_read_idx = 0;
+}
+}  // namespace clp_ffi_js::ir
@@ -0,0 +1,136 @@
+#ifndef CLP_FFI_JS_IR_CHUNKEDZSTDREADER_HPP
+#define CLP_FFI_JS_IR_CHUNKEDZSTDREADER_HPP
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+#include <clp/ErrorCode.hpp>
+#include <clp/ReaderInterface.hpp>
+#include <clp/streaming_compression/zstd/Decompressor.hpp>
+
+#include <clp_ffi_js/ir/GrowableBufferReader.hpp>
+
+namespace clp_ffi_js::ir {
+/**
+ * A `clp::ReaderInterface` that decompresses a Zstandard-compressed stream whose compressed bytes
+ * arrive in chunks.
+ *
+ * Since rewinding a `ZstdDecompressor` means decompressing from the start of the stream, this class
+ * retains all the decompressed bytes read since the last checkpoint. This allows a consumer that
+ * runs out of input in the middle of an IR unit to rewind to the start of that unit and re-read it
+ * once more compressed bytes have been appended.
+ */
+class ChunkedZstdReader : public clp::ReaderInterface {
+public:
+    // Types
+    using ZstdDecompressor = clp::streaming_compression::zstd::Decompressor;
+
+    // Constructors
+    ChunkedZstdReader() : ChunkedZstdReader{std::vector<char>{}} {}
+
+    /**
+     * @param compressed_data The initially appended compressed bytes.
+     */
+    explicit ChunkedZstdReader(std::vector<char> compressed_data);
+
+    // Disable copy/move constructors and assignment operators since `ZstdDecompressor` holds a
+    // reference to `m_compressed_input`.
+    ChunkedZstdReader(ChunkedZstdReader const&) = delete;
+    ChunkedZstdReader(ChunkedZstdReader&&) = delete;
+    auto operator=(ChunkedZstdReader const&) -> ChunkedZstdReader& = delete;
+    auto operator=(ChunkedZstdReader&&) -> ChunkedZstdReader& = delete;
+
+    // Destructor
+    ~ChunkedZstdReader() override = default;
+
+    // Methods implementing `clp::ReaderInterface`
+    /**
+     * @param buf
+     * @param num_bytes_to_read
+     * @param num_bytes_read Returns the number of bytes read.
+     * @return clp::ErrorCode_EndOfFile if no more bytes can be decompressed from the compressed
+     * input appended so far.
+     * @return Forwards `ZstdDecompressor::try_read`'s other return values on failure.
+     * @return clp::ErrorCode_Success on success.
+     */
+    [[nodiscard]] auto try_read(char* buf, size_t num_bytes_to_read, size_t& num_bytes_read)
+            -> clp::ErrorCode override;
+
+    /**
+     * Seeks within the decompressed stream.
+     * @param pos
+     * @return clp::ErrorCode_Unsupported if `pos` is before the last checkpoint.
+     * @return clp::ErrorCode_Truncated if `pos` is beyond what can be decompressed so far.
+     * @return Forwards `try_read`'s return values on other failures.
+     * @return clp::ErrorCode_Success on success.
+     */
+    [[nodiscard]] auto try_seek_from_begin(size_t pos) -> clp::ErrorCode override;
+
+    /**
+     * @param pos Returns the current position in the decompressed stream.
+     * @return clp::ErrorCode_Success
+     */
+    [[nodiscard]] auto try_get_pos(size_t& pos) -> clp::ErrorCode override;
+
+    // Methods
+    /**
+     * Grows the compressed input by `num_bytes`.
+     *
+     * NOTE: The returned pointer is only valid until the next call to this method.
+     *
+     * @param num_bytes
+     * @return A pointer to the newly added region, which the caller must fill with the next
+     * `num_bytes` bytes of the compressed stream before the next read.
+     */
+    [[nodiscard]] auto grow_compressed_input(size_t num_bytes) -> char* {
+        return m_compressed_input.grow(num_bytes);
+    }
+
+    /**
+     * Marks that no more compressed bytes will be appended.
+     */
+    auto mark_end_of_input() -> void { m_is_end_of_input_marked = true; }
+
+    [[nodiscard]] auto is_end_of_input_marked() const -> bool { return m_is_end_of_input_marked; }
+
+    /**
+     * @return A view of all the compressed bytes appended so far.
+     */
+    [[nodiscard]] auto get_compressed_data() const -> std::span<char const> {
+        return m_compressed_input.get_data();
+    }
+
+    /**
+     * @return A view of the decompressed bytes read since the last checkpoint.
+     */
+    [[nodiscard]] auto get_bytes_since_checkpoint() const -> std::span<char const> {
+        return {m_retained_bytes.data(), m_retained_read_idx};
+    }
+
+    /**
+     * Marks the current position as the position to return to on the next call to
+     * `rewind_to_checkpoint`, and releases the decompressed bytes before it.
+     */
+    auto checkpoint() -> void;
+
+    /**
+     * Rewinds to the position marked by the last call to `checkpoint` (or the start of the stream
+     * if `checkpoint` has never been called).
+     */
+    auto rewind_to_checkpoint() -> void { m_retained_read_idx = 0; }
+
+private:
+    // Variables
+    GrowableBufferReader m_compressed_input;
+    ZstdDecompressor m_decompressor;
+    bool m_is_end_of_input_marked{false};
+
+    // Decompressed bytes from `m_checkpoint_pos` onwards.
+    std::vector<char> m_retained_bytes;
+    size_t m_checkpoint_pos{0};
+    size_t m_retained_read_idx{0};
+};
+}  // namespace clp_ffi_js::ir
+
+#endif  // CLP_FFI_JS_IR_CHUNKEDZSTDREADER_HPP
@@ -0,0 +1,64 @@
+#include "DecodedMessageCache.hpp"
+
+#include <cstddef>
+#include <list>
+#include <string>
+#include <utility>
+
+namespace clp_ffi_js::ir {
+auto DecodedMessageCache::find(size_t log_event_idx) -> std::string const* {
+    auto const lookup_it{m_entry_lookup.find(log_event_idx)};
+    if (m_entry_lookup.end() == lookup_it) {
+        ++m_num_misses;
+        return nullptr;
+    }
+    ++m_num_hits;
+    m_entries.splice(m_entries.begin(), m_entries, lookup_it->second);
+    return &lookup_it->second->message;
+}
+
+auto DecodedMessageCache::insert(size_t log_event_idx, std::string message)
+        -> std::string const* {
+    auto const lookup_it{m_entry_lookup.find(log_event_idx)};
+    if (m_entry_lookup.end() != lookup_it) {
+        return &lookup_it->second->message;
+    }
+    auto const entry_size{get_entry_size(message.size())};
+    if (entry_size > m_capacity) {
+        return nullptr;
+    }
+    evict_until_fits(m_capacity - entry_size);
+
+    m_entries.push_front({.log_event_idx = log_event_idx, .message = std::move(message)});
+    m_entry_lookup.emplace(log_event_idx, m_entries.begin());
+    m_num_bytes += entry_size;
+    return &m_entries.front().message;
+}
+
+auto DecodedMessageCache::set_capacity(size_t capacity) -> void {
+    m_capacity = capacity;
+    evict_until_fits(capacity);
+}
+
+auto DecodedMessageCache::clear() -> void {
+    m_entries.clear();
+    m_entry_lookup.clear();
+    m_num_bytes = 0;
+}
+
+auto DecodedMessageCache::get_entry_size(size_t message_size) -> size_t {
+    // A list node holds the entry and two links; a hash map node holds the key, the iterator, a
+    // link, and a cached hash.
+    constexpr size_t cNodeOverhead{sizeof(Entry) + 2 * sizeof(void*) + 4 * sizeof(size_t)};
+    return cNodeOverhead + message_size;
+}
+
+auto DecodedMessageCache::evict_until_fits(size_t max_num_bytes) -> void {
+    while (m_num_bytes > max_num_bytes) {
+        auto const& entry{m_entries.back()};
+        m_num_bytes -= get_entry_size(entry.message.size());
+        m_entry_lookup.erase(entry.log_event_idx);
+        m_entries.pop_back();
+    }
+}
+}  // namespace clp_ffi_js::ir
@@ -0,0 +1,115 @@
+#ifndef CLP_FFI_JS_IR_DECODEDMESSAGECACHE_HPP
+#define CLP_FFI_JS_IR_DECODEDMESSAGECACHE_HPP
+
+#include <cstddef>
+#include <list>
+#include <string>
+#include <unordered_map>
+
+namespace clp_ffi_js::ir {
+/**
+ * A least-recently-used cache of decoded messages, keyed by log event index, whose total size is
+ * bounded by a byte budget.
+ *
+ * A log event's decoded message never changes once the log event has been deserialized, so entries
+ * only need to be invalidated when the way messages are rendered changes (e.g., when a format
+ * template is set), which clears the entire cache.
+ */
+class DecodedMessageCache {
+public:
+    // Constants
+    static constexpr size_t cDefaultCapacity{8ULL * 1024 * 1024};
+
+    // Constructors
+    explicit DecodedMessageCache(size_t capacity = cDefaultCapacity) : m_capacity{capacity} {}
+
+    // Methods
+    /**
+     * Looks up the message of the log event at `log_event_idx`, counting a hit or a miss, and marks
+     * it as the most recently used if it's cached.
+     * @param log_event_idx
+     * @return A pointer to the cached message, which remains valid until the next call to `insert`,
+     * `set_capacity`, or `clear`.
+     * @return nullptr if the message isn't cached.
+     */
+    [[nodiscard]] auto find(size_t log_event_idx) -> std::string const*;
+
+    /**
+     * Caches the message of the log event at `log_event_idx`, evicting the least recently used
+     * messages until the cache fits in its capacity. Messages larger than the capacity aren't
+     * cached.
+     * @param log_event_idx
+     * @param message
+     * @return A pointer to the cached message, which remains valid until the next call to `insert`,
+     * `set_capacity`, or `clear`.
+     * @return nullptr if the message isn't cached.
+     */
+    auto insert(size_t log_event_idx, std::string message) -> std::string const*;
+
+    /**
+     * @param message_size
+     * @return Whether a message of the given size fits in the cache's capacity, so that callers can
+     * avoid copying a message that `insert` would discard.
+     */
+    [[nodiscard]] auto can_cache(size_t message_size) const -> bool {
+        return get_entry_size(message_size) <= m_capacity;
+    }
+
+    /**
+     * Sets the cache's capacity, evicting the least recently used messages until the cache fits in
+     * it. A capacity of 0 disables the cache.
+     * @param capacity
+     */
+    auto set_capacity(size_t capacity) -> void;
+
+    /**
+     * Removes every cached message, keeping the hit and miss counts.
+     */
+    auto clear() -> void;
+
+    [[nodiscard]] auto get_capacity() const -> size_t { return m_capacity; }
+
+    /**
+     * @return The estimated number of bytes used by the cached messages and their bookkeeping.
+     */
+    [[nodiscard]] auto get_num_bytes() const -> size_t { return m_num_bytes; }
+
+    [[nodiscard]] auto get_num_entries() const -> size_t { return m_entries.size(); }
+
+    [[nodiscard]] auto get_num_hits() const -> size_t { return m_num_hits; }
+
+    [[nodiscard]] auto get_num_misses() const -> size_t { return m_num_misses; }
+
+private:
+    // Types
+    struct Entry {
+        size_t log_event_idx;
+        std::string message;
+    };
+
+    // Methods
+    /**
+     * @param message_size
+     * @return The number of bytes an entry for a message of the given size is accounted for,
+     * including the list and hash map nodes that track it.
+     */
+    [[nodiscard]] static auto get_entry_size(size_t message_size) -> size_t;
+
+    /**
+     * Evicts the least recently used entries until the cache's size is at most `max_num_bytes`.
+     * @param max_num_bytes
+     */
+    auto evict_until_fits(size_t max_num_bytes) -> void;
+
+    // Variables
+    size_t m_capacity;
+    size_t m_num_bytes{0};
+    size_t m_num_hits{0};
+    size_t m_num_misses{0};
+    // Entries in order of use, most recently used first.
+    std::list<Entry> m_entries;
+    std::unordered_map<size_t, std::list<Entry>::iterator> m_entry_lookup;
+};
+}  // namespace clp_ffi_js::ir
+
+#endif  // CLP_FFI_JS_IR_DECODEDMESSAGECACHE_HPP
@@ -0,0 +1,121 @@
+#include "DecodedResultsBinary.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <limits>
+#include <span>
+
+#include <clp/ErrorCode.hpp>
+#include <clp/ir/types.hpp>
+#include <emscripten/val.h>
+
+#include <clp_ffi_js/ClpFfiJsException.hpp>
+#include <clp_ffi_js/ir/LogEventFilterColumns.hpp>
+
+namespace clp_ffi_js::ir {
+namespace {
+/**
+ * @tparam T
+ * @param typed_array_name The name of the JavaScript typed array class whose element type matches
+ * `T`.
+ * @param column
+ * @return A new JavaScript typed array containing a copy of `column`.
+ */
+template <typename T>
+[[nodiscard]] auto copy_to_typed_array(char const* typed_array_name, std::span<T const> column)
+        -> emscripten::val;
+
+template <typename T>
+auto copy_to_typed_array(char const* typed_array_name, std::span<T const> column)
+        -> emscripten::val {
+    // Constructing a typed array from another typed array copies its elements, so the result
+    // remains valid after the column is freed.
+    return emscripten::val::global(typed_array_name)
+            .new_(emscripten::typed_memory_view(column.size(), column.data()));
+}
+}  // namespace
+
+DecodedResultsBinary::DecodedResultsBinary() : m_message_offsets{0} {}
+
+auto DecodedResultsBinary::reserve(size_t num_log_events) -> void {
+    m_log_event_nums.reserve(num_log_events);
+    m_log_levels.reserve(num_log_events);
+    m_timestamps.reserve(num_log_events);
+    m_utc_offsets.reserve(num_log_events);
+    m_message_offsets.reserve(num_log_events + 1);
+}
+
+auto DecodedResultsBinary::add_log_event(
+        size_t log_event_num,
+        LogEventFilterColumns::log_level_t log_level,
+        clp::ir::epoch_time_ms_t timestamp,
+        LogEventFilterColumns::utc_offset_t utc_offset
+) -> void {
+    if (m_messages.size() > std::numeric_limits<message_offset_t>::max()) {
+        throw ClpFfiJsException{
+                clp::ErrorCode::ErrorCode_OutOfBounds,
+                __FILENAME__,
+                __LINE__,
+                std::format(
+                        "The decoded messages' total size ({} bytes) exceeds the supported range.",
+                        m_messages.size()
+                )
+        };
+    }
+    m_log_event_nums.push_back(static_cast<log_event_num_t>(log_event_num));
+    m_log_levels.push_back(log_level);
+    m_timestamps.push_back(timestamp);
+    m_utc_offsets.push_back(utc_offset);
+    m_message_offsets.push_back(static_cast<message_offset_t>(m_messages.size()));
+}
+
+auto DecodedResultsBinary::to_js_object() const -> emscripten::val {
+    auto results{emscripten::val::object()};
+    results.set(
+            "logEventNums",
+            copy_to_typed_array("Uint32Array", std::span<log_event_num_t const>{m_log_event_nums})
+    );
+    results.set(
+            "logLevels",
+            copy_to_typed_array(
+                    "Uint8Array",
+                    std::span<LogEventFilterColumns::log_level_t const>{m_log_levels}
+            )
+    );
+    results.set(
+            "timestamps",
+            copy_to_typed_array(
+                    "BigInt64Array",
+                    std::span<clp::ir::epoch_time_ms_t const>{m_timestamps}
+            )
+    );
+    results.set(
+            "utcOffsets",
+            copy_to_typed_array(
+                    "Int16Array",
+                    std::span<LogEventFilterColumns::utc_offset_t const>{m_utc_offsets}
+            )
+    );
+    // NOLINTBEGIN(cppcoreguidelines-pro-type-reinterpret-cast)
+    results.set(
+            "messages",
+            copy_to_typed_array(
+                    "Uint8Array",
+                    std::span<uint8_t const>{
+                            reinterpret_cast<uint8_t const*>(m_messages.data()),
+                            m_messages.size()
+                    }
+            )
+    );
+    // NOLINTEND(cppcoreguidelines-pro-type-reinterpret-cast)
+    results.set(
+            "messageOffsets",
+            copy_to_typed_array(
+                    "Uint32Array",
+                    std::span<message_offset_t const>{m_message_offsets}
+            )
+    );
+    return results;
+}
+}  // namespace clp_ffi_js::ir
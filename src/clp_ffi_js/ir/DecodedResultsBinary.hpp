@@ -0,0 +1,79 @@
+#ifndef CLP_FFI_JS_IR_DECODEDRESULTSBINARY_HPP
+#define CLP_FFI_JS_IR_DECODEDRESULTSBINARY_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <clp/ir/types.hpp>
+#include <emscripten/val.h>
+
+#include <clp_ffi_js/ir/LogEventFilterColumns.hpp>
+
+namespace clp_ffi_js::ir {
+/**
+ * Decoded log events stored as packed columns (one element per log event), with the log events'
+ * messages concatenated into a single UTF-8 buffer, so that a range of decoded log events can be
+ * returned to JavaScript without creating an object and a string per log event.
+ */
+class DecodedResultsBinary {
+public:
+    // Types
+    using log_event_num_t = uint32_t;
+    using message_offset_t = uint32_t;
+
+    // Constructor
+    DecodedResultsBinary();
+
+    // Methods
+    auto reserve(size_t num_log_events) -> void;
+
+    /**
+     * @return The buffer that the message of the log event being decoded should be appended to,
+     * before the log event is added with `add_log_event`.
+     */
+    [[nodiscard]] auto get_message_buffer() -> std::string& { return m_messages; }
+
+    /**
+     * Adds a log event whose message was appended to the message buffer since the last log event
+     * was added.
+     * @param log_event_num
+     * @param log_level
+     * @param timestamp
+     * @param utc_offset
+     * @throw ClpFfiJsException if the messages exceed the range of `message_offset_t`.
+     */
+    auto add_log_event(
+            size_t log_event_num,
+            LogEventFilterColumns::log_level_t log_level,
+            clp::ir::epoch_time_ms_t timestamp,
+            LogEventFilterColumns::utc_offset_t utc_offset
+    ) -> void;
+
+    /**
+     * @return A JavaScript object with the following properties, each a copy of the corresponding
+     * column:
+     * - logEventNums: The log events' numbers (1-indexed) in the stream (as `Uint32Array`).
+     * - logLevels: The log events' log levels (as `Uint8Array`, indexing into `cLogLevelNames`).
+     * - timestamps: The log events' timestamps in milliseconds since the Unix epoch (as
+     *   `BigInt64Array`).
+     * - utcOffsets: The log events' UTC offsets in minutes (as `Int16Array`).
+     * - messages: The log events' UTF-8 encoded messages, concatenated (as `Uint8Array`).
+     * - messageOffsets: The offsets of the log events' messages in `messages`, with an extra
+     *   element for the end of the last message, so the i-th message is in the range
+     *   `[messageOffsets[i], messageOffsets[i + 1])` (as `Uint32Array`).
+     */
+    [[nodiscard]] auto to_js_object() const -> emscripten::val;
+
+private:
+    std::vector<log_event_num_t> m_log_event_nums;
+    std::vector<LogEventFilterColumns::log_level_t> m_log_levels;
+    std::vector<clp::ir::epoch_time_ms_t> m_timestamps;
+    std::vector<LogEventFilterColumns::utc_offset_t> m_utc_offsets;
+    std::string m_messages;
+    std::vector<message_offset_t> m_message_offsets;
+};
+}  // namespace clp_ffi_js::ir
+
+#endif  // CLP_FFI_JS_IR_DECODEDRESULTSBINARY_HPP
@@ -0,0 +1,368 @@
+#include "FormatTemplate.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <format>
+#include <optional>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include <clp/ErrorCode.hpp>
+#include <clp/ffi/KeyValuePairLogEvent.hpp>
+#include <clp/ffi/SchemaTree.hpp>
+#include <clp/ir/types.hpp>
+#include <clp/type_utils.hpp>
+#include <date/date.h>
+#include <spdlog/spdlog.h>
+
+#include <clp_ffi_js/ClpFfiJsException.hpp>
+#include <clp_ffi_js/constants.hpp>
+#include <clp_ffi_js/ir/formatting_methods.hpp>
+#include <clp_ffi_js/ir/LogEventFilterColumns.hpp>
+#include <clp_ffi_js/ir/StructuredLogEventJsonWriter.hpp>
+
+namespace clp_ffi_js::ir {
+namespace {
+constexpr std::string_view cTimestampFieldName{"timestamp"};
+constexpr std::string_view cLevelFieldName{"level"};
+constexpr std::string_view cAutoGeneratedFieldPrefix{"auto-generated."};
+constexpr std::string_view cUserGeneratedFieldPrefix{"user-generated."};
+constexpr char cKeyPathSeparator{'.'};
+
+constexpr size_t cDefaultNumFractionDigits{3};
+constexpr size_t cMaxNumFractionDigits{9};
+constexpr size_t cNanosecondsPerMillisecond{1'000'000};
+
+/**
+ * @param message
+ * @throw ClpFfiJsException with `clp::ErrorCode_BadParam` and the given message.
+ */
+[[noreturn]] auto throw_invalid_pattern(std::string const& message) -> void;
+
+/**
+ * @param key_path A dot-separated key path.
+ * @return The keys in the path.
+ * @throw ClpFfiJsException if the path or any of its keys is empty.
+ */
+[[nodiscard]] auto split_key_path(std::string_view key_path) -> std::vector<std::string>;
+
+/**
+ * @param schema_tree
+ * @param node_id
+ * @param key_path
+ * @return Whether the node's root-to-node path is `key_path`.
+ */
+[[nodiscard]] auto matches_key_path(
+        clp::ffi::SchemaTree const& schema_tree,
+        clp::ffi::SchemaTree::Node::id_t node_id,
+        std::vector<std::string> const& key_path
+) -> bool;
+
+auto throw_invalid_pattern(std::string const& message) -> void {
+    throw ClpFfiJsException{
+            clp::ErrorCode::ErrorCode_BadParam,
+            __FILENAME__,
+            __LINE__,
+            std::format("Invalid format template: {}", message)
+    };
+}
+
+auto split_key_path(std::string_view key_path) -> std::vector<std::string> {
+    if (key_path.empty()) {
+        throw_invalid_pattern("Empty key path.");
+    }
+    std::vector<std::string> keys;
+    for (auto const key : key_path | std::views::split(cKeyPathSeparator)) {
+        if (key.empty()) {
+            throw_invalid_pattern(std::format("Empty key in key path \"{}\".", key_path));
+        }
+        keys.emplace_back(key.begin(), key.end());
+    }
+    return keys;
+}
+
+auto matches_key_path(
+        clp::ffi::SchemaTree const& schema_tree,
+        clp::ffi::SchemaTree::Node::id_t node_id,
+        std::vector<std::string> const& key_path
+) -> bool {
+    auto id{node_id};
+    for (auto const& key : key_path | std::views::reverse) {
+        auto const& node{schema_tree.get_node(id)};
+        if (node.is_root() || node.get_key_name() != key) {
+            return false;
+        }
+        id = node.get_parent_id_unsafe();
+    }
+    return schema_tree.get_node(id).is_root();
+}
+}  // namespace
+
+auto FormatTemplate::compile(std::string_view pattern) -> FormatTemplate {
+    std::vector<Segment> segments;
+    std::string literal;
+    auto flush_literal = [&]() {
+        if (false == literal.empty()) {
+            segments.emplace_back(LiteralSegment{.text = std::move(literal)});
+            literal.clear();
+        }
+    };
+
+    for (size_t pos{0}; pos < pattern.size(); ++pos) {
+        auto const c{pattern[pos]};
+        auto const is_escaped{pos + 1 < pattern.size() && c == pattern[pos + 1]};
+        if ('}' == c) {
+            if (false == is_escaped) {
+                throw_invalid_pattern("Unmatched '}'.");
+            }
+            literal.push_back(c);
+            ++pos;
+            continue;
+        }
+        if ('{' != c) {
+            literal.push_back(c);
+            continue;
+        }
+        if (is_escaped) {
+            literal.push_back(c);
+            ++pos;
+            continue;
+        }
+
+        auto const end_pos{pattern.find('}', pos)};
+        if (std::string_view::npos == end_pos) {
+            throw_invalid_pattern("Unmatched '{'.");
+        }
+        flush_literal();
+        segments.push_back(compile_field(pattern.substr(pos + 1, end_pos - pos - 1)));
+        pos = end_pos;
+    }
+    flush_literal();
+
+    return FormatTemplate{std::move(segments)};
+}
+
+auto FormatTemplate::append_rendered_log_event(
+        clp::ffi::KeyValuePairLogEvent const& log_event,
+        LogLevel log_level,
+        clp::ir::epoch_time_ms_t timestamp,
+        UtcOffset utc_offset,
+        std::string& output
+) -> void {
+    resolve_new_nodes(true, *log_event.get_auto_gen_keys_schema_tree());
+    resolve_new_nodes(false, *log_event.get_user_gen_keys_schema_tree());
+
+    for (auto& segment : m_segments) {
+        if (auto const* literal{std::get_if<LiteralSegment>(&segment)}; nullptr != literal) {
+            output.append(literal->text);
+        } else if (std::holds_alternative<LevelSegment>(segment)) {
+            output.append(cLogLevelNames.at(clp::enum_to_underlying_type(log_level)));
+        } else if (auto* timestamp_segment{std::get_if<TimestampSegment>(&segment)};
+                   nullptr != timestamp_segment)
+        {
+            append_timestamp(*timestamp_segment, timestamp, utc_offset, output);
+        } else {
+            append_field(std::get<FieldSegment>(segment), log_event, output);
+        }
+    }
+}
+
+auto FormatTemplate::compile_field(std::string_view field) -> Segment {
+    if (cTimestampFieldName == field) {
+        return TimestampSegment{};
+    }
+    if (field.starts_with(cTimestampFieldName) && ':' == field[cTimestampFieldName.size()]) {
+        return compile_timestamp_format(field.substr(cTimestampFieldName.size() + 1));
+    }
+    if (cLevelFieldName == field) {
+        return LevelSegment{};
+    }
+    if (field.starts_with(cAutoGeneratedFieldPrefix)) {
+        return FieldSegment{
+                .is_auto_generated = true,
+                .key_path = split_key_path(field.substr(cAutoGeneratedFieldPrefix.size())),
+                .node_ids = {}
+        };
+    }
+    if (field.starts_with(cUserGeneratedFieldPrefix)) {
+        return FieldSegment{
+                .is_auto_generated = false,
+                .key_path = split_key_path(field.substr(cUserGeneratedFieldPrefix.size())),
+                .node_ids = {}
+        };
+    }
+    throw_invalid_pattern(std::format("Unknown field \"{}\".", field));
+}
+
+auto FormatTemplate::compile_timestamp_format(std::string_view format) -> TimestampSegment {
+    TimestampSegment segment;
+    std::string date_format;
+    auto flush_date_format = [&]() {
+        if (false == date_format.empty()) {
+            segment.parts.emplace_back(std::move(date_format));
+            date_format.clear();
+        }
+    };
+
+    for (size_t pos{0}; pos < format.size(); ++pos) {
+        if ('%' != format[pos] || pos + 1 == format.size()) {
+            date_format.push_back(format[pos]);
+            continue;
+        }
+        auto const next{format[pos + 1]};
+        if ('f' == next) {
+            flush_date_format();
+            segment.parts.emplace_back(cDefaultNumFractionDigits);
+            ++pos;
+            continue;
+        }
+        if ('1' <= next && next <= '9' && pos + 2 < format.size() && 'f' == format[pos + 2]) {
+            flush_date_format();
+            segment.parts.emplace_back(static_cast<size_t>(next - '0'));
+            pos += 2;
+            continue;
+        }
+        // Copy other conversion specifications (including `%%`) whole, so that their second
+        // character isn't mistaken for the start of another.
+        date_format.push_back('%');
+        date_format.push_back(next);
+        ++pos;
+    }
+    flush_date_format();
+
+    std::string formatted_epoch;
+    for (auto const& part : segment.parts) {
+        auto const* date_part{std::get_if<std::string>(&part)};
+        if (nullptr != date_part
+            && false
+                       == append_formatted_local_time(
+                               *date_part,
+                               date::local_seconds{},
+                               UtcOffset{0},
+                               formatted_epoch
+                       ))
+        {
+            throw_invalid_pattern(std::format("Invalid timestamp format \"{}\".", format));
+        }
+    }
+    segment.cached_parts.resize(segment.parts.size());
+    return segment;
+}
+
+auto FormatTemplate::resolve_new_nodes(
+        bool is_auto_generated,
+        clp::ffi::SchemaTree const& schema_tree
+) -> void {
+    auto& num_resolved_nodes{
+            is_auto_generated ? m_num_resolved_auto_gen_nodes : m_num_resolved_user_gen_nodes
+    };
+    // Log events decoded from checkpoints may have smaller schema trees than those seen before, but
+    // since their nodes are inserted in the same order, their node IDs are the same.
+    auto const num_nodes{schema_tree.get_size()};
+    for (auto node_idx{num_resolved_nodes}; node_idx < num_nodes; ++node_idx) {
+        auto const node_id{static_cast<clp::ffi::SchemaTree::Node::id_t>(node_idx)};
+        for (auto& segment : m_segments) {
+            auto* field{std::get_if<FieldSegment>(&segment)};
+            if (nullptr != field && is_auto_generated == field->is_auto_generated
+                && matches_key_path(schema_tree, node_id, field->key_path))
+            {
+                field->node_ids.push_back(node_id);
+            }
+        }
+    }
+    num_resolved_nodes = std::max(num_resolved_nodes, num_nodes);
+}
+
+auto FormatTemplate::append_timestamp(
+        TimestampSegment& segment,
+        clp::ir::epoch_time_ms_t timestamp,
+        UtcOffset utc_offset,
+        std::string& output
+) -> void {
+    if (segment.parts.empty()) {
+        append_iso8601_timestamp(timestamp, utc_offset, output);
+        return;
+    }
+
+    date::local_time<std::chrono::milliseconds> const local_time{
+            std::chrono::milliseconds{timestamp} + utc_offset
+    };
+    auto const local_second{date::floor<std::chrono::seconds>(local_time)};
+    if (segment.cached_local_time != local_second || segment.cached_utc_offset != utc_offset) {
+        for (size_t i{0}; i < segment.parts.size(); ++i) {
+            auto& cached_part{segment.cached_parts[i]};
+            cached_part.clear();
+            if (auto const* date_part{std::get_if<std::string>(&segment.parts[i])};
+                nullptr != date_part)
+            {
+                // The format was validated when it was compiled.
+                std::ignore = append_formatted_local_time(
+                        *date_part,
+                        local_second,
+                        utc_offset,
+                        cached_part
+                );
+            }
+        }
+        segment.cached_local_time = local_second;
+        segment.cached_utc_offset = utc_offset;
+    }
+
+    auto const num_nanoseconds{
+            static_cast<size_t>((local_time - local_second).count()) * cNanosecondsPerMillisecond
+    };
+    std::array<char, cMaxNumFractionDigits> fraction_digits{};
+    auto remaining_nanoseconds{num_nanoseconds};
+    for (auto& digit : fraction_digits | std::views::reverse) {
+        constexpr size_t cBase{10};
+        digit = static_cast<char>('0' + remaining_nanoseconds % cBase);
+        remaining_nanoseconds /= cBase;
+    }
+
+    for (size_t i{0}; i < segment.parts.size(); ++i) {
+        if (auto const* num_digits{std::get_if<size_t>(&segment.parts[i])}; nullptr != num_digits) {
+            output.append(fraction_digits.data(), *num_digits);
+        } else {
+            output.append(segment.cached_parts[i]);
+        }
+    }
+}
+
+auto FormatTemplate::append_field(
+        FieldSegment const& segment,
+        clp::ffi::KeyValuePairLogEvent const& log_event,
+        std::string& output
+) -> void {
+    auto const& node_id_value_pairs{
+            segment.is_auto_generated ? log_event.get_auto_gen_node_id_value_pairs()
+                                      : log_event.get_user_gen_node_id_value_pairs()
+    };
+    auto const& schema_tree{
+            segment.is_auto_generated ? *log_event.get_auto_gen_keys_schema_tree()
+                                      : *log_event.get_user_gen_keys_schema_tree()
+    };
+    for (auto const node_id : segment.node_ids) {
+        auto const it{node_id_value_pairs.find(node_id)};
+        if (node_id_value_pairs.end() == it) {
+            continue;
+        }
+        if (false
+            == StructuredLogEventJsonWriter::append_text_value(
+                    schema_tree.get_node(node_id),
+                    it->second,
+                    output
+            ))
+        {
+            SPDLOG_ERROR("Failed to render the value of schema-tree node {}.", node_id);
+        }
+        return;
+    }
+}
+}  // namespace clp_ffi_js::ir
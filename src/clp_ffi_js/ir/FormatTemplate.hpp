@@ -0,0 +1,155 @@
+#ifndef CLP_FFI_JS_IR_FORMATTEMPLATE_HPP
+#define CLP_FFI_JS_IR_FORMATTEMPLATE_HPP
+
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include <clp/ffi/KeyValuePairLogEvent.hpp>
+#include <clp/ffi/SchemaTree.hpp>
+#include <clp/ir/types.hpp>
+#include <date/date.h>
+
+#include <clp_ffi_js/constants.hpp>
+#include <clp_ffi_js/ir/LogEventFilterColumns.hpp>
+
+namespace clp_ffi_js::ir {
+/**
+ * A template for rendering structured log events as lines of text, compiled once from a pattern
+ * such as `{timestamp:%Y-%m-%d %H:%M:%S.%3f} [{level}] {user-generated.msg}`.
+ *
+ * A pattern consists of literal text and fields enclosed in braces (with `{{` and `}}` escaping
+ * literal braces):
+ * - `{timestamp}`: The log event's timestamp in ISO 8601 format, in the log event's UTC offset.
+ * - `{timestamp:<format>}`: The log event's timestamp formatted with a `date::format` pattern, in
+ *   the log event's UTC offset. `%f` formats the milliseconds, and `%<n>f` the first `n` (1-9)
+ *   digits of the fractional seconds.
+ * - `{level}`: The name of the log event's log level.
+ * - `{auto-generated.<key path>}` or `{user-generated.<key path>}`: The value of the auto-generated
+ *   or user-generated kv-pair with the given dot-separated key path. Strings are rendered as is,
+ *   and other values as JSON. Fields that the log event doesn't have render as empty text.
+ *
+ * Key paths are resolved to schema-tree node IDs as the schema trees grow, so rendering a log event
+ * only looks up the resolved IDs in its kv-pairs.
+ */
+class FormatTemplate {
+public:
+    // Factory function
+    /**
+     * @param pattern
+     * @return The compiled template.
+     * @throw ClpFfiJsException with `clp::ErrorCode_BadParam` if the pattern is invalid.
+     */
+    [[nodiscard]] static auto compile(std::string_view pattern) -> FormatTemplate;
+
+    // Methods
+    /**
+     * Appends the line rendered for the given log event.
+     * @param log_event
+     * @param log_level
+     * @param timestamp
+     * @param utc_offset
+     * @param output
+     */
+    auto append_rendered_log_event(
+            clp::ffi::KeyValuePairLogEvent const& log_event,
+            LogLevel log_level,
+            clp::ir::epoch_time_ms_t timestamp,
+            UtcOffset utc_offset,
+            std::string& output
+    ) -> void;
+
+private:
+    // Types
+    struct LiteralSegment {
+        std::string text;
+    };
+
+    struct LevelSegment {};
+
+    struct TimestampSegment {
+        // Each part is either a `date::format` pattern or the number of fractional-second digits
+        // to format. A segment without parts formats the timestamp in ISO 8601 format.
+        std::vector<std::variant<std::string, size_t>> parts;
+        // The `date::format` parts formatted for the last second and UTC offset, since consecutive
+        // log events are often in the same second.
+        std::optional<date::local_seconds> cached_local_time;
+        UtcOffset cached_utc_offset{0};
+        std::vector<std::string> cached_parts;
+    };
+
+    struct FieldSegment {
+        bool is_auto_generated;
+        std::vector<std::string> key_path;
+        // The nodes whose root-to-node path is `key_path` (one per value type).
+        std::vector<clp::ffi::SchemaTree::Node::id_t> node_ids;
+    };
+
+    using Segment = std::variant<LiteralSegment, LevelSegment, TimestampSegment, FieldSegment>;
+
+    // Constructors
+    explicit FormatTemplate(std::vector<Segment> segments) : m_segments{std::move(segments)} {}
+
+    // Methods
+    /**
+     * @param field The text between a field's braces.
+     * @return The compiled field.
+     * @throw ClpFfiJsException with `clp::ErrorCode_BadParam` if the field is invalid.
+     */
+    [[nodiscard]] static auto compile_field(std::string_view field) -> Segment;
+
+    /**
+     * @param format The format of a `{timestamp:<format>}` field.
+     * @return The compiled timestamp segment.
+     * @throw ClpFfiJsException with `clp::ErrorCode_BadParam` if the format is invalid.
+     */
+    [[nodiscard]] static auto compile_timestamp_format(std::string_view format)
+            -> TimestampSegment;
+
+    /**
+     * Resolves the key paths of the field segments against the nodes inserted into a schema tree
+     * since the last call.
+     * @param is_auto_generated Whether `schema_tree` is the auto-generated keys' schema tree.
+     * @param schema_tree
+     */
+    auto resolve_new_nodes(bool is_auto_generated, clp::ffi::SchemaTree const& schema_tree)
+            -> void;
+
+    /**
+     * Appends a timestamp formatted as described by a timestamp segment.
+     * @param segment
+     * @param timestamp
+     * @param utc_offset
+     * @param output
+     */
+    static auto append_timestamp(
+            TimestampSegment& segment,
+            clp::ir::epoch_time_ms_t timestamp,
+            UtcOffset utc_offset,
+            std::string& output
+    ) -> void;
+
+    /**
+     * Appends the value of the log event's kv-pair that a field segment refers to, if any.
+     * @param segment
+     * @param log_event
+     * @param output
+     */
+    static auto append_field(
+            FieldSegment const& segment,
+            clp::ffi::KeyValuePairLogEvent const& log_event,
+            std::string& output
+    ) -> void;
+
+    // Variables
+    std::vector<Segment> m_segments;
+    size_t m_num_resolved_auto_gen_nodes{0};
+    size_t m_num_resolved_user_gen_nodes{0};
+};
+}  // namespace clp_ffi_js::ir
+
+#endif  // CLP_FFI_JS_IR_FORMATTEMPLATE_HPP
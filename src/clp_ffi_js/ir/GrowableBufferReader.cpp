@@ -0,0 +1,43 @@
+#include "GrowableBufferReader.hpp"
+
+#include <algorithm>
+#include <cstddef>
+
+#include <clp/ErrorCode.hpp>
+
+namespace clp_ffi_js::ir {
+auto GrowableBufferReader::try_read(char* buf, size_t num_bytes_to_read, size_t& num_bytes_read)
+        -> clp::ErrorCode {
+    if (nullptr == buf && num_bytes_to_read > 0) {
+        return clp::ErrorCode_BadParam;
+    }
+
+    num_bytes_read = std::min(num_bytes_to_read, m_buffer.size() - m_pos);
+    if (0 == num_bytes_read && num_bytes_to_read > 0) {
+        return clp::ErrorCode_EndOfFile;
+    }
+
+    std::copy_n(m_buffer.cbegin() + static_cast<std::ptrdiff_t>(m_pos), num_bytes_read, buf);
+    m_pos += num_bytes_read;
+    return clp::ErrorCode_Success;
+}
+
+auto GrowableBufferReader::try_seek_from_begin(size_t pos) -> clp::ErrorCode {
+    if (pos > m_buffer.size()) {
+        return clp::ErrorCode_Truncated;
+    }
+    m_pos = pos;
+    return clp::ErrorCode_Success;
+}
+
+auto GrowableBufferReader::try_get_pos(size_t& pos) -> clp::ErrorCode {
+    pos = m_pos;
+    return clp::ErrorCode_Success;
+}
+
+auto GrowableBufferReader::grow(size_t num_bytes) -> char* {
+    auto const old_size{m_buffer.size()};
+    m_buffer.resize(old_size + num_bytes);
+    return m_buffer.data() + old_size;
+}
+}  // namespace clp_ffi_js::ir
@@ -0,0 +1,88 @@
+#ifndef CLP_FFI_JS_IR_GROWABLEBUFFERREADER_HPP
+#define CLP_FFI_JS_IR_GROWABLEBUFFERREADER_HPP
+
+#include <cstddef>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include <clp/ErrorCode.hpp>
+#include <clp/ReaderInterface.hpp>
+
+namespace clp_ffi_js::ir {
+/**
+ * A `clp::ReaderInterface` over an in-memory buffer that can keep growing after reads have started.
+ *
+ * Reading past the currently buffered data returns `clp::ErrorCode_EndOfFile` regardless of whether
+ * more data will be appended later, so that consumers (e.g., `ZstdDecompressor`) return whatever
+ * they could produce and can be called again once more data has been appended.
+ */
+class GrowableBufferReader : public clp::ReaderInterface {
+public:
+    // Constructors
+    GrowableBufferReader() = default;
+
+    /**
+     * @param buffer The initially buffered data.
+     */
+    explicit GrowableBufferReader(std::vector<char> buffer) : m_buffer{std::move(buffer)} {}
+
+    // Disable copy constructor and assignment operator
+    GrowableBufferReader(GrowableBufferReader const&) = delete;
+    auto operator=(GrowableBufferReader const&) -> GrowableBufferReader& = delete;
+
+    // Default move constructor and assignment operator
+    GrowableBufferReader(GrowableBufferReader&&) = default;
+    auto operator=(GrowableBufferReader&&) -> GrowableBufferReader& = default;
+
+    // Destructor
+    ~GrowableBufferReader() override = default;
+
+    // Methods implementing `clp::ReaderInterface`
+    /**
+     * @param buf
+     * @param num_bytes_to_read
+     * @param num_bytes_read Returns the number of bytes read.
+     * @return clp::ErrorCode_EndOfFile if there's no more buffered data.
+     * @return clp::ErrorCode_Success on success.
+     */
+    [[nodiscard]] auto try_read(char* buf, size_t num_bytes_to_read, size_t& num_bytes_read)
+            -> clp::ErrorCode override;
+
+    /**
+     * @param pos
+     * @return clp::ErrorCode_Truncated if `pos` is past the end of the buffered data.
+     * @return clp::ErrorCode_Success on success.
+     */
+    [[nodiscard]] auto try_seek_from_begin(size_t pos) -> clp::ErrorCode override;
+
+    /**
+     * @param pos Returns the current position.
+     * @return clp::ErrorCode_Success
+     */
+    [[nodiscard]] auto try_get_pos(size_t& pos) -> clp::ErrorCode override;
+
+    // Methods
+    /**
+     * Grows the buffer by `num_bytes`.
+     *
+     * NOTE: The returned pointer is only valid until the next call to this method.
+     *
+     * @param num_bytes
+     * @return A pointer to the newly added (uninitialized) region, which the caller must fill
+     * before the next read.
+     */
+    [[nodiscard]] auto grow(size_t num_bytes) -> char*;
+
+    /**
+     * @return A view of all the data buffered so far.
+     */
+    [[nodiscard]] auto get_data() const -> std::span<char const> { return m_buffer; }
+
+private:
+    std::vector<char> m_buffer;
+    size_t m_pos{0};
+};
+}  // namespace clp_ffi_js::ir
+
+#endif  // CLP_FFI_JS_IR_GROWABLEBUFFERREADER_HPP
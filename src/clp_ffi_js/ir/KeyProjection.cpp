@@ -0,0 +1,54 @@
+#include "KeyProjection.hpp"
+
+#include <algorithm>
+#include <ranges>
+
+#include <clp/ffi/SchemaTree.hpp>
+
+namespace clp_ffi_js::ir {
+auto KeyProjection::handle_node_insertion(
+        bool is_auto_generated,
+        clp::ffi::SchemaTree const& schema_tree,
+        clp::ffi::SchemaTree::Node::id_t node_id
+) -> void {
+    auto& is_node_projected{
+            is_auto_generated ? m_is_auto_gen_node_projected : m_is_user_gen_node_projected
+    };
+    if (is_node_projected.size() <= node_id) {
+        is_node_projected.resize(node_id + 1, false);
+    }
+
+    auto const& node{schema_tree.get_node(node_id)};
+    if (node.is_root()) {
+        return;
+    }
+    auto const parent_id{node.get_parent_id_unsafe()};
+    is_node_projected[node_id]
+            = (parent_id < is_node_projected.size() && is_node_projected[parent_id])
+              || matches_any_key_path(is_auto_generated, schema_tree, node_id);
+}
+
+auto KeyProjection::matches_any_key_path(
+        bool is_auto_generated,
+        clp::ffi::SchemaTree const& schema_tree,
+        clp::ffi::SchemaTree::Node::id_t node_id
+) const -> bool {
+    return std::ranges::any_of(m_key_paths, [&](KeyPath const& key_path) {
+        if (key_path.is_auto_generated != is_auto_generated
+            || key_path.root_to_leaf_path.empty())
+        {
+            return false;
+        }
+
+        auto id{node_id};
+        for (auto const& key : key_path.root_to_leaf_path | std::views::reverse) {
+            auto const& node{schema_tree.get_node(id)};
+            if (node.is_root() || node.get_key_name() != key) {
+                return false;
+            }
+            id = node.get_parent_id_unsafe();
+        }
+        return schema_tree.get_node(id).is_root();
+    });
+}
+}  // namespace clp_ffi_js::ir
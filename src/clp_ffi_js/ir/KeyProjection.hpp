@@ -0,0 +1,74 @@
+#ifndef CLP_FFI_JS_IR_KEYPROJECTION_HPP
+#define CLP_FFI_JS_IR_KEYPROJECTION_HPP
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <clp/ffi/SchemaTree.hpp>
+
+namespace clp_ffi_js::ir {
+/**
+ * Class that resolves a set of key paths to the schema-tree nodes they project, as the nodes are
+ * inserted into a structured IR stream's schema trees.
+ *
+ * A node is projected if its root-to-node path is one of the key paths (regardless of the node's
+ * type), or if its parent is projected, so projecting an object projects all of its descendants.
+ */
+class KeyProjection {
+public:
+    // Types
+    struct KeyPath {
+        bool is_auto_generated;
+        std::vector<std::string> root_to_leaf_path;
+    };
+
+    // Constructor
+    explicit KeyProjection(std::vector<KeyPath> key_paths) : m_key_paths{std::move(key_paths)} {}
+
+    // Methods
+    /**
+     * Resolves whether the newly inserted node is projected.
+     * @param is_auto_generated Whether the node was inserted into the auto-generated keys' schema
+     * tree.
+     * @param schema_tree The schema tree after the insertion.
+     * @param node_id
+     */
+    auto handle_node_insertion(
+            bool is_auto_generated,
+            clp::ffi::SchemaTree const& schema_tree,
+            clp::ffi::SchemaTree::Node::id_t node_id
+    ) -> void;
+
+    /**
+     * @param is_auto_generated
+     * @return A bitmap, indexed by node ID, of the nodes in the auto-generated or user-generated
+     * keys' schema tree that are projected. Nodes beyond the end of the bitmap aren't projected.
+     */
+    [[nodiscard]] auto get_projected_nodes(bool is_auto_generated) const
+            -> std::vector<bool> const& {
+        return is_auto_generated ? m_is_auto_gen_node_projected : m_is_user_gen_node_projected;
+    }
+
+private:
+    // Methods
+    /**
+     * @param is_auto_generated
+     * @param schema_tree
+     * @param node_id
+     * @return Whether the node's root-to-node path matches any of the key paths.
+     */
+    [[nodiscard]] auto matches_any_key_path(
+            bool is_auto_generated,
+            clp::ffi::SchemaTree const& schema_tree,
+            clp::ffi::SchemaTree::Node::id_t node_id
+    ) const -> bool;
+
+    // Variables
+    std::vector<KeyPath> m_key_paths;
+    std::vector<bool> m_is_auto_gen_node_projected;
+    std::vector<bool> m_is_user_gen_node_projected;
+};
+}  // namespace clp_ffi_js::ir
+
+#endif  // CLP_FFI_JS_IR_KEYPROJECTION_HPP
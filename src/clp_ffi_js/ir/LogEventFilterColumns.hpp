@@ -0,0 +1,278 @@
+#ifndef CLP_FFI_JS_IR_LOGEVENTFILTERCOLUMNS_HPP
+#define CLP_FFI_JS_IR_LOGEVENTFILTERCOLUMNS_HPP
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <iterator>
+#include <limits>
+#include <numeric>
+#include <optional>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include <clp/ErrorCode.hpp>
+#include <clp/ir/types.hpp>
+#include <clp/type_utils.hpp>
+
+#include <clp_ffi_js/ClpFfiJsException.hpp>
+#include <clp_ffi_js/constants.hpp>
+
+namespace clp_ffi_js::ir {
+using UtcOffset = std::chrono::minutes;
+
+/**
+ * The fields of log events that are used for filtering in the `StreamReader` classes and their
+ * callers, in their processed forms, stored as parallel columns (one element per log event) so that
+ * filtering and searching only touch the memory of the fields involved.
+ *
+ * The class also maintains a posting list per log level (the sorted indices of the log events with
+ * that level), so that filtering by log level and counting the log events with each level take time
+ * proportional to the number of matching log events rather than the total number of log events.
+ * The posting lists store 32-bit indices to halve their size in Memory64 builds; the JS API can't
+ * address more log events anyway, since log event numbers are returned in `Uint32Array`s.
+ *
+ * The class also tracks whether the log events are in chronological order. If they aren't (e.g.,
+ * in streams merged from several threads' logs), it lazily builds a permutation of the log events'
+ * indices in chronological order, so that searching by timestamp remains logarithmic.
+ */
+class LogEventFilterColumns {
+public:
+    // Types
+    using log_level_t = std::underlying_type_t<LogLevel>;
+    using utc_offset_t = int16_t;
+    using log_event_idx_t = uint32_t;
+    // Whether each log level, indexed by its underlying value, is selected.
+    using LogLevelSelection = std::array<bool, clp::enum_to_underlying_type(LogLevel::LENGTH)>;
+
+    // Methods
+    /**
+     * Appends a log event's filter data.
+     *
+     * NOTE: `utc_offset` is clamped to the range of `utc_offset_t`, which is much wider than the
+     * range of valid UTC offsets.
+     *
+     * @param log_level
+     * @param timestamp
+     * @param utc_offset
+     * @throw ClpFfiJsException if the log event's index exceeds the range of `log_event_idx_t`.
+     */
+    auto push_back(LogLevel log_level, clp::ir::epoch_time_ms_t timestamp, UtcOffset utc_offset)
+            -> void {
+        if (m_log_levels.size() > std::numeric_limits<log_event_idx_t>::max()) {
+            throw ClpFfiJsException{
+                    clp::ErrorCode::ErrorCode_OutOfBounds,
+                    __FILENAME__,
+                    __LINE__,
+                    std::format(
+                            "The number of log events exceeds the supported maximum ({}).",
+                            std::numeric_limits<log_event_idx_t>::max()
+                    )
+            };
+        }
+        if (false == m_timestamps.empty() && timestamp < m_timestamps.back()) {
+            m_is_chronological = false;
+        }
+        m_log_event_indices_by_level.at(clp::enum_to_underlying_type(log_level))
+                .push_back(static_cast<log_event_idx_t>(m_log_levels.size()));
+        m_log_levels.push_back(clp::enum_to_underlying_type(log_level));
+        m_timestamps.push_back(timestamp);
+        m_utc_offsets.push_back(static_cast<utc_offset_t>(std::clamp<UtcOffset::rep>(
+                utc_offset.count(),
+                std::numeric_limits<utc_offset_t>::min(),
+                std::numeric_limits<utc_offset_t>::max()
+        )));
+    }
+
+    auto reserve(size_t num_log_events) -> void {
+        m_log_levels.reserve(num_log_events);
+        m_timestamps.reserve(num_log_events);
+        m_utc_offsets.reserve(num_log_events);
+    }
+
+    auto clear() -> void {
+        m_log_levels.clear();
+        m_timestamps.clear();
+        m_utc_offsets.clear();
+        for (auto& log_event_indices : m_log_event_indices_by_level) {
+            log_event_indices.clear();
+        }
+        m_is_chronological = true;
+        m_chronological_order.clear();
+    }
+
+    [[nodiscard]] auto size() const -> size_t { return m_timestamps.size(); }
+
+    [[nodiscard]] auto empty() const -> bool { return m_timestamps.empty(); }
+
+    [[nodiscard]] auto get_log_level(size_t log_event_idx) const -> LogLevel {
+        return static_cast<LogLevel>(m_log_levels[log_event_idx]);
+    }
+
+    [[nodiscard]] auto get_timestamp(size_t log_event_idx) const -> clp::ir::epoch_time_ms_t {
+        return m_timestamps[log_event_idx];
+    }
+
+    [[nodiscard]] auto get_utc_offset(size_t log_event_idx) const -> UtcOffset {
+        return UtcOffset{m_utc_offsets[log_event_idx]};
+    }
+
+    [[nodiscard]] auto get_log_levels() const -> std::span<log_level_t const> {
+        return m_log_levels;
+    }
+
+    [[nodiscard]] auto get_timestamps() const -> std::span<clp::ir::epoch_time_ms_t const> {
+        return m_timestamps;
+    }
+
+    [[nodiscard]] auto get_utc_offsets() const -> std::span<utc_offset_t const> {
+        return m_utc_offsets;
+    }
+
+    /**
+     * @return Whether the log events' timestamps are non-decreasing.
+     */
+    [[nodiscard]] auto is_chronological() const -> bool { return m_is_chronological; }
+
+    /**
+     * Finds the log event, L, where if we order the log events chronologically (log events with
+     * equal timestamps being ordered by index) and insert a marker log event, M, with timestamp
+     * `target_ts` after any log events with the same timestamp, L is the log event just before M,
+     * if M isn't first; otherwise L is the log event just after M.
+     *
+     * If the log events aren't in chronological order, the first call (and the first call after
+     * more log events are appended) sorts the log events that aren't yet in the chronological
+     * permutation and merges them into it.
+     *
+     * @param target_ts
+     * @return The index of L, or std::nullopt if there are no log events.
+     */
+    [[nodiscard]] auto find_nearest_log_event_by_timestamp(clp::ir::epoch_time_ms_t target_ts
+    ) const -> std::optional<size_t> {
+        if (m_timestamps.empty()) {
+            return std::nullopt;
+        }
+
+        if (m_is_chronological) {
+            auto const first_greater_it{std::ranges::upper_bound(m_timestamps, target_ts)};
+            if (first_greater_it == m_timestamps.cbegin()) {
+                return 0;
+            }
+            return static_cast<size_t>(std::distance(m_timestamps.cbegin(), first_greater_it) - 1);
+        }
+
+        update_chronological_order();
+        auto const first_greater_it{std::ranges::upper_bound(
+                m_chronological_order,
+                target_ts,
+                {},
+                [this](size_t log_event_idx) { return m_timestamps[log_event_idx]; }
+        )};
+        if (first_greater_it == m_chronological_order.cbegin()) {
+            return m_chronological_order.front();
+        }
+        return *std::prev(first_greater_it);
+    }
+
+    /**
+     * @param log_level
+     * @return The sorted indices of the log events with the given log level.
+     */
+    [[nodiscard]] auto get_log_event_indices(LogLevel log_level) const
+            -> std::span<log_event_idx_t const> {
+        return m_log_event_indices_by_level.at(clp::enum_to_underlying_type(log_level));
+    }
+
+    /**
+     * Collects the indices of the log events with any of the selected log levels by merging the
+     * selected levels' posting lists.
+     * @param selection
+     * @return The sorted indices of the log events with any of the selected log levels.
+     */
+    [[nodiscard]] auto get_log_event_indices(LogLevelSelection const& selection) const
+            -> std::vector<size_t> {
+        std::vector<std::span<log_event_idx_t const>> posting_lists;
+        size_t num_matches{0};
+        for (size_t log_level{0}; log_level < selection.size(); ++log_level) {
+            auto const& log_event_indices{m_log_event_indices_by_level.at(log_level)};
+            if (selection.at(log_level) && false == log_event_indices.empty()) {
+                posting_lists.emplace_back(log_event_indices);
+                num_matches += log_event_indices.size();
+            }
+        }
+
+        std::vector<size_t> merged_log_event_indices;
+        merged_log_event_indices.reserve(num_matches);
+        // Every log event is in exactly one posting list, and there are only a handful of lists,
+        // so a linear scan for the smallest head is cheaper than maintaining a heap.
+        while (posting_lists.size() > 1) {
+            auto const min_it{std::ranges::min_element(
+                    posting_lists,
+                    {},
+                    [](std::span<log_event_idx_t const> const& list) { return list.front(); }
+            )};
+            merged_log_event_indices.push_back(min_it->front());
+            *min_it = min_it->subspan(1);
+            if (min_it->empty()) {
+                posting_lists.erase(min_it);
+            }
+        }
+        if (false == posting_lists.empty()) {
+            merged_log_event_indices.insert(
+                    merged_log_event_indices.end(),
+                    posting_lists.front().begin(),
+                    posting_lists.front().end()
+            );
+        }
+        return merged_log_event_indices;
+    }
+
+private:
+    // Methods
+    /**
+     * Extends `m_chronological_order` with the log events that were appended since it was last
+     * updated.
+     */
+    auto update_chronological_order() const -> void {
+        auto const num_ordered{m_chronological_order.size()};
+        if (num_ordered == m_timestamps.size()) {
+            return;
+        }
+
+        m_chronological_order.resize(m_timestamps.size());
+        auto const appended_begin{
+                m_chronological_order.begin() + static_cast<std::ptrdiff_t>(num_ordered)
+        };
+        std::iota(appended_begin, m_chronological_order.end(), num_ordered);
+        // Both sorts are stable and the appended log events follow the ordered ones, so log events
+        // with equal timestamps stay ordered by index.
+        auto const is_earlier = [this](size_t lhs_idx, size_t rhs_idx) {
+            return m_timestamps[lhs_idx] < m_timestamps[rhs_idx];
+        };
+        std::stable_sort(appended_begin, m_chronological_order.end(), is_earlier);
+        std::inplace_merge(
+                m_chronological_order.begin(),
+                appended_begin,
+                m_chronological_order.end(),
+                is_earlier
+        );
+    }
+
+    // Variables
+    std::vector<log_level_t> m_log_levels;
+    std::vector<clp::ir::epoch_time_ms_t> m_timestamps;
+    std::vector<utc_offset_t> m_utc_offsets;
+    std::array<std::vector<log_event_idx_t>, clp::enum_to_underlying_type(LogLevel::LENGTH)>
+            m_log_event_indices_by_level;
+    bool m_is_chronological{true};
+    // The indices of the log events in chronological order, which is only built if the log events
+    // aren't in chronological order. It's a cache that's extended on demand by const methods.
+    mutable std::vector<size_t> m_chronological_order;
+};
+}  // namespace clp_ffi_js::ir
+
+#endif  // CLP_FFI_JS_IR_LOGEVENTFILTERCOLUMNS_HPP
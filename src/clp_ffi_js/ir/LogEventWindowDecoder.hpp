@@ -0,0 +1,163 @@
+#ifndef CLP_FFI_JS_IR_LOGEVENTWINDOWDECODER_HPP
+#define CLP_FFI_JS_IR_LOGEVENTWINDOWDECODER_HPP
+
+#include <cstddef>
+#include <format>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <span>
+#include <tuple>
+#include <utility>
+
+#include <clp/ErrorCode.hpp>
+#include <clp/ReaderInterface.hpp>
+#include <clp/streaming_compression/zstd/Decompressor.hpp>
+
+#include <clp_ffi_js/ClpFfiJsException.hpp>
+#include <clp_ffi_js/ir/CheckpointIndex.hpp>
+#include <clp_ffi_js/ir/SplicedReader.hpp>
+
+namespace clp_ffi_js::ir {
+/**
+ * Class that decodes log events on demand for stream readers in windowed mode, which don't buffer
+ * deserialized log events.
+ *
+ * Decoding a log event resumes deserialization from the nearest checkpoint before it, unless
+ * continuing from the previously decoded log event is closer. So decoding log events in ascending
+ * order of index deserializes the stream between consecutive checkpoints at most once.
+ *
+ * @tparam Deserializer
+ * @tparam LogEvent
+ */
+template <typename Deserializer, typename LogEvent>
+class LogEventWindowDecoder {
+public:
+    // Types
+    using ZstdDecompressor = clp::streaming_compression::zstd::Decompressor;
+
+    /**
+     * Function that creates a deserializer from a reader positioned at the start of an IR stream.
+     */
+    using CreateDeserializerFunc = std::function<Deserializer(clp::ReaderInterface&)>;
+
+    /**
+     * Function that deserializes IR units until it has deserialized the next log event.
+     */
+    using DeserializeLogEventFunc = std::function<LogEvent(Deserializer&, clp::ReaderInterface&)>;
+
+    // Constructor
+    LogEventWindowDecoder(
+            CheckpointIndex checkpoint_index,
+            CreateDeserializerFunc create_deserializer,
+            DeserializeLogEventFunc deserialize_log_event
+    )
+            : m_checkpoint_index{std::move(checkpoint_index)},
+              m_create_deserializer{std::move(create_deserializer)},
+              m_deserialize_log_event{std::move(deserialize_log_event)} {}
+
+    // Methods
+    [[nodiscard]] auto get_checkpoint_index() -> CheckpointIndex& { return m_checkpoint_index; }
+
+    [[nodiscard]] auto get_checkpoint_index() const -> CheckpointIndex const& {
+        return m_checkpoint_index;
+    }
+
+    /**
+     * @param compressed_data The compressed IR stream.
+     * @param log_event_idx
+     * @return The log event at `log_event_idx`.
+     * @throw ClpFfiJsException if the stream couldn't be decompressed or deserialized.
+     * @throw Propagates `CreateDeserializerFunc`'s and `DeserializeLogEventFunc`'s exceptions.
+     */
+    [[nodiscard]] auto decode(std::span<char const> compressed_data, size_t log_event_idx)
+            -> LogEvent {
+        auto const& checkpoint{m_checkpoint_index.find_checkpoint(log_event_idx)};
+        bool const can_continue{
+                m_deserializer.has_value() && m_next_log_event_idx <= log_event_idx
+                && checkpoint.log_event_idx <= m_next_log_event_idx
+                && compressed_data.data() == m_compressed_data.data()
+                && compressed_data.size() == m_compressed_data.size()
+        };
+        if (false == can_continue) {
+            resume_from(compressed_data, checkpoint);
+        }
+
+        try {
+            for (; m_next_log_event_idx < log_event_idx; ++m_next_log_event_idx) {
+                std::ignore = m_deserialize_log_event(*m_deserializer, *m_spliced_reader);
+            }
+            ++m_next_log_event_idx;
+            return m_deserialize_log_event(*m_deserializer, *m_spliced_reader);
+        } catch (...) {
+            // Resume from a checkpoint on the next call.
+            m_deserializer.reset();
+            throw;
+        }
+    }
+
+private:
+    // Methods
+    /**
+     * Resets the deserializer so that the next log event it deserializes is the first one after
+     * `checkpoint`.
+     * @param compressed_data
+     * @param checkpoint
+     * @throw ClpFfiJsException if the decompressor couldn't seek to the checkpoint.
+     */
+    auto resume_from(
+            std::span<char const> compressed_data,
+            CheckpointIndex::Checkpoint const& checkpoint
+    ) -> void {
+        m_deserializer.reset();
+        m_spliced_reader.reset();
+
+        // The compressed data may have been reallocated or extended (in streaming mode) since the
+        // decompressor was opened.
+        if (nullptr == m_zstd_decompressor || compressed_data.data() != m_compressed_data.data()
+            || compressed_data.size() != m_compressed_data.size())
+        {
+            m_zstd_decompressor = std::make_unique<ZstdDecompressor>();
+            m_zstd_decompressor->open(compressed_data.data(), compressed_data.size());
+            m_compressed_data = compressed_data;
+        }
+
+        // Seeking forwards only decompresses the bytes in between, whereas seeking backwards
+        // restarts decompression from the start of the stream.
+        if (auto const err{m_zstd_decompressor->try_seek_from_begin(checkpoint.decompressed_pos)};
+            clp::ErrorCode_Success != err)
+        {
+            m_zstd_decompressor.reset();
+            throw ClpFfiJsException{
+                    err,
+                    __FILENAME__,
+                    __LINE__,
+                    std::format(
+                            "Failed to seek to the checkpoint at decompressed position {}.",
+                            checkpoint.decompressed_pos
+                    )
+            };
+        }
+
+        m_spliced_reader = std::make_unique<SplicedReader>(
+                m_checkpoint_index.get_replay_prefix(checkpoint),
+                *m_zstd_decompressor
+        );
+        m_deserializer.emplace(m_create_deserializer(*m_spliced_reader));
+        m_next_log_event_idx = checkpoint.log_event_idx;
+    }
+
+    // Variables
+    CheckpointIndex m_checkpoint_index;
+    CreateDeserializerFunc m_create_deserializer;
+    DeserializeLogEventFunc m_deserialize_log_event;
+
+    std::span<char const> m_compressed_data;
+    std::unique_ptr<ZstdDecompressor> m_zstd_decompressor;
+    std::unique_ptr<SplicedReader> m_spliced_reader;
+    std::optional<Deserializer> m_deserializer;
+    size_t m_next_log_event_idx{0};
+};
+}  // namespace clp_ffi_js::ir
+
+#endif  // CLP_FFI_JS_IR_LOGEVENTWINDOWDECODER_HPP
@@ -1,69 +0,0 @@
-#ifndef CLP_FFI_JS_IR_LOGEVENTWITHFILTERDATA_HPP
-#define CLP_FFI_JS_IR_LOGEVENTWITHFILTERDATA_HPP
-
-#include <concepts>
-#include <utility>
-
-#include <clp/ffi/KeyValuePairLogEvent.hpp>
-#include <clp/ir/LogEvent.hpp>
-#include <clp/ir/types.hpp>
-
-#include <clp_ffi_js/constants.hpp>
-
-namespace clp_ffi_js::ir {
-using clp::ir::four_byte_encoded_variable_t;
-using UnstructuredLogEvent = clp::ir::LogEvent<four_byte_encoded_variable_t>;
-using StructuredLogEvent = clp::ffi::KeyValuePairLogEvent;
-using UtcOffset = std::chrono::minutes;
-
-/**
- * A templated class that extends a log event type with processed versions of some of its fields,
- * specifically the fields that are used for filtering in the `StreamReader` classes and their
- * callers.
- *
- * @tparam LogEvent The type of the log event.
- */
-template <typename LogEvent>
-requires std::same_as<LogEvent, UnstructuredLogEvent> || std::same_as<LogEvent, StructuredLogEvent>
-class LogEventWithFilterData {
-public:
-    // Constructor
-    LogEventWithFilterData(
-            LogEvent log_event,
-            LogLevel log_level,
-            clp::ir::epoch_time_ms_t timestamp,
-            UtcOffset utc_offset
-    )
-            : m_log_event{std::move(log_event)},
-              m_log_level{log_level},
-              m_timestamp{timestamp},
-              m_utc_offset{utc_offset} {}
-
-    // Disable copy constructor and assignment operator
-    LogEventWithFilterData(LogEventWithFilterData const&) = delete;
-    auto operator=(LogEventWithFilterData const&) -> LogEventWithFilterData& = delete;
-
-    // Default move constructor and assignment operator
-    LogEventWithFilterData(LogEventWithFilterData&&) = default;
-    auto operator=(LogEventWithFilterData&&) -> LogEventWithFilterData& = default;
-
-    // Destructor
-    ~LogEventWithFilterData() = default;
-
-    [[nodiscard]] auto get_log_event() const -> LogEvent const& { return m_log_event; }
-
-    [[nodiscard]] auto get_log_level() const -> LogLevel { return m_log_level; }
-
-    [[nodiscard]] auto get_timestamp() const -> clp::ir::epoch_time_ms_t { return m_timestamp; }
-
-    [[nodiscard]] auto get_utc_offset() const -> UtcOffset { return m_utc_offset; }
-
-private:
-    LogEvent m_log_event;
-    LogLevel m_log_level;
-    clp::ir::epoch_time_ms_t m_timestamp;
-    UtcOffset m_utc_offset;
-};
-}  // namespace clp_ffi_js::ir
-
-#endif  // CLP_FFI_JS_IR_LOGEVENTWITHFILTERDATA_HPP
@@ -0,0 +1,162 @@
+#ifndef CLP_FFI_JS_IR_LOGEVENTS_HPP
+#define CLP_FFI_JS_IR_LOGEVENTS_HPP
+
+#include <concepts>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include <clp/ffi/KeyValuePairLogEvent.hpp>
+#include <clp/ir/LogEvent.hpp>
+#include <clp/ir/types.hpp>
+#include <clp/type_utils.hpp>
+
+#include <clp_ffi_js/constants.hpp>
+#include <clp_ffi_js/ir/LogEventFilterColumns.hpp>
+#include <clp_ffi_js/ir/LogtypeDictionary.hpp>
+#include <clp_ffi_js/ir/Snapshot.hpp>
+
+namespace clp_ffi_js::ir {
+using clp::ir::four_byte_encoded_variable_t;
+using UnstructuredLogEvent = clp::ir::LogEvent<four_byte_encoded_variable_t>;
+using StructuredLogEvent = clp::ffi::KeyValuePairLogEvent;
+
+/**
+ * A templated collection of log events that stores the processed versions of the fields used for
+ * filtering (see `LogEventFilterColumns`) separately from the log events themselves.
+ *
+ * The collection can also be created to only store the filter data, for readers that decode log
+ * events on demand.
+ *
+ * @tparam LogEvent The type of the log events.
+ */
+template <typename LogEvent>
+requires std::same_as<LogEvent, InternedUnstructuredLogEvent>
+         || std::same_as<LogEvent, StructuredLogEvent>
+class LogEvents {
+public:
+    // Constructor
+    /**
+     * @param is_storing_log_events Whether to store the log events, or only their filter data.
+     */
+    explicit LogEvents(bool is_storing_log_events = true)
+            : m_is_storing_log_events{is_storing_log_events} {}
+
+    // Disable copy constructor and assignment operator
+    LogEvents(LogEvents const&) = delete;
+    auto operator=(LogEvents const&) -> LogEvents& = delete;
+
+    // Default move constructor and assignment operator
+    LogEvents(LogEvents&&) = default;
+    auto operator=(LogEvents&&) -> LogEvents& = default;
+
+    // Destructor
+    ~LogEvents() = default;
+
+    // Methods
+    /**
+     * Appends a log event along with its filter data.
+     * @param log_event
+     * @param log_level
+     * @param timestamp
+     * @param utc_offset
+     */
+    auto emplace_back(
+            LogEvent log_event,
+            LogLevel log_level,
+            clp::ir::epoch_time_ms_t timestamp,
+            UtcOffset utc_offset
+    ) -> void {
+        m_filter_columns.push_back(log_level, timestamp, utc_offset);
+        if (m_is_storing_log_events) {
+            m_log_events.emplace_back(std::move(log_event));
+        }
+    }
+
+    auto reserve(size_t num_log_events) -> void {
+        m_filter_columns.reserve(num_log_events);
+        if (m_is_storing_log_events) {
+            m_log_events.reserve(num_log_events);
+        }
+    }
+
+    auto clear() -> void {
+        m_filter_columns.clear();
+        m_log_events.clear();
+    }
+
+    /**
+     * Reads the filter data written by `write_filter_data_snapshot`, appending it to the
+     * collection.
+     *
+     * NOTE: Only valid if the collection isn't storing log events.
+     * @param reader
+     * @throw ClpFfiJsException if the snapshot is truncated or its filter data is invalid.
+     */
+    auto read_filter_data_snapshot(SnapshotReader& reader) -> void {
+        auto const log_levels{reader.read_array<LogEventFilterColumns::log_level_t>()};
+        auto const timestamps{reader.read_array<clp::ir::epoch_time_ms_t>()};
+        auto const utc_offsets{reader.read_array<LogEventFilterColumns::utc_offset_t>()};
+        if (log_levels.size() != timestamps.size() || log_levels.size() != utc_offsets.size()) {
+            throw_corrupt_snapshot("The snapshot's filter data columns have different lengths.");
+        }
+
+        m_filter_columns.reserve(m_filter_columns.size() + log_levels.size());
+        for (size_t i{0}; i < log_levels.size(); ++i) {
+            if (log_levels[i] >= clp::enum_to_underlying_type(LogLevel::LENGTH)) {
+                throw_corrupt_snapshot("The snapshot contains an invalid log level.");
+            }
+            m_filter_columns.push_back(
+                    static_cast<LogLevel>(log_levels[i]),
+                    timestamps[i],
+                    UtcOffset{utc_offsets[i]}
+            );
+        }
+    }
+
+    /**
+     * Writes the log events' filter data to a snapshot.
+     * @param writer
+     */
+    auto write_filter_data_snapshot(SnapshotWriter& writer) const -> void {
+        writer.write_array(m_filter_columns.get_log_levels());
+        writer.write_array(m_filter_columns.get_timestamps());
+        writer.write_array(m_filter_columns.get_utc_offsets());
+    }
+
+    [[nodiscard]] auto size() const -> size_t { return m_filter_columns.size(); }
+
+    [[nodiscard]] auto empty() const -> bool { return m_filter_columns.empty(); }
+
+    [[nodiscard]] auto is_storing_log_events() const -> bool { return m_is_storing_log_events; }
+
+    [[nodiscard]] auto get_filter_columns() const -> LogEventFilterColumns const& {
+        return m_filter_columns;
+    }
+
+    /**
+     * NOTE: Only valid if the collection is storing log events.
+     * @param log_event_idx
+     * @return The log event at `log_event_idx`.
+     */
+    [[nodiscard]] auto get_log_event(size_t log_event_idx) const -> LogEvent const& {
+        return m_log_events[log_event_idx];
+    }
+
+    /**
+     * NOTE: Only valid if the collection is storing log events.
+     * @param log_event_idx
+     * @return The log event at `log_event_idx`.
+     */
+    [[nodiscard]] auto get_log_event(size_t log_event_idx) -> LogEvent& {
+        return m_log_events[log_event_idx];
+    }
+
+private:
+    bool m_is_storing_log_events;
+    LogEventFilterColumns m_filter_columns;
+    std::vector<LogEvent> m_log_events;
+};
+}  // namespace clp_ffi_js::ir
+
+#endif  // CLP_FFI_JS_IR_LOGEVENTS_HPP
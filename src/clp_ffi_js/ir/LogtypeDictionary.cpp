@@ -0,0 +1,171 @@
+#include "LogtypeDictionary.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <format>
+#include <iterator>
+#include <limits>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <clp/ErrorCode.hpp>
+#include <clp/ffi/encoding_methods.hpp>
+#include <clp/ir/types.hpp>
+#include <clp/type_utils.hpp>
+
+#include <clp_ffi_js/ClpFfiJsException.hpp>
+#include <clp_ffi_js/constants.hpp>
+#include <clp_ffi_js/ir/Snapshot.hpp>
+
+namespace clp_ffi_js::ir {
+auto LogtypeDictionary::read_snapshot(SnapshotReader& reader) -> LogtypeDictionary {
+    LogtypeDictionary dictionary;
+    auto const num_logtypes{reader.read_size()};
+    for (size_t i{0}; i < num_logtypes; ++i) {
+        if (dictionary.intern(reader.read_string()) != i) {
+            throw_corrupt_snapshot("The snapshot contains duplicate logtypes.");
+        }
+    }
+    return dictionary;
+}
+
+auto LogtypeDictionary::intern(std::string const& logtype) -> logtype_id_t {
+    if (auto const it{m_logtype_ids.find(logtype)}; m_logtype_ids.end() != it) {
+        return it->second;
+    }
+
+    if (m_entries.size() > std::numeric_limits<logtype_id_t>::max()) {
+        throw ClpFfiJsException{
+                clp::ErrorCode::ErrorCode_OutOfBounds,
+                __FILENAME__,
+                __LINE__,
+                std::format(
+                        "The number of distinct logtypes exceeds the supported maximum ({}).",
+                        std::numeric_limits<logtype_id_t>::max()
+                )
+        };
+    }
+    auto const logtype_id{static_cast<logtype_id_t>(m_entries.size())};
+    m_entries.emplace_back(create_entry(logtype));
+    m_logtype_ids.emplace(logtype, logtype_id);
+    return logtype_id;
+}
+
+auto LogtypeDictionary::find(std::string const& logtype) const -> std::optional<logtype_id_t> {
+    if (auto const it{m_logtype_ids.find(logtype)}; m_logtype_ids.end() != it) {
+        return it->second;
+    }
+    return std::nullopt;
+}
+
+auto LogtypeDictionary::append_decoded_message(
+        logtype_id_t logtype_id,
+        std::span<clp::ir::four_byte_encoded_variable_t const> encoded_vars,
+        std::span<std::string const> dict_vars,
+        std::string& output
+) const -> bool {
+    auto const& entry{m_entries[logtype_id]};
+    if (false == entry.is_valid || encoded_vars.size() < entry.num_encoded_vars
+        || dict_vars.size() < entry.num_dict_vars)
+    {
+        return false;
+    }
+
+    size_t encoded_var_idx{0};
+    size_t dict_var_idx{0};
+    for (size_t i{0}; i < entry.placeholders.size(); ++i) {
+        output.append(entry.constants[i]);
+        switch (entry.placeholders[i]) {
+            case clp::ir::VariablePlaceholder::Integer:
+                output.append(clp::ffi::decode_integer_var(encoded_vars[encoded_var_idx++]));
+                break;
+            case clp::ir::VariablePlaceholder::Float:
+                output.append(clp::ffi::decode_float_var(encoded_vars[encoded_var_idx++]));
+                break;
+            case clp::ir::VariablePlaceholder::Dictionary:
+                output.append(dict_vars[dict_var_idx++]);
+                break;
+            default:
+                return false;
+        }
+    }
+    output.append(entry.constants.back());
+    return true;
+}
+
+auto LogtypeDictionary::write_snapshot(SnapshotWriter& writer) const -> void {
+    std::vector<std::string const*> logtypes(m_entries.size());
+    for (auto const& [logtype, logtype_id] : m_logtype_ids) {
+        logtypes[logtype_id] = &logtype;
+    }
+    writer.write_size(logtypes.size());
+    for (auto const* logtype : logtypes) {
+        writer.write_string(*logtype);
+    }
+}
+
+auto LogtypeDictionary::create_entry(std::string const& logtype) -> Entry {
+    Entry entry{
+            .log_level = LogLevel::NONE,
+            .constants = {std::string{}},
+            .placeholders = {},
+            .num_encoded_vars = 0,
+            .num_dict_vars = 0,
+            .is_valid = true
+    };
+
+    constexpr size_t cLogLevelPositionInMessages{1};
+    if (logtype.length() > cLogLevelPositionInMessages) {
+        std::string_view const logtype_after_level_position{
+                std::string_view{logtype}.substr(cLogLevelPositionInMessages)
+        };
+        // NOLINTNEXTLINE(readability-qualified-auto)
+        auto const log_level_name_it{std::find_if(
+                cLogLevelNames.begin() + static_cast<size_t>(cValidLogLevelsBeginIdx),
+                cLogLevelNames.end(),
+                [&](std::string_view level) {
+                    return logtype_after_level_position.starts_with(level);
+                }
+        )};
+        if (log_level_name_it != cLogLevelNames.end()) {
+            entry.log_level = static_cast<LogLevel>(
+                    std::distance(cLogLevelNames.begin(), log_level_name_it)
+            );
+        }
+    }
+
+    for (size_t i{0}; i < logtype.size(); ++i) {
+        auto const c{logtype[i]};
+        switch (c) {
+            case clp::enum_to_underlying_type(clp::ir::VariablePlaceholder::Escape):
+                // The character after an escape character is constant text, even if it's a
+                // placeholder or escape character.
+                if (i + 1 == logtype.size()) {
+                    entry.is_valid = false;
+                    break;
+                }
+                ++i;
+                entry.constants.back().push_back(logtype[i]);
+                break;
+            case clp::enum_to_underlying_type(clp::ir::VariablePlaceholder::Integer):
+            case clp::enum_to_underlying_type(clp::ir::VariablePlaceholder::Float):
+                ++entry.num_encoded_vars;
+                entry.placeholders.push_back(static_cast<clp::ir::VariablePlaceholder>(c));
+                entry.constants.emplace_back();
+                break;
+            case clp::enum_to_underlying_type(clp::ir::VariablePlaceholder::Dictionary):
+                ++entry.num_dict_vars;
+                entry.placeholders.push_back(static_cast<clp::ir::VariablePlaceholder>(c));
+                entry.constants.emplace_back();
+                break;
+            default:
+                entry.constants.back().push_back(c);
+                break;
+        }
+    }
+    return entry;
+}
+}  // namespace clp_ffi_js::ir
@@ -0,0 +1,117 @@
+#ifndef CLP_FFI_JS_IR_LOGTYPEDICTIONARY_HPP
+#define CLP_FFI_JS_IR_LOGTYPEDICTIONARY_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <clp/ir/types.hpp>
+
+#include <clp_ffi_js/constants.hpp>
+#include <clp_ffi_js/ir/Snapshot.hpp>
+
+namespace clp_ffi_js::ir {
+/**
+ * Class that interns the logtypes of an unstructured IR stream, so that each log event only needs
+ * to store a small ID rather than its own copy of its logtype, and so that the facts derived from a
+ * logtype (its log level and the layout of its constant text and variable placeholders) are
+ * computed once per distinct logtype rather than once per log event.
+ */
+class LogtypeDictionary {
+public:
+    // Types
+    using logtype_id_t = uint32_t;
+
+    struct Entry {
+        LogLevel log_level;
+        // The logtype's unescaped constant text, split at its variable placeholders, so that
+        // `constants[i]` precedes `placeholders[i]` and `constants.back()` follows the last
+        // placeholder.
+        std::vector<std::string> constants;
+        std::vector<clp::ir::VariablePlaceholder> placeholders;
+        size_t num_encoded_vars;
+        size_t num_dict_vars;
+        // Whether the logtype can be decoded (i.e., it doesn't end with an escape character).
+        bool is_valid;
+    };
+
+    // Factory function
+    /**
+     * Reads a dictionary written by `write_snapshot`.
+     * @param reader
+     * @return The read dictionary, with the same IDs as the written one.
+     * @throw ClpFfiJsException if the snapshot is truncated or contains duplicate logtypes.
+     */
+    [[nodiscard]] static auto read_snapshot(SnapshotReader& reader) -> LogtypeDictionary;
+
+    // Methods
+    /**
+     * @param logtype
+     * @return The ID of the given logtype, which is added to the dictionary if it's not already in
+     * it.
+     * @throw ClpFfiJsException if the dictionary already contains the maximum number of logtypes.
+     */
+    [[nodiscard]] auto intern(std::string const& logtype) -> logtype_id_t;
+
+    /**
+     * @param logtype
+     * @return The ID of the given logtype, or `std::nullopt` if it's not in the dictionary.
+     */
+    [[nodiscard]] auto find(std::string const& logtype) const -> std::optional<logtype_id_t>;
+
+    [[nodiscard]] auto size() const -> size_t { return m_entries.size(); }
+
+    [[nodiscard]] auto get_entry(logtype_id_t logtype_id) const -> Entry const& {
+        return m_entries[logtype_id];
+    }
+
+    /**
+     * Decodes a message with the given logtype and variables, and appends it to `output`.
+     * @param logtype_id
+     * @param encoded_vars
+     * @param dict_vars
+     * @param output
+     * @return Whether the message was decoded. If not, `output` may contain part of the message.
+     */
+    [[nodiscard]] auto append_decoded_message(
+            logtype_id_t logtype_id,
+            std::span<clp::ir::four_byte_encoded_variable_t const> encoded_vars,
+            std::span<std::string const> dict_vars,
+            std::string& output
+    ) const -> bool;
+
+    /**
+     * Writes the dictionary's logtypes to a snapshot, in order of ID.
+     * @param writer
+     */
+    auto write_snapshot(SnapshotWriter& writer) const -> void;
+
+private:
+    // Methods
+    /**
+     * @param logtype
+     * @return The facts derived from the given logtype.
+     */
+    [[nodiscard]] static auto create_entry(std::string const& logtype) -> Entry;
+
+    // Variables
+    std::unordered_map<std::string, logtype_id_t> m_logtype_ids;
+    std::vector<Entry> m_entries;
+};
+
+/**
+ * An unstructured log event's message, with its logtype interned in a `LogtypeDictionary`. The log
+ * event's timestamp and UTC offset are stored with its filter data (see `LogEventFilterColumns`).
+ */
+struct InternedUnstructuredLogEvent {
+    LogtypeDictionary::logtype_id_t logtype_id;
+    std::vector<clp::ir::four_byte_encoded_variable_t> encoded_vars;
+    std::vector<std::string> dict_vars;
+};
+}  // namespace clp_ffi_js::ir
+
+#endif  // CLP_FFI_JS_IR_LOGTYPEDICTIONARY_HPP
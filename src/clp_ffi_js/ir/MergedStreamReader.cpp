@@ -0,0 +1,374 @@
+#include "MergedStreamReader.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <numeric>
+#include <queue>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <clp/ErrorCode.hpp>
+#include <clp/ir/types.hpp>
+#include <emscripten/bind.h>
+#include <emscripten/val.h>
+#include <spdlog/spdlog.h>
+
+#include <clp_ffi_js/binding_types.hpp>
+#include <clp_ffi_js/ClpFfiJsException.hpp>
+#include <clp_ffi_js/ir/LogEventFilterColumns.hpp>
+#include <clp_ffi_js/ir/StreamReader.hpp>
+
+namespace clp_ffi_js::ir {
+namespace {
+/**
+ * Creates a reader for each of the given sources, deserializing each stream before creating the
+ * next reader.
+ *
+ * In builds with pthreads enabled, a reader's decompression thread holds a preallocated worker
+ * until its stream has been read to the end, so deserializing the streams one at a time lets every
+ * stream be decompressed on a worker, however many streams are merged.
+ * @tparam Source
+ * @tparam CreateFunc
+ * @param sources
+ * @param create Function that creates a `StreamReader` from a source.
+ * @return The created readers.
+ * @throw ClpFfiJsException if `sources` is empty.
+ * @throw Propagates `create`'s exceptions.
+ */
+template <typename Source, typename CreateFunc>
+auto create_stream_readers(std::vector<Source> const& sources, CreateFunc create)
+        -> std::vector<std::unique_ptr<StreamReader>>;
+
+/**
+ * @param filter_columns
+ * @return The indices of the log events in chronological order, with log events that have equal
+ * timestamps ordered by index.
+ */
+auto get_chronological_order(LogEventFilterColumns const& filter_columns) -> std::vector<size_t>;
+
+template <typename Source, typename CreateFunc>
+auto create_stream_readers(std::vector<Source> const& sources, CreateFunc create)
+        -> std::vector<std::unique_ptr<StreamReader>> {
+    if (sources.empty()) {
+        throw ClpFfiJsException{
+                clp::ErrorCode::ErrorCode_BadParam,
+                __FILENAME__,
+                __LINE__,
+                "At least one stream must be given."
+        };
+    }
+
+    std::vector<std::unique_ptr<StreamReader>> stream_readers;
+    stream_readers.reserve(sources.size());
+    for (auto const& source : sources) {
+        stream_readers.emplace_back(create(source));
+        std::ignore = stream_readers.back()->deserialize_stream();
+    }
+    return stream_readers;
+}
+
+auto get_chronological_order(LogEventFilterColumns const& filter_columns) -> std::vector<size_t> {
+    std::vector<size_t> log_event_indices(filter_columns.size());
+    std::iota(log_event_indices.begin(), log_event_indices.end(), 0);
+    if (false == filter_columns.is_chronological()) {
+        std::ranges::stable_sort(log_event_indices, {}, [&](size_t log_event_idx) {
+            return filter_columns.get_timestamp(log_event_idx);
+        });
+    }
+    return log_event_indices;
+}
+}  // namespace
+
+auto MergedStreamReader::create(
+        DataArraysTsType const& data_arrays,
+        ReaderOptions const& reader_options
+) -> std::unique_ptr<MergedStreamReader> {
+    auto stream_readers{create_stream_readers(
+            emscripten::vecFromJSArray<emscripten::val>(data_arrays),
+            [&](emscripten::val const& data_array) {
+                return StreamReader::create(DataArrayTsType{data_array}, reader_options);
+            }
+    )};
+    SPDLOG_INFO("MergedStreamReader::create: got {} streams", stream_readers.size());
+    return std::unique_ptr<MergedStreamReader>{new MergedStreamReader{std::move(stream_readers)}};
+}
+
+auto MergedStreamReader::create_from_files(
+        PathsTsType const& paths,
+        ReaderOptions const& reader_options
+) -> std::unique_ptr<MergedStreamReader> {
+    auto stream_readers{create_stream_readers(
+            emscripten::vecFromJSArray<std::string>(paths),
+            [&](std::string const& path) {
+                return StreamReader::create_from_file(path, reader_options);
+            }
+    )};
+    SPDLOG_INFO("MergedStreamReader::create_from_files: got {} streams", stream_readers.size());
+    return std::unique_ptr<MergedStreamReader>{new MergedStreamReader{std::move(stream_readers)}};
+}
+
+auto MergedStreamReader::get_filtered_log_event_map() const -> FilteredLogEventMapTsType {
+    if (false == m_filtered_log_event_map.has_value()) {
+        return FilteredLogEventMapTsType{emscripten::val::null()};
+    }
+    return FilteredLogEventMapTsType{to_js_array(m_filtered_log_event_map.value())};
+}
+
+void MergedStreamReader::filter_log_events(
+        LogLevelFilterTsType const& log_level_filter,
+        std::string const& kql_filter
+) {
+    for (auto& stream_reader : m_stream_readers) {
+        stream_reader->filter_log_events(log_level_filter, kql_filter);
+    }
+    update_filtered_log_event_map();
+}
+
+auto MergedStreamReader::deserialize_stream() -> size_t {
+    if (m_is_merged) {
+        return m_merged_log_events.size();
+    }
+
+    merge_log_events();
+    // Map the streams' active filters, if any, into the merged collection.
+    update_filtered_log_event_map();
+    return m_merged_log_events.size();
+}
+
+auto MergedStreamReader::decode_range(size_t begin_idx, size_t end_idx, bool use_filter) const
+        -> MergedDecodedResultsTsType {
+    if (use_filter && false == m_filtered_log_event_map.has_value()) {
+        return MergedDecodedResultsTsType{emscripten::val::null()};
+    }
+
+    auto const length{use_filter ? m_filtered_log_event_map->size() : m_merged_log_events.size()};
+    if (length < end_idx || begin_idx > end_idx) {
+        SPDLOG_ERROR("Invalid log event index range: {}-{}", begin_idx, end_idx);
+        return MergedDecodedResultsTsType{emscripten::val::null()};
+    }
+
+    auto const get_merged_idx = [&](size_t idx) {
+        return use_filter ? m_filtered_log_event_map->at(idx) : idx;
+    };
+
+    auto results{emscripten::val::array()};
+    // Decode each run of consecutive log events from the same stream with a single call.
+    for (auto run_begin_idx{begin_idx}; run_begin_idx < end_idx;) {
+        auto const& run_begin{m_merged_log_events[get_merged_idx(run_begin_idx)]};
+        auto run_end_idx{run_begin_idx + 1};
+        while (run_end_idx < end_idx) {
+            auto const& next{m_merged_log_events[get_merged_idx(run_end_idx)]};
+            if (next.stream_idx != run_begin.stream_idx
+                || next.log_event_idx != run_begin.log_event_idx + (run_end_idx - run_begin_idx))
+            {
+                break;
+            }
+            ++run_end_idx;
+        }
+
+        auto const stream_results{
+                m_stream_readers[run_begin.stream_idx]
+                        ->decode_range(
+                                run_begin.log_event_idx,
+                                run_begin.log_event_idx + (run_end_idx - run_begin_idx),
+                                false
+                        )
+        };
+        for (auto idx{run_begin_idx}; idx < run_end_idx; ++idx) {
+            auto result{stream_results[to_js_size(idx - run_begin_idx)]};
+            result.set("streamId", to_js_size(run_begin.stream_idx));
+            result.set("streamLogEventNum", result["logEventNum"]);
+            result.set("logEventNum", to_js_size(get_merged_idx(idx) + 1));
+            results.call<void>("push", result);
+        }
+        run_begin_idx = run_end_idx;
+    }
+    return MergedDecodedResultsTsType{results};
+}
+
+auto MergedStreamReader::find_nearest_log_event_by_timestamp(
+        clp::ir::epoch_time_ms_t const target_ts
+) const -> NullableLogEventIdx {
+    if (m_merged_log_events.empty()) {
+        return NullableLogEventIdx{emscripten::val::null()};
+    }
+
+    // The merged collection is in chronological order.
+    auto const first_greater_it{std::ranges::upper_bound(
+            m_merged_log_events,
+            target_ts,
+            {},
+            [this](MergedLogEvent const& merged_log_event) {
+                return get_timestamp(merged_log_event);
+            }
+    )};
+    if (first_greater_it == m_merged_log_events.cbegin()) {
+        return NullableLogEventIdx{emscripten::val(to_js_size(0))};
+    }
+    auto const first_greater_idx{std::distance(m_merged_log_events.cbegin(), first_greater_it)};
+    return NullableLogEventIdx{
+            emscripten::val(to_js_size(static_cast<size_t>(first_greater_idx - 1)))
+    };
+}
+
+auto MergedStreamReader::merge_log_events() -> void {
+    std::vector<std::vector<size_t>> chronological_orders;
+    chronological_orders.reserve(m_stream_readers.size());
+    size_t num_log_events{0};
+    for (auto const& stream_reader : m_stream_readers) {
+        chronological_orders.emplace_back(
+                get_chronological_order(stream_reader->get_filter_columns())
+        );
+        num_log_events += chronological_orders.back().size();
+        m_merged_log_event_indices.emplace_back(chronological_orders.back().size());
+    }
+
+    // A min-heap of the next log event of each stream that hasn't been exhausted, as
+    // (timestamp, stream index, position in the stream's chronological order).
+    using HeapEntry = std::tuple<clp::ir::epoch_time_ms_t, size_t, size_t>;
+    std::priority_queue<HeapEntry, std::vector<HeapEntry>, std::greater<>> heap;
+    auto const push_next = [&](size_t stream_idx, size_t position) {
+        auto const& chronological_order{chronological_orders[stream_idx]};
+        if (position >= chronological_order.size()) {
+            return;
+        }
+        heap.emplace(
+                m_stream_readers[stream_idx]->get_filter_columns().get_timestamp(
+                        chronological_order[position]
+                ),
+                stream_idx,
+                position
+        );
+    };
+    for (size_t stream_idx{0}; stream_idx < m_stream_readers.size(); ++stream_idx) {
+        push_next(stream_idx, 0);
+    }
+
+    m_merged_log_events.reserve(num_log_events);
+    while (false == heap.empty()) {
+        auto const [timestamp, stream_idx, position] = heap.top();
+        heap.pop();
+        auto const log_event_idx{chronological_orders[stream_idx][position]};
+        m_merged_log_event_indices[stream_idx][log_event_idx] = m_merged_log_events.size();
+        m_merged_log_events.push_back({stream_idx, log_event_idx});
+        push_next(stream_idx, position + 1);
+    }
+    m_is_merged = true;
+}
+
+auto MergedStreamReader::update_filtered_log_event_map() -> void {
+    m_filtered_log_event_map.reset();
+    if (false == m_is_merged) {
+        return;
+    }
+
+    std::vector<size_t> filtered_log_event_indices;
+    bool has_filter{false};
+    for (size_t stream_idx{0}; stream_idx < m_stream_readers.size(); ++stream_idx) {
+        auto const& stream_filtered_log_event_indices{
+                m_stream_readers[stream_idx]->get_filtered_log_event_indices()
+        };
+        if (false == stream_filtered_log_event_indices.has_value()) {
+            continue;
+        }
+        has_filter = true;
+        for (auto const log_event_idx : stream_filtered_log_event_indices.value()) {
+            filtered_log_event_indices.push_back(
+                    m_merged_log_event_indices[stream_idx][log_event_idx]
+            );
+        }
+    }
+    if (false == has_filter) {
+        return;
+    }
+    std::ranges::sort(filtered_log_event_indices);
+    m_filtered_log_event_map.emplace(std::move(filtered_log_event_indices));
+}
+}  // namespace clp_ffi_js::ir
+
+namespace {
+EMSCRIPTEN_BINDINGS(ClpMergedStreamReader) {
+    // JS types used as inputs
+    emscripten::register_type<clp_ffi_js::ir::DataArraysTsType>("Uint8Array[]");
+    emscripten::register_type<clp_ffi_js::ir::PathsTsType>("string[]");
+
+    // JS types used as outputs
+    emscripten::register_type<clp_ffi_js::ir::MergedDecodedResultsTsType>(
+            "Array<{logEventNum: number, logLevel: number, message: string, timestamp: bigint, "
+            "utcOffset: bigint, streamId: number, streamLogEventNum: number}> | null"
+    );
+
+    using clp_ffi_js::from_js_size;
+    using clp_ffi_js::js_size_t;
+    using clp_ffi_js::to_js_size;
+    using clp_ffi_js::ir::MergedStreamReader;
+    emscripten::class_<MergedStreamReader>("ClpMergedStreamReader")
+            .constructor(
+                    &MergedStreamReader::create,
+                    emscripten::return_value_policy::take_ownership()
+            )
+#ifdef CLP_FFI_JS_ENVIRONMENT_NODE
+            .class_function(
+                    "createFromFiles",
+                    &MergedStreamReader::create_from_files,
+                    emscripten::return_value_policy::take_ownership()
+            )
+#endif
+            .function(
+                    "getNumStreams",
+                    emscripten::optional_override([](MergedStreamReader const& self) {
+                        return to_js_size(self.get_num_streams());
+                    })
+            )
+            .function(
+                    "getNumEventsBuffered",
+                    emscripten::optional_override([](MergedStreamReader const& self) {
+                        return to_js_size(self.get_num_events_buffered());
+                    })
+            )
+            .function(
+                    "getFilteredLogEventMap",
+                    &MergedStreamReader::get_filtered_log_event_map
+            )
+            .function(
+                    "filterLogEvents",
+                    emscripten::select_overload<void(clp_ffi_js::ir::LogLevelFilterTsType const&)>(
+                            &MergedStreamReader::filter_log_events
+                    )
+            )
+            .function(
+                    "filterLogEvents",
+                    emscripten::select_overload<
+                            void(clp_ffi_js::ir::LogLevelFilterTsType const&, std::string const&)
+                    >(&MergedStreamReader::filter_log_events)
+            )
+            .function(
+                    "deserializeStream",
+                    emscripten::optional_override([](MergedStreamReader& self) {
+                        return to_js_size(self.deserialize_stream());
+                    })
+            )
+            .function(
+                    "decodeRange",
+                    emscripten::optional_override([](MergedStreamReader const& self,
+                                                     js_size_t begin_idx,
+                                                     js_size_t end_idx,
+                                                     bool use_filter) {
+                        return self.decode_range(
+                                from_js_size(begin_idx),
+                                from_js_size(end_idx),
+                                use_filter
+                        );
+                    })
+            )
+            .function(
+                    "findNearestLogEventByTimestamp",
+                    &MergedStreamReader::find_nearest_log_event_by_timestamp
+            );
+}
+}  // namespace
@@ -0,0 +1,187 @@
+#ifndef CLP_FFI_JS_IR_MERGEDSTREAMREADER_HPP
+#define CLP_FFI_JS_IR_MERGEDSTREAMREADER_HPP
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <clp/ir/types.hpp>
+#include <emscripten/val.h>
+
+#include <clp_ffi_js/ir/StreamReader.hpp>
+
+namespace clp_ffi_js::ir {
+// JS types used as inputs
+EMSCRIPTEN_DECLARE_VAL_TYPE(DataArraysTsType);
+EMSCRIPTEN_DECLARE_VAL_TYPE(PathsTsType);
+
+// JS types used as outputs
+EMSCRIPTEN_DECLARE_VAL_TYPE(MergedDecodedResultsTsType);
+
+/**
+ * Class to read several IR streams (e.g., one per process or log rotation) as a single collection
+ * of log events in chronological order.
+ *
+ * The streams are deserialized one at a time as their readers are created. Once
+ * `deserialize_stream` is called, their log events are merged by timestamp with a k-way merge,
+ * which maps each index in the merged collection to a stream and an index in that stream. Log
+ * events with equal timestamps are ordered by stream, then by their order in the stream. The log
+ * events of a stream that isn't in chronological order are merged in chronological order.
+ *
+ * Filters are applied by each stream's reader, and their results are mapped into the merged
+ * collection.
+ */
+class MergedStreamReader {
+public:
+    /**
+     * Creates a `MergedStreamReader` to read from the given arrays.
+     *
+     * @param data_arrays An array of arrays, each containing a Zstandard-compressed IR stream.
+     * @param reader_options The options for every stream's reader.
+     * @return The created instance.
+     * @throw ClpFfiJsException if `data_arrays` is empty, or any error occurs while creating the
+     * streams' readers or deserializing the streams.
+     */
+    [[nodiscard]] static auto
+    create(DataArraysTsType const& data_arrays, ReaderOptions const& reader_options)
+            -> std::unique_ptr<MergedStreamReader>;
+
+    /**
+     * Creates a `MergedStreamReader` that reads the IR streams from files.
+     *
+     * NOTE: This is only exposed to JavaScript in Node.js builds. See
+     * `StreamReader::create_from_file`.
+     *
+     * @param paths An array of paths of files, each containing a Zstandard-compressed IR stream.
+     * @param reader_options The options for every stream's reader.
+     * @return The created instance.
+     * @throw ClpFfiJsException if `paths` is empty, or any error occurs while creating the streams'
+     * readers or deserializing the streams.
+     */
+    [[nodiscard]] static auto
+    create_from_files(PathsTsType const& paths, ReaderOptions const& reader_options)
+            -> std::unique_ptr<MergedStreamReader>;
+
+    // Methods
+    /**
+     * @return The number of streams being merged.
+     */
+    [[nodiscard]] auto get_num_streams() const -> size_t { return m_stream_readers.size(); }
+
+    /**
+     * @return The number of log events in the merged collection, which is 0 until the streams are
+     * deserialized.
+     */
+    [[nodiscard]] auto get_num_events_buffered() const -> size_t {
+        return m_merged_log_events.size();
+    }
+
+    /**
+     * @return The filtered log events map of the merged collection. See
+     * `StreamReader::get_filtered_log_event_map`.
+     */
+    [[nodiscard]] auto get_filtered_log_event_map() const -> FilteredLogEventMapTsType;
+
+    /**
+     * Generates a filtered collection from all log events by filtering every stream.
+     *
+     * @param log_level_filter
+     * @param kql_filter
+     * @see StreamReader::filter_log_events
+     */
+    void
+    filter_log_events(LogLevelFilterTsType const& log_level_filter, std::string const& kql_filter);
+
+    /**
+     * Generates a filtered collection from all log events by filtering every stream.
+     *
+     * @param log_level_filter Array of selected log levels.
+     */
+    void filter_log_events(LogLevelFilterTsType const& log_level_filter) {
+        filter_log_events(log_level_filter, "");
+    }
+
+    /**
+     * Merges the log events of every stream (which were deserialized when the streams' readers were
+     * created) the first time it's called.
+     *
+     * @return The number of log events in the merged collection.
+     */
+    [[nodiscard]] auto deserialize_stream() -> size_t;
+
+    /**
+     * Decodes log events in the range `[beginIdx, endIdx)` of the merged filtered or unfiltered
+     * (depending on the value of `useFilter`) log events collection.
+     *
+     * @param begin_idx
+     * @param end_idx
+     * @param use_filter Whether to decode from the filtered or unfiltered log events collection.
+     * @return An array of objects with the properties described in `StreamReader::decode_range`,
+     * where `logEventNum` is the log event's number (1-indexed) in the merged collection, and with
+     * the following additional properties:
+     * - streamId: The index of the log event's stream.
+     * - streamLogEventNum: The log event's number (1-indexed) in its stream.
+     * @return null if any log event in the range doesn't exist (e.g. the range exceeds the number
+     * of log events in the collection).
+     * @throw ClpFfiJsException if a message cannot be decoded.
+     */
+    [[nodiscard]] auto decode_range(size_t begin_idx, size_t end_idx, bool use_filter) const
+            -> MergedDecodedResultsTsType;
+
+    /**
+     * Finds the log event in the merged collection nearest to `target_ts`.
+     *
+     * @param target_ts
+     * @return The index of the log event L described in
+     * `StreamReader::find_nearest_log_event_by_timestamp`.
+     * @return null if there are no log events.
+     */
+    [[nodiscard]] auto find_nearest_log_event_by_timestamp(clp::ir::epoch_time_ms_t target_ts
+    ) const -> NullableLogEventIdx;
+
+private:
+    // Types
+    struct MergedLogEvent {
+        size_t stream_idx;
+        size_t log_event_idx;
+    };
+
+    // Constructor
+    explicit MergedStreamReader(std::vector<std::unique_ptr<StreamReader>> stream_readers)
+            : m_stream_readers{std::move(stream_readers)} {}
+
+    // Methods
+    /**
+     * Merges the buffered log events of every stream by timestamp.
+     */
+    auto merge_log_events() -> void;
+
+    /**
+     * Maps the filtered log events of every stream into the merged collection.
+     */
+    auto update_filtered_log_event_map() -> void;
+
+    /**
+     * @param merged_log_event
+     * @return The timestamp of the given log event.
+     */
+    [[nodiscard]] auto get_timestamp(MergedLogEvent const& merged_log_event) const
+            -> clp::ir::epoch_time_ms_t {
+        return m_stream_readers[merged_log_event.stream_idx]->get_filter_columns().get_timestamp(
+                merged_log_event.log_event_idx
+        );
+    }
+
+    // Variables
+    std::vector<std::unique_ptr<StreamReader>> m_stream_readers;
+    std::vector<MergedLogEvent> m_merged_log_events;
+    // For each stream, the index in the merged collection of each of the stream's log events.
+    std::vector<std::vector<size_t>> m_merged_log_event_indices;
+    FilteredLogEventsMap m_filtered_log_event_map;
+    bool m_is_merged{false};
+};
+}  // namespace clp_ffi_js::ir
+
+#endif  // CLP_FFI_JS_IR_MERGEDSTREAMREADER_HPP
@@ -0,0 +1,215 @@
+#include "PipelinedZstdReader.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <thread>
+
+#include <clp/ErrorCode.hpp>
+#include <clp/streaming_compression/zstd/Decompressor.hpp>
+#include <spdlog/spdlog.h>
+
+#include <clp_ffi_js/ir/PthreadPoolReservation.hpp>
+
+namespace clp_ffi_js::ir {
+PipelinedZstdReader::PipelinedZstdReader(std::span<char const> compressed_data)
+        : m_compressed_data{compressed_data} {
+    for (auto& block : m_blocks) {
+        block.data.resize(cBlockSize);
+    }
+    start_decompression();
+}
+
+auto PipelinedZstdReader::try_read(char* buf, size_t num_bytes_to_read, size_t& num_bytes_read)
+        -> clp::ErrorCode {
+    if (nullptr == buf && num_bytes_to_read > 0) {
+        return clp::ErrorCode_BadParam;
+    }
+
+    num_bytes_read = 0;
+    auto error_code{clp::ErrorCode_Success};
+    while (num_bytes_read < num_bytes_to_read) {
+        if (false == m_has_read_block) {
+            advance_to_next_block();
+        }
+        auto const& block{m_blocks[m_read_block_idx]};
+        if (block.size == m_read_idx) {
+            if (clp::ErrorCode_Success != block.error_code) {
+                // The decompression thread exits after filling the last block, so join it to
+                // return its worker to the pool.
+                join_decompression_thread();
+                error_code = block.error_code;
+                break;
+            }
+            advance_to_next_block();
+            continue;
+        }
+
+        auto const num_bytes_to_copy{
+                std::min(num_bytes_to_read - num_bytes_read, block.size - m_read_idx)
+        };
+        std::copy_n(
+                block.data.cbegin() + static_cast<std::ptrdiff_t>(m_read_idx),
+                num_bytes_to_copy,
+                buf + num_bytes_read
+        );
+        m_read_idx += num_bytes_to_copy;
+        num_bytes_read += num_bytes_to_copy;
+    }
+
+    if (0 == num_bytes_read && num_bytes_to_read > 0) {
+        return error_code;
+    }
+    return clp::ErrorCode_Success;
+}
+
+auto PipelinedZstdReader::try_seek_from_begin(size_t pos) -> clp::ErrorCode {
+    auto current_pos{m_has_read_block ? m_read_block_begin_pos + m_read_idx : 0};
+    if (pos < current_pos) {
+        if (m_has_read_block && pos >= m_read_block_begin_pos) {
+            m_read_idx = pos - m_read_block_begin_pos;
+            return clp::ErrorCode_Success;
+        }
+        stop_decompression();
+        start_decompression();
+        current_pos = 0;
+    }
+
+    // Skip forwards to `pos`.
+    std::array<char, 4096> skip_buf{};
+    while (current_pos < pos) {
+        size_t num_bytes_read{0};
+        auto const error_code{try_read(
+                skip_buf.data(),
+                std::min(skip_buf.size(), pos - current_pos),
+                num_bytes_read
+        )};
+        if (clp::ErrorCode_EndOfFile == error_code) {
+            return clp::ErrorCode_Truncated;
+        }
+        if (clp::ErrorCode_Success != error_code) {
+            return error_code;
+        }
+        current_pos += num_bytes_read;
+    }
+    return clp::ErrorCode_Success;
+}
+
+auto PipelinedZstdReader::try_get_pos(size_t& pos) -> clp::ErrorCode {
+    pos = m_has_read_block ? m_read_block_begin_pos + m_read_idx : 0;
+    return clp::ErrorCode_Success;
+}
+
+auto PipelinedZstdReader::start_decompression() -> void {
+    m_num_filled_blocks = 0;
+    m_is_stop_requested = false;
+    m_read_block_idx = 0;
+    m_has_read_block = false;
+    m_read_block_begin_pos = 0;
+    m_read_idx = 0;
+
+    m_worker_reservation = PthreadPoolReservation::reserve(1);
+    if (0 == m_worker_reservation.get_num_workers()) {
+        m_inline_decompressor = std::make_unique<clp::streaming_compression::zstd::Decompressor>();
+        m_inline_decompressor->open(m_compressed_data.data(), m_compressed_data.size());
+        return;
+    }
+    m_decompression_thread = std::thread{[this]() { decompress(); }};
+}
+
+auto PipelinedZstdReader::stop_decompression() -> void {
+    m_inline_decompressor.reset();
+    if (false == m_decompression_thread.joinable()) {
+        return;
+    }
+    {
+        std::lock_guard const lock{m_mutex};
+        m_is_stop_requested = true;
+    }
+    m_block_released.notify_one();
+    join_decompression_thread();
+}
+
+auto PipelinedZstdReader::join_decompression_thread() -> void {
+    if (m_decompression_thread.joinable()) {
+        m_decompression_thread.join();
+    }
+    m_worker_reservation.release();
+}
+
+auto PipelinedZstdReader::fill_block(
+        clp::streaming_compression::zstd::Decompressor& zstd_decompressor,
+        Block& block
+) -> void {
+    try {
+        block.error_code
+                = zstd_decompressor.try_read(block.data.data(), block.data.size(), block.size);
+    } catch (std::exception const& e) {
+        SPDLOG_ERROR("Failed to decompress stream: {}", e.what());
+        block.size = 0;
+        block.error_code = clp::ErrorCode_Failure;
+    }
+    if (clp::ErrorCode_Success == block.error_code && block.size < block.data.size()) {
+        // The decompressor only returns fewer bytes than requested at the end of the stream.
+        block.error_code = clp::ErrorCode_EndOfFile;
+    }
+}
+
+auto PipelinedZstdReader::decompress() -> void {
+    clp::streaming_compression::zstd::Decompressor zstd_decompressor;
+    zstd_decompressor.open(m_compressed_data.data(), m_compressed_data.size());
+
+    for (size_t block_idx{0}; true; block_idx = (block_idx + 1) % cNumBlocks) {
+        {
+            std::unique_lock lock{m_mutex};
+            m_block_released.wait(lock, [this]() {
+                return m_is_stop_requested || m_num_filled_blocks < cNumBlocks;
+            });
+            if (m_is_stop_requested) {
+                return;
+            }
+        }
+
+        // The block isn't accessed by the reading thread until it's marked as filled below.
+        auto& block{m_blocks[block_idx]};
+        fill_block(zstd_decompressor, block);
+
+        {
+            std::lock_guard const lock{m_mutex};
+            ++m_num_filled_blocks;
+        }
+        m_block_filled.notify_one();
+        if (clp::ErrorCode_Success != block.error_code) {
+            return;
+        }
+    }
+}
+
+auto PipelinedZstdReader::advance_to_next_block() -> void {
+    if (nullptr != m_inline_decompressor) {
+        if (m_has_read_block) {
+            m_read_block_begin_pos += m_blocks[m_read_block_idx].size;
+            m_read_block_idx = (m_read_block_idx + 1) % cNumBlocks;
+        }
+        fill_block(*m_inline_decompressor, m_blocks[m_read_block_idx]);
+        m_has_read_block = true;
+        m_read_idx = 0;
+        return;
+    }
+
+    std::unique_lock lock{m_mutex};
+    if (m_has_read_block) {
+        m_read_block_begin_pos += m_blocks[m_read_block_idx].size;
+        m_read_block_idx = (m_read_block_idx + 1) % cNumBlocks;
+        --m_num_filled_blocks;
+        m_block_released.notify_one();
+    }
+    m_block_filled.wait(lock, [this]() { return m_num_filled_blocks > 0; });
+    m_has_read_block = true;
+    m_read_idx = 0;
+}
+}  // namespace clp_ffi_js::ir
@@ -0,0 +1,160 @@
+#ifndef CLP_FFI_JS_IR_PIPELINEDZSTDREADER_HPP
+#define CLP_FFI_JS_IR_PIPELINEDZSTDREADER_HPP
+
+#include <array>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <vector>
+
+#include <clp/ErrorCode.hpp>
+#include <clp/ReaderInterface.hpp>
+#include <clp/streaming_compression/zstd/Decompressor.hpp>
+
+#include <clp_ffi_js/ir/PthreadPoolReservation.hpp>
+
+namespace clp_ffi_js::ir {
+/**
+ * A `clp::ReaderInterface` that decompresses an in-memory Zstandard-compressed stream on a separate
+ * thread, so that decompression overlaps with the deserialization of the bytes decompressed so far.
+ *
+ * The decompression thread fills a bounded ring of fixed-size blocks, blocking whenever all blocks
+ * are waiting to be read, while the reading thread consumes the blocks in order.
+ *
+ * The decompression thread runs on a worker reserved with `PthreadPoolReservation`, which it holds
+ * until the stream has been decompressed. If every worker is reserved (e.g., by other readers whose
+ * streams haven't been fully read), the reading thread fills the blocks itself instead, since
+ * waiting for a worker to be freed could deadlock.
+ *
+ * NOTE: This class is only available in builds with pthreads enabled (see
+ * `CLP_FFI_JS_ENABLE_PTHREADS`).
+ */
+class PipelinedZstdReader : public clp::ReaderInterface {
+public:
+    // Constructors
+    /**
+     * Starts decompressing the given stream.
+     * @param compressed_data The compressed stream, which must outlive this instance.
+     */
+    explicit PipelinedZstdReader(std::span<char const> compressed_data);
+
+    // Disable copy/move constructors and assignment operators since the decompression thread holds
+    // a reference to this instance.
+    PipelinedZstdReader(PipelinedZstdReader const&) = delete;
+    PipelinedZstdReader(PipelinedZstdReader&&) = delete;
+    auto operator=(PipelinedZstdReader const&) -> PipelinedZstdReader& = delete;
+    auto operator=(PipelinedZstdReader&&) -> PipelinedZstdReader& = delete;
+
+    // Destructor
+    ~PipelinedZstdReader() override { stop_decompression(); }
+
+    // Methods implementing `clp::ReaderInterface`
+    /**
+     * @param buf
+     * @param num_bytes_to_read
+     * @param num_bytes_read Returns the number of bytes read.
+     * @return clp::ErrorCode_EndOfFile if the end of the decompressed stream was reached.
+     * @return Forwards `ZstdDecompressor::try_read`'s other return values on failure.
+     * @return clp::ErrorCode_Success on success.
+     */
+    [[nodiscard]] auto try_read(char* buf, size_t num_bytes_to_read, size_t& num_bytes_read)
+            -> clp::ErrorCode override;
+
+    /**
+     * Seeks within the decompressed stream. Seeking backwards beyond the block that's currently
+     * being read restarts decompression from the start of the stream.
+     * @param pos
+     * @return clp::ErrorCode_Truncated if `pos` is beyond the end of the decompressed stream.
+     * @return Forwards `try_read`'s return values on other failures.
+     * @return clp::ErrorCode_Success on success.
+     */
+    [[nodiscard]] auto try_seek_from_begin(size_t pos) -> clp::ErrorCode override;
+
+    /**
+     * @param pos Returns the current position in the decompressed stream.
+     * @return clp::ErrorCode_Success
+     */
+    [[nodiscard]] auto try_get_pos(size_t& pos) -> clp::ErrorCode override;
+
+private:
+    // Types
+    struct Block {
+        std::vector<char> data;
+        size_t size{0};
+        // `clp::ErrorCode_Success` unless this is the last block the decompression thread fills,
+        // in which case it's the error that ended decompression (`clp::ErrorCode_EndOfFile` at the
+        // end of the stream).
+        clp::ErrorCode error_code{clp::ErrorCode_Success};
+    };
+
+    // Constants
+    static constexpr size_t cNumBlocks{4};
+    static constexpr size_t cBlockSize{256UL * 1024};
+
+    // Methods
+    /**
+     * Starts decompressing the stream from its start, on a thread if a worker can be reserved for
+     * it, or on the reading thread otherwise.
+     */
+    auto start_decompression() -> void;
+
+    /**
+     * Stops the decompression thread, if any, waits for it to exit, and releases its worker.
+     */
+    auto stop_decompression() -> void;
+
+    /**
+     * Joins the decompression thread once it has exited, and releases its worker.
+     */
+    auto join_decompression_thread() -> void;
+
+    /**
+     * Decompresses the next block of the stream into `block`.
+     * @param zstd_decompressor
+     * @param block
+     */
+    static auto
+    fill_block(clp::streaming_compression::zstd::Decompressor& zstd_decompressor, Block& block)
+            -> void;
+
+    /**
+     * The decompression thread's body.
+     */
+    auto decompress() -> void;
+
+    /**
+     * Releases the block that's currently being read (if any) to the decompression thread, and
+     * waits for the next block to be filled, or fills it on the reading thread if there's no
+     * decompression thread.
+     */
+    auto advance_to_next_block() -> void;
+
+    // Variables
+    std::span<char const> m_compressed_data;
+    std::array<Block, cNumBlocks> m_blocks;
+
+    // State shared with the decompression thread, guarded by `m_mutex`.
+    std::mutex m_mutex;
+    std::condition_variable m_block_filled;
+    std::condition_variable m_block_released;
+    size_t m_num_filled_blocks{0};
+    bool m_is_stop_requested{false};
+    std::thread m_decompression_thread;
+    PthreadPoolReservation m_worker_reservation;
+
+    // Only set if the blocks are filled by the reading thread, since no worker could be reserved.
+    std::unique_ptr<clp::streaming_compression::zstd::Decompressor> m_inline_decompressor;
+
+    // The reading thread's state. The block at `m_read_block_idx` is owned by the reading thread
+    // (and counted in `m_num_filled_blocks`) if `m_has_read_block` is true.
+    size_t m_read_block_idx{0};
+    bool m_has_read_block{false};
+    size_t m_read_block_begin_pos{0};
+    size_t m_read_idx{0};
+};
+}  // namespace clp_ffi_js::ir
+
+#endif  // CLP_FFI_JS_IR_PIPELINEDZSTDREADER_HPP
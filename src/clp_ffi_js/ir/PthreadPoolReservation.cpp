@@ -0,0 +1,29 @@
+#include "PthreadPoolReservation.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+namespace clp_ffi_js::ir {
+namespace {
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+std::atomic<size_t> num_free_workers{CLP_FFI_JS_PTHREAD_POOL_SIZE};
+}  // namespace
+
+auto PthreadPoolReservation::reserve(size_t max_num_workers) -> PthreadPoolReservation {
+    auto num_free{num_free_workers.load()};
+    size_t num_workers{0};
+    do {
+        num_workers = std::min(num_free, max_num_workers);
+        if (0 == num_workers) {
+            return PthreadPoolReservation{};
+        }
+    } while (false == num_free_workers.compare_exchange_weak(num_free, num_free - num_workers));
+    return PthreadPoolReservation{num_workers};
+}
+
+auto PthreadPoolReservation::release() -> void {
+    num_free_workers += std::exchange(m_num_workers, 0);
+}
+}  // namespace clp_ffi_js::ir
@@ -0,0 +1,73 @@
+#ifndef CLP_FFI_JS_IR_PTHREADPOOLRESERVATION_HPP
+#define CLP_FFI_JS_IR_PTHREADPOOLRESERVATION_HPP
+
+#include <cstddef>
+#include <utility>
+
+namespace clp_ffi_js::ir {
+/**
+ * A reservation of some of the workers that Emscripten preallocates for threads (see
+ * `CLP_FFI_JS_PTHREAD_POOL_SIZE`), which is released when the reservation is destroyed.
+ *
+ * A thread started once every preallocated worker is in use needs a new worker, which can only
+ * start once the thread that created it returns to the event loop. Since the module's threads are
+ * joined (or waited on) by the calling thread without returning to the event loop, every thread
+ * must run on a reserved worker, and callers that can't reserve one must do their work on the
+ * calling thread instead.
+ *
+ * The reservations are counted process-wide, so they're only accurate if no other code in the
+ * module starts threads.
+ *
+ * NOTE: This class is only available in builds with pthreads enabled (see
+ * `CLP_FFI_JS_ENABLE_PTHREADS`).
+ */
+class PthreadPoolReservation {
+public:
+    // Factory function
+    /**
+     * Reserves as many of the free workers as possible, up to `max_num_workers`, without blocking.
+     * @param max_num_workers
+     * @return The reservation, which may hold no workers.
+     */
+    [[nodiscard]] static auto reserve(size_t max_num_workers) -> PthreadPoolReservation;
+
+    // Constructors
+    PthreadPoolReservation() = default;
+
+    // Disable copy constructor and assignment operator
+    PthreadPoolReservation(PthreadPoolReservation const&) = delete;
+    auto operator=(PthreadPoolReservation const&) -> PthreadPoolReservation& = delete;
+
+    // Define move constructor and assignment operator, which transfer the reserved workers
+    PthreadPoolReservation(PthreadPoolReservation&& other) noexcept
+            : m_num_workers{std::exchange(other.m_num_workers, 0)} {}
+
+    auto operator=(PthreadPoolReservation&& other) noexcept -> PthreadPoolReservation& {
+        if (this != &other) {
+            release();
+            m_num_workers = std::exchange(other.m_num_workers, 0);
+        }
+        return *this;
+    }
+
+    // Destructor
+    ~PthreadPoolReservation() { release(); }
+
+    // Methods
+    [[nodiscard]] auto get_num_workers() const -> size_t { return m_num_workers; }
+
+    /**
+     * Returns the reserved workers to the pool. The threads that ran on them must have been joined.
+     */
+    auto release() -> void;
+
+private:
+    // Constructors
+    explicit PthreadPoolReservation(size_t num_workers) : m_num_workers{num_workers} {}
+
+    // Variables
+    size_t m_num_workers{0};
+};
+}  // namespace clp_ffi_js::ir
+
+#endif  // CLP_FFI_JS_IR_PTHREADPOOLRESERVATION_HPP
@@ -0,0 +1,69 @@
+#include "Snapshot.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <limits>
+#include <span>
+#include <string>
+#include <string_view>
+
+#include <clp/ErrorCode.hpp>
+
+#include <clp_ffi_js/ClpFfiJsException.hpp>
+
+namespace clp_ffi_js::ir {
+namespace {
+constexpr uint64_t cFnv1aOffsetBasis{0xcbf2'9ce4'8422'2325};
+constexpr uint64_t cFnv1aPrime{0x100'0000'01b3};
+}  // namespace
+
+auto SnapshotReader::read_size() -> size_t {
+    auto const size{read<uint64_t>()};
+    if (size > std::numeric_limits<size_t>::max()) {
+        throw ClpFfiJsException{
+                clp::ErrorCode::ErrorCode_OutOfBounds,
+                __FILENAME__,
+                __LINE__,
+                std::format("The snapshot contains a size ({}) that's too large.", size)
+        };
+    }
+    return static_cast<size_t>(size);
+}
+
+auto SnapshotReader::read_raw(size_t num_bytes) -> std::span<char const> {
+    if (num_bytes > get_num_bytes_remaining()) {
+        throw_truncated();
+    }
+    auto const bytes{m_snapshot.subspan(m_pos, num_bytes)};
+    m_pos += num_bytes;
+    return bytes;
+}
+
+auto SnapshotReader::throw_truncated() -> void {
+    throw ClpFfiJsException{
+            clp::ErrorCode::ErrorCode_Truncated,
+            __FILENAME__,
+            __LINE__,
+            "The snapshot is truncated."
+    };
+}
+
+auto hash_snapshot_source(std::span<char const> data) -> uint64_t {
+    uint64_t hash{cFnv1aOffsetBasis};
+    for (auto const byte : data) {
+        hash ^= static_cast<uint8_t>(byte);
+        hash *= cFnv1aPrime;
+    }
+    return hash;
+}
+
+auto throw_corrupt_snapshot(std::string_view message) -> void {
+    throw ClpFfiJsException{
+            clp::ErrorCode::ErrorCode_Corrupt,
+            __FILENAME__,
+            __LINE__,
+            std::string{message}
+    };
+}
+}  // namespace clp_ffi_js::ir
@@ -0,0 +1,146 @@
+#ifndef CLP_FFI_JS_IR_SNAPSHOT_HPP
+#define CLP_FFI_JS_IR_SNAPSHOT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace clp_ffi_js::ir {
+/**
+ * Class that serializes a reader's state into a snapshot, a flat buffer of fixed-width values and
+ * length-prefixed arrays in the host's byte order (little-endian in WASM).
+ *
+ * Sizes are written as 64-bit integers, so that wasm32 and wasm64 modules can read each other's
+ * snapshots.
+ */
+class SnapshotWriter {
+public:
+    // Methods
+    template <typename Value>
+    requires std::is_trivially_copyable_v<Value>
+    auto write(Value const& value) -> void {
+        write_raw(&value, sizeof(Value));
+    }
+
+    auto write_size(size_t size) -> void { write(static_cast<uint64_t>(size)); }
+
+    template <typename Value>
+    requires std::is_trivially_copyable_v<Value>
+    auto write_array(std::span<Value const> values) -> void {
+        write_size(values.size());
+        write_raw(values.data(), values.size_bytes());
+    }
+
+    auto write_string(std::string_view str) -> void {
+        write_array(std::span<char const>{str.data(), str.size()});
+    }
+
+    [[nodiscard]] auto get_buffer() const -> std::span<char const> { return m_buffer; }
+
+private:
+    auto write_raw(void const* data, size_t num_bytes) -> void {
+        auto const* const bytes{static_cast<char const*>(data)};
+        m_buffer.insert(m_buffer.end(), bytes, bytes + num_bytes);
+    }
+
+    std::vector<char> m_buffer;
+};
+
+/**
+ * Class that reads the values written by a `SnapshotWriter`, in the same order.
+ */
+class SnapshotReader {
+public:
+    // Constructor
+    explicit SnapshotReader(std::span<char const> snapshot) : m_snapshot{snapshot} {}
+
+    // Methods
+    /**
+     * @return The next value.
+     * @throw ClpFfiJsException if the snapshot is truncated.
+     */
+    template <typename Value>
+    requires std::is_trivially_copyable_v<Value>
+    [[nodiscard]] auto read() -> Value {
+        Value value{};
+        std::memcpy(&value, read_raw(sizeof(Value)).data(), sizeof(Value));
+        return value;
+    }
+
+    /**
+     * @return The next size.
+     * @throw ClpFfiJsException if the snapshot is truncated or the size exceeds `size_t`'s range.
+     */
+    [[nodiscard]] auto read_size() -> size_t;
+
+    /**
+     * @return The next array.
+     * @throw ClpFfiJsException if the snapshot is truncated.
+     */
+    template <typename Value>
+    requires std::is_trivially_copyable_v<Value>
+    [[nodiscard]] auto read_array() -> std::vector<Value> {
+        auto const size{read_size()};
+        if (size > get_num_bytes_remaining() / sizeof(Value)) {
+            throw_truncated();
+        }
+        std::vector<Value> values(size);
+        auto const bytes{read_raw(size * sizeof(Value))};
+        if (false == values.empty()) {
+            std::memcpy(values.data(), bytes.data(), bytes.size());
+        }
+        return values;
+    }
+
+    /**
+     * @return The next string.
+     * @throw ClpFfiJsException if the snapshot is truncated.
+     */
+    [[nodiscard]] auto read_string() -> std::string {
+        auto const chars{read_array<char>()};
+        return {chars.begin(), chars.end()};
+    }
+
+    [[nodiscard]] auto get_num_bytes_remaining() const -> size_t {
+        return m_snapshot.size() - m_pos;
+    }
+
+private:
+    // Methods
+    /**
+     * @param num_bytes
+     * @return A view of the next `num_bytes` bytes.
+     * @throw ClpFfiJsException if the snapshot is truncated.
+     */
+    [[nodiscard]] auto read_raw(size_t num_bytes) -> std::span<char const>;
+
+    /**
+     * @throw ClpFfiJsException with `clp::ErrorCode_Truncated`.
+     */
+    [[noreturn]] static auto throw_truncated() -> void;
+
+    // Variables
+    std::span<char const> m_snapshot;
+    size_t m_pos{0};
+};
+
+/**
+ * @param data
+ * @return A 64-bit FNV-1a hash of `data`, used to check that a snapshot is restored with the stream
+ * it was serialized from.
+ */
+[[nodiscard]] auto hash_snapshot_source(std::span<char const> data) -> uint64_t;
+
+/**
+ * @param message
+ * @throw ClpFfiJsException with `clp::ErrorCode_Corrupt` and the given message.
+ */
+[[noreturn]] auto throw_corrupt_snapshot(std::string_view message) -> void;
+}  // namespace clp_ffi_js::ir
+
+#endif  // CLP_FFI_JS_IR_SNAPSHOT_HPP
@@ -0,0 +1,69 @@
+#include "SplicedReader.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include <clp/ErrorCode.hpp>
+#include <clp/ReaderInterface.hpp>
+
+namespace clp_ffi_js::ir {
+SplicedReader::SplicedReader(std::vector<char> prefix, clp::ReaderInterface& upstream_reader)
+        : m_prefix{std::move(prefix)},
+          m_upstream_reader{upstream_reader},
+          m_upstream_begin_pos{upstream_reader.get_pos()} {}
+
+auto SplicedReader::try_read(char* buf, size_t num_bytes_to_read, size_t& num_bytes_read)
+        -> clp::ErrorCode {
+    if (nullptr == buf && num_bytes_to_read > 0) {
+        return clp::ErrorCode_BadParam;
+    }
+
+    num_bytes_read = 0;
+    if (m_pos < m_prefix.size()) {
+        num_bytes_read = std::min(num_bytes_to_read, m_prefix.size() - m_pos);
+        std::copy_n(m_prefix.cbegin() + static_cast<std::ptrdiff_t>(m_pos), num_bytes_read, buf);
+        m_pos += num_bytes_read;
+    }
+
+    if (num_bytes_read < num_bytes_to_read) {
+        size_t num_upstream_bytes_read{0};
+        auto const err{m_upstream_reader.try_read(
+                buf + num_bytes_read,
+                num_bytes_to_read - num_bytes_read,
+                num_upstream_bytes_read
+        )};
+        m_pos += num_upstream_bytes_read;
+        num_bytes_read += num_upstream_bytes_read;
+        if (clp::ErrorCode_Success != err && clp::ErrorCode_EndOfFile != err) {
+            return err;
+        }
+    }
+
+    if (0 == num_bytes_read && num_bytes_to_read > 0) {
+        return clp::ErrorCode_EndOfFile;
+    }
+    return clp::ErrorCode_Success;
+}
+
+auto SplicedReader::try_seek_from_begin(size_t pos) -> clp::ErrorCode {
+    // The upstream reader stays at its beginning position while reading from the prefix.
+    auto const upstream_pos{
+            pos <= m_prefix.size() ? m_upstream_begin_pos
+                                   : m_upstream_begin_pos + (pos - m_prefix.size())
+    };
+    if (auto const err{m_upstream_reader.try_seek_from_begin(upstream_pos)};
+        clp::ErrorCode_Success != err)
+    {
+        return err;
+    }
+    m_pos = pos;
+    return clp::ErrorCode_Success;
+}
+
+auto SplicedReader::try_get_pos(size_t& pos) -> clp::ErrorCode {
+    pos = m_pos;
+    return clp::ErrorCode_Success;
+}
+}  // namespace clp_ffi_js::ir
@@ -0,0 +1,69 @@
+#ifndef CLP_FFI_JS_IR_SPLICEDREADER_HPP
+#define CLP_FFI_JS_IR_SPLICEDREADER_HPP
+
+#include <cstddef>
+#include <vector>
+
+#include <clp/ErrorCode.hpp>
+#include <clp/ReaderInterface.hpp>
+
+namespace clp_ffi_js::ir {
+/**
+ * A `clp::ReaderInterface` that reads an in-memory prefix followed by the rest of another reader
+ * (the "upstream" reader), starting from the upstream reader's position at construction.
+ *
+ * This allows deserialization to resume from the middle of an IR stream: the prefix contains the
+ * stream's preamble along with any IR units needed to restore the deserializer's state.
+ */
+class SplicedReader : public clp::ReaderInterface {
+public:
+    // Constructors
+    /**
+     * @param prefix
+     * @param upstream_reader
+     */
+    SplicedReader(std::vector<char> prefix, clp::ReaderInterface& upstream_reader);
+
+    // Disable copy/move constructors and assignment operators since this class holds a reference
+    // to the upstream reader.
+    SplicedReader(SplicedReader const&) = delete;
+    SplicedReader(SplicedReader&&) = delete;
+    auto operator=(SplicedReader const&) -> SplicedReader& = delete;
+    auto operator=(SplicedReader&&) -> SplicedReader& = delete;
+
+    // Destructor
+    ~SplicedReader() override = default;
+
+    // Methods implementing `clp::ReaderInterface`
+    /**
+     * @param buf
+     * @param num_bytes_to_read
+     * @param num_bytes_read Returns the number of bytes read.
+     * @return clp::ErrorCode_EndOfFile if both the prefix and the upstream reader are exhausted.
+     * @return Forwards the upstream reader's `try_read`'s other return values on failure.
+     * @return clp::ErrorCode_Success on success.
+     */
+    [[nodiscard]] auto try_read(char* buf, size_t num_bytes_to_read, size_t& num_bytes_read)
+            -> clp::ErrorCode override;
+
+    /**
+     * @param pos
+     * @return Forwards the upstream reader's `try_seek_from_begin`'s return values.
+     */
+    [[nodiscard]] auto try_seek_from_begin(size_t pos) -> clp::ErrorCode override;
+
+    /**
+     * @param pos Returns the position relative to the start of the prefix.
+     * @return clp::ErrorCode_Success
+     */
+    [[nodiscard]] auto try_get_pos(size_t& pos) -> clp::ErrorCode override;
+
+private:
+    std::vector<char> m_prefix;
+    clp::ReaderInterface& m_upstream_reader;
+    size_t m_upstream_begin_pos{0};
+    size_t m_pos{0};
+};
+}  // namespace clp_ffi_js::ir
+
+#endif  // CLP_FFI_JS_IR_SPLICEDREADER_HPP
@@ -1,11 +1,23 @@
 #include "StreamReader.hpp"
 
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
 #include <cstddef>
 #include <cstdint>
 #include <format>
+#include <limits>
 #include <memory>
+#include <optional>
+#include <span>
 #include <string>
 #include <string_view>
+#include <system_error>
+#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -19,16 +31,59 @@
 #include <emscripten/bind.h>
 #include <nlohmann/json.hpp>
 #include <spdlog/spdlog.h>
-#include <ystdlib/containers/Array.hpp>
 
+#include <clp_ffi_js/binding_types.hpp>
 #include <clp_ffi_js/ClpFfiJsException.hpp>
+#include <clp_ffi_js/constants.hpp>
+#include <clp_ffi_js/FileDescriptorReader.hpp>
+#include <clp_ffi_js/InputBuffer.hpp>
+#include <clp_ffi_js/ir/ChunkedZstdReader.hpp>
 #include <clp_ffi_js/ir/decoding_methods.hpp>
+#include <clp_ffi_js/ir/filtering_methods.hpp>
+#include <clp_ffi_js/ir/formatting_methods.hpp>
+#include <clp_ffi_js/ir/LogEventFilterColumns.hpp>
+#ifdef CLP_FFI_JS_ENABLE_PTHREADS
+#include <clp_ffi_js/ir/PipelinedZstdReader.hpp>
+#endif
+#include <clp_ffi_js/ir/Snapshot.hpp>
 #include <clp_ffi_js/ir/StructuredIrStreamReader.hpp>
 #include <clp_ffi_js/ir/UnstructuredIrStreamReader.hpp>
+#include <clp_ffi_js/ir/ZstdFileReader.hpp>
 
 namespace {
 using ClpFfiJsException = clp_ffi_js::ClpFfiJsException;
 using DataArrayTsType = clp_ffi_js::DataArrayTsType;
+using clp_ffi_js::copy_data_array;
+using clp_ffi_js::from_js_size;
+using clp_ffi_js::get_data_array_length;
+using clp_ffi_js::js_size_t;
+using clp_ffi_js::to_js_size;
+using clp_ffi_js::ir::ChunkedZstdReader;
+using clp_ffi_js::ir::DeserializeNextOptionsTsType;
+using clp_ffi_js::ir::ExportOptionsTsType;
+using clp_ffi_js::ir::ReaderOptions;
+using clp_ffi_js::ir::SnapshotReader;
+using clp_ffi_js::ir::SnapshotWriter;
+using clp_ffi_js::ir::StreamReader;
+using clp_ffi_js::ir::StreamType;
+using clp_ffi_js::ir::throw_corrupt_snapshot;
+
+// "CLPS" in little-endian byte order.
+constexpr uint32_t cSnapshotMagicNumber{0x5350'4c43};
+constexpr uint16_t cSnapshotFormatVersion{1};
+
+// Checkpoint interval of sidecar indexes built with reader options that don't specify one.
+constexpr size_t cDefaultIndexCheckpointInterval{10'000};
+constexpr mode_t cIndexFileMode{0644};
+
+constexpr std::string_view cReaderOptionsCheckpointIntervalKey{"checkpointInterval"};
+constexpr std::string_view cReaderOptionsIndexKey{"index"};
+constexpr std::string_view cDeserializeNextOptionsMaxEventsKey{"maxEvents"};
+constexpr std::string_view cDeserializeNextOptionsMaxBytesKey{"maxBytes"};
+constexpr std::string_view cExportOptionsChunkSizeKey{"chunkSize"};
+constexpr std::string_view cExportOptionsFormatTimestampsKey{"formatTimestamps"};
+
+constexpr size_t cDefaultExportChunkSize{1024UL * 1024};
 
 // Function declarations
 /**
@@ -39,6 +94,94 @@ using DataArrayTsType = clp_ffi_js::DataArrayTsType;
  */
 auto get_version(clp::ReaderInterface& reader) -> std::string;
 
+/**
+ * @param reader
+ * @return Whether the reader contains the IR stream's entire preamble (encoding type and
+ * metadata). Errors other than incomplete data are left for the callers' validation to report.
+ */
+[[nodiscard]] auto is_preamble_complete(clp::ReaderInterface& reader) -> bool;
+
+/**
+ * @param options
+ * @param key
+ * @return The limit with the given key in `options`, or the maximum `size_t` value if it's null or
+ * undefined.
+ * @throw ClpFfiJsException if the limit isn't positive.
+ */
+[[nodiscard]] auto
+get_deserialization_limit(DeserializeNextOptionsTsType const& options, std::string_view key)
+        -> size_t;
+
+/**
+ * @param options
+ * @return The chunk size in `options`, or `cDefaultExportChunkSize` if it's null or undefined.
+ * @throw ClpFfiJsException if the chunk size isn't positive.
+ */
+[[nodiscard]] auto get_export_chunk_size(ExportOptionsTsType const& options) -> size_t;
+
+/**
+ * Appends a JavaScript array to a `ChunkedZstdReader`'s compressed input.
+ * @param chunked_reader
+ * @param data_array
+ */
+auto append_data_array(ChunkedZstdReader& chunked_reader, DataArrayTsType const& data_array)
+        -> void;
+
+/**
+ * Reads a snapshot's header, and validates that the snapshot was serialized from the given stream.
+ * @param snapshot_reader
+ * @param compressed_data
+ * @return The type of the stream the snapshot was serialized from.
+ * @throw ClpFfiJsException if the header is invalid or the snapshot was serialized from a different
+ * stream.
+ */
+[[nodiscard]] auto
+read_snapshot_header(SnapshotReader& snapshot_reader, std::span<char const> compressed_data)
+        -> StreamType;
+
+/**
+ * @param reader_options
+ * @return Whether the reader options contain a sidecar index.
+ */
+[[nodiscard]] auto has_index(ReaderOptions const& reader_options) -> bool;
+
+/**
+ * Writes data to a file, replacing the file's contents if it exists.
+ * @param path
+ * @param data
+ * @throw ClpFfiJsException if the file couldn't be opened or written.
+ */
+auto write_file(std::string const& path, std::span<char const> data) -> void;
+
+/**
+ * Validates the IR stream's version and creates the type of stream reader for it.
+ * @tparam CreateStructuredFunc
+ * @tparam CreateUnstructuredFunc
+ * @param reader A reader for the decompressed IR stream.
+ * @param create_structured Function that creates a `StructuredIrStreamReader`.
+ * @param create_unstructured Function that creates an `UnstructuredIrStreamReader`.
+ * @return The created instance.
+ * @throw ClpFfiJsException if the version is unsupported or any error occurs.
+ */
+template <typename CreateStructuredFunc, typename CreateUnstructuredFunc>
+[[nodiscard]] auto create_reader_for_version(
+        clp::ReaderInterface& reader,
+        CreateStructuredFunc create_structured,
+        CreateUnstructuredFunc create_unstructured
+) -> std::unique_ptr<StreamReader>;
+
+/**
+ * Creates the type of stream reader for the IR stream read by `chunked_reader`.
+ * @param chunked_reader
+ * @param reader_options
+ * @return The created instance.
+ * @throw ClpFfiJsException if the version is unsupported or any error occurs.
+ */
+[[nodiscard]] auto create_from_chunked_reader(
+        std::unique_ptr<ChunkedZstdReader>&& chunked_reader,
+        ReaderOptions const& reader_options
+) -> std::unique_ptr<StreamReader>;
+
 auto get_version(clp::ReaderInterface& reader) -> std::string {
     std::string version;
     try {
@@ -57,13 +200,220 @@ auto get_version(clp::ReaderInterface& reader) -> std::string {
     return version;
 }
 
+auto is_preamble_complete(clp::ReaderInterface& reader) -> bool {
+    reader.seek_from_begin(0);
+
+    bool is_four_bytes_encoding{true};
+    if (clp::ffi::ir_stream::IRErrorCode_Incomplete_IR
+        == clp::ffi::ir_stream::get_encoding_type(reader, is_four_bytes_encoding))
+    {
+        return false;
+    }
+
+    clp::ffi::ir_stream::encoded_tag_t metadata_type{};
+    std::vector<int8_t> metadata_bytes;
+    return clp::ffi::ir_stream::IRErrorCode_Incomplete_IR
+           != clp::ffi::ir_stream::deserialize_preamble(reader, metadata_type, metadata_bytes);
+}
+
+auto get_deserialization_limit(DeserializeNextOptionsTsType const& options, std::string_view key)
+        -> size_t {
+    auto const limit{options[key.data()]};
+    if (limit.isNull() || limit.isUndefined()) {
+        return std::numeric_limits<size_t>::max();
+    }
+    if (limit.as<double>() < 1) {
+        throw ClpFfiJsException{
+                clp::ErrorCode::ErrorCode_BadParam,
+                __FILENAME__,
+                __LINE__,
+                std::format("`{}` must be positive.", key)
+        };
+    }
+    return from_js_size(limit.as<js_size_t>());
+}
+
+auto get_export_chunk_size(ExportOptionsTsType const& options) -> size_t {
+    auto const chunk_size{options[cExportOptionsChunkSizeKey.data()]};
+    if (chunk_size.isNull() || chunk_size.isUndefined()) {
+        return cDefaultExportChunkSize;
+    }
+    if (chunk_size.as<double>() < 1) {
+        throw ClpFfiJsException{
+                clp::ErrorCode::ErrorCode_BadParam,
+                __FILENAME__,
+                __LINE__,
+                "The chunk size must be positive."
+        };
+    }
+    return from_js_size(chunk_size.as<js_size_t>());
+}
+
+auto append_data_array(ChunkedZstdReader& chunked_reader, DataArrayTsType const& data_array)
+        -> void {
+    auto const length{get_data_array_length(data_array)};
+    copy_data_array(data_array, {chunked_reader.grow_compressed_input(length), length});
+}
+
+auto read_snapshot_header(SnapshotReader& snapshot_reader, std::span<char const> compressed_data)
+        -> StreamType {
+    if (snapshot_reader.read<uint32_t>() != cSnapshotMagicNumber) {
+        throw_corrupt_snapshot("The data isn't a snapshot.");
+    }
+    if (auto const version{snapshot_reader.read<uint16_t>()}; version != cSnapshotFormatVersion) {
+        throw ClpFfiJsException{
+                clp::ErrorCode::ErrorCode_Unsupported,
+                __FILENAME__,
+                __LINE__,
+                std::format("Unsupported snapshot format version: {}", version)
+        };
+    }
+    auto const stream_type{static_cast<StreamType>(snapshot_reader.read<uint8_t>())};
+    if (StreamType::Structured != stream_type && StreamType::Unstructured != stream_type) {
+        throw_corrupt_snapshot("The snapshot's stream type is invalid.");
+    }
+
+    auto const source_size{snapshot_reader.read_size()};
+    auto const source_hash{snapshot_reader.read<uint64_t>()};
+    if (source_size != compressed_data.size()
+        || source_hash != clp_ffi_js::ir::hash_snapshot_source(compressed_data))
+    {
+        throw ClpFfiJsException{
+                clp::ErrorCode::ErrorCode_BadParam,
+                __FILENAME__,
+                __LINE__,
+                "The snapshot wasn't serialized from the given stream."
+        };
+    }
+    return stream_type;
+}
+
+auto has_index(ReaderOptions const& reader_options) -> bool {
+    auto const index{reader_options[cReaderOptionsIndexKey.data()]};
+    return false == index.isNull() && false == index.isUndefined();
+}
+
+auto write_file(std::string const& path, std::span<char const> data) -> void {
+    auto const throw_errno = [&](std::string_view operation, int error) {
+        throw ClpFfiJsException{
+                clp::ErrorCode::ErrorCode_errno,
+                __FILENAME__,
+                __LINE__,
+                std::format(
+                        "Failed to {} {}: {}",
+                        operation,
+                        path,
+                        std::generic_category().message(error)
+                )
+        };
+    };
+
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg)
+    auto const fd{::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, cIndexFileMode)};
+    if (-1 == fd) {
+        throw_errno("open", errno);
+    }
+    size_t num_bytes_written{0};
+    while (num_bytes_written < data.size()) {
+        auto const remaining{data.subspan(num_bytes_written)};
+        auto const result{::write(fd, remaining.data(), remaining.size())};
+        if (-1 == result) {
+            auto const error{errno};
+            if (EINTR == error) {
+                continue;
+            }
+            ::close(fd);
+            throw_errno("write", error);
+        }
+        num_bytes_written += static_cast<size_t>(result);
+    }
+    if (0 != ::close(fd)) {
+        throw_errno("close", errno);
+    }
+}
+
+template <typename CreateStructuredFunc, typename CreateUnstructuredFunc>
+auto create_reader_for_version(
+        clp::ReaderInterface& reader,
+        CreateStructuredFunc create_structured,
+        CreateUnstructuredFunc create_unstructured
+) -> std::unique_ptr<StreamReader> {
+    clp_ffi_js::ir::rewind_reader_and_validate_encoding_type(reader);
+
+    // Validate the stream's version and decide which type of IR stream reader to create.
+    auto const version{get_version(reader)};
+    reader.seek_from_begin(0);
+    try {
+        auto const version_validation_result{
+                clp::ffi::ir_stream::validate_protocol_version(version)
+        };
+        if (clp::ffi::ir_stream::IRProtocolErrorCode::Supported == version_validation_result) {
+            return create_structured();
+        }
+        if (clp::ffi::ir_stream::IRProtocolErrorCode::BackwardCompatible
+            == version_validation_result)
+        {
+            return create_unstructured();
+        }
+    } catch (StreamReader::ZstdDecompressor::OperationFailed const& e) {
+        throw ClpFfiJsException{
+                clp::ErrorCode::ErrorCode_Failure,
+                __FILENAME__,
+                __LINE__,
+                std::format("Unable to rewind zstd decompressor: {}", e.what())
+        };
+    }
+
+    throw ClpFfiJsException{
+            clp::ErrorCode::ErrorCode_Unsupported,
+            __FILENAME__,
+            __LINE__,
+            std::format("Unable to create reader for IR stream with version {}.", version)
+    };
+}
+
+auto create_from_chunked_reader(
+        std::unique_ptr<ChunkedZstdReader>&& chunked_reader,
+        ReaderOptions const& reader_options
+) -> std::unique_ptr<StreamReader> {
+    auto& reader{*chunked_reader};
+    return create_reader_for_version(
+            reader,
+            [&]() -> std::unique_ptr<StreamReader> {
+                return std::make_unique<clp_ffi_js::ir::StructuredIrStreamReader>(
+                        clp_ffi_js::ir::StructuredIrStreamReader::create(
+                                std::move(chunked_reader),
+                                reader_options
+                        )
+                );
+            },
+            [&]() -> std::unique_ptr<StreamReader> {
+                return std::make_unique<clp_ffi_js::ir::UnstructuredIrStreamReader>(
+                        clp_ffi_js::ir::UnstructuredIrStreamReader::create(
+                                std::move(chunked_reader),
+                                reader_options
+                        )
+                );
+            }
+    );
+}
+
 EMSCRIPTEN_BINDINGS(ClpStreamReader) {
     // JS types used as inputs
+    emscripten::register_type<clp_ffi_js::ir::DeserializeNextOptionsTsType>(
+            "{maxEvents?: number | null, maxBytes?: number | null}"
+    );
+    emscripten::register_type<clp_ffi_js::ir::ExportOptionsTsType>(
+            "{chunkSize?: number | null, formatTimestamps?: boolean | null}"
+    );
     emscripten::register_type<clp_ffi_js::ir::LogLevelFilterTsType>("number[] | null");
     emscripten::register_type<clp_ffi_js::ir::ReaderOptions>(
             "{logLevelKey: {isAutoGenerated: boolean; parts: string[];} | null,"
             " timestampKey: {isAutoGenerated: boolean; parts: string[];} | null,"
-            " utcOffsetKey: {isAutoGenerated: boolean; parts: string[];} | null}"
+            " utcOffsetKey: {isAutoGenerated: boolean; parts: string[];} | null,"
+            " checkpointInterval?: number | null,"
+            " index?: Uint8Array | null,"
+            " projectionKeys?: {isAutoGenerated: boolean; parts: string[];}[] | null}"
     );
 
     // JS types used as outputs
@@ -71,23 +421,84 @@ EMSCRIPTEN_BINDINGS(ClpStreamReader) {
     emscripten::enum_<clp_ffi_js::ir::StreamType>("IrStreamType")
             .value("STRUCTURED", clp_ffi_js::ir::StreamType::Structured)
             .value("UNSTRUCTURED", clp_ffi_js::ir::StreamType::Unstructured);
+    emscripten::register_type<clp_ffi_js::ir::DecodedMessageCacheStatsTsType>(
+            "{numHits: number, numMisses: number, numEntries: number, numBytes: number, "
+            "capacity: number}"
+    );
+    emscripten::register_type<clp_ffi_js::ir::DecodedResultsBinaryTsType>(
+            "{logEventNums: Uint32Array, logLevels: Uint8Array, timestamps: BigInt64Array, "
+            "utcOffsets: Int16Array, messages: Uint8Array, messageOffsets: Uint32Array} | null"
+    );
     emscripten::register_type<clp_ffi_js::ir::DecodedResultsTsType>(
             "Array<{logEventNum: number, logLevel: number, message: string, timestamp: bigint, "
             "utcOffset: bigint}> | null"
     );
+    emscripten::register_type<clp_ffi_js::ir::DeserializationProgressTsType>(
+            "{numBytesConsumed: number, numEventsBuffered: number, isDone: boolean}"
+    );
+    emscripten::register_type<clp_ffi_js::ir::ExportedChunkTsType>(
+            "{data: Uint8Array, nextIdx: number, isDone: boolean} | null"
+    );
     emscripten::register_type<clp_ffi_js::ir::FilteredLogEventMapTsType>("number[] | null");
+    emscripten::register_type<clp_ffi_js::ir::LogLevelCountsTsType>("number[]");
+    emscripten::register_type<clp_ffi_js::ir::FilterDataColumnsTsType>(
+            "{logLevels: Uint8Array, timestamps: BigInt64Array, utcOffsets: Int16Array}"
+    );
     emscripten::register_type<clp_ffi_js::ir::NullableLogEventIdx>("number | null");
+    emscripten::register_type<clp_ffi_js::ir::SnapshotTsType>("Uint8Array");
+    emscripten::register_type<clp_ffi_js::ir::TimeHistogramTsType>("Uint32Array | null");
     emscripten::class_<clp_ffi_js::ir::StreamReader>("ClpStreamReader")
             .constructor(
                     &clp_ffi_js::ir::StreamReader::create,
                     emscripten::return_value_policy::take_ownership()
             )
+            .class_function(
+                    "createFromInputBuffer",
+                    &clp_ffi_js::ir::StreamReader::create_from_input_buffer,
+                    emscripten::return_value_policy::take_ownership()
+            )
+            .class_function(
+                    "createStreaming",
+                    &clp_ffi_js::ir::StreamReader::create_streaming,
+                    emscripten::return_value_policy::take_ownership()
+            )
+            .class_function(
+                    "createFromSnapshot",
+                    &clp_ffi_js::ir::StreamReader::create_from_snapshot,
+                    emscripten::return_value_policy::take_ownership()
+            )
+#ifdef CLP_FFI_JS_ENVIRONMENT_NODE
+            .class_function(
+                    "createFromFile",
+                    &clp_ffi_js::ir::StreamReader::create_from_file,
+                    emscripten::return_value_policy::take_ownership()
+            )
+            .class_function(
+                    "buildIndexFile",
+                    emscripten::optional_override([](std::string const& stream_path,
+                                                     std::string const& index_path,
+                                                     ReaderOptions const& reader_options) {
+                        return to_js_size(StreamReader::build_index_file(
+                                stream_path,
+                                index_path,
+                                reader_options
+                        ));
+                    })
+            )
+#endif
             .function("getMetadata", &clp_ffi_js::ir::StreamReader::get_metadata)
             .function("getIrStreamType", &clp_ffi_js::ir::StreamReader::get_ir_stream_type)
             .function(
                     "getNumEventsBuffered",
-                    &clp_ffi_js::ir::StreamReader::get_num_events_buffered
+                    emscripten::optional_override([](StreamReader const& self) {
+                        return to_js_size(self.get_num_events_buffered());
+                    })
             )
+            .function(
+                    "getFilterDataColumns",
+                    &clp_ffi_js::ir::StreamReader::get_filter_data_columns
+            )
+            .function("getLogLevelCounts", &clp_ffi_js::ir::StreamReader::get_log_level_counts)
             .function(
                     "getFilteredLogEventMap",
                     &clp_ffi_js::ir::StreamReader::get_filtered_log_event_map
@@ -104,8 +515,80 @@ EMSCRIPTEN_BINDINGS(ClpStreamReader) {
                             void(clp_ffi_js::ir::LogLevelFilterTsType const&, std::string const&)
                     >(&clp_ffi_js::ir::StreamReader::filter_log_events)
             )
-            .function("deserializeStream", &clp_ffi_js::ir::StreamReader::deserialize_stream)
-            .function("decodeRange", &clp_ffi_js::ir::StreamReader::decode_range)
+            .function("appendData", &clp_ffi_js::ir::StreamReader::append_data)
+            .function("markEndOfInput", &clp_ffi_js::ir::StreamReader::mark_end_of_input)
+            .function(
+                    "deserializeStream",
+                    emscripten::optional_override([](StreamReader& self) {
+                        return to_js_size(self.deserialize_stream());
+                    })
+            )
+            .function("deserializeNext", &clp_ffi_js::ir::StreamReader::deserialize_next)
+            .function(
+                    "decodeRange",
+                    emscripten::optional_override([](StreamReader const& self,
+                                                     js_size_t begin_idx,
+                                                     js_size_t end_idx,
+                                                     bool use_filter) {
+                        return self.decode_range(
+                                from_js_size(begin_idx),
+                                from_js_size(end_idx),
+                                use_filter
+                        );
+                    })
+            )
+            .function(
+                    "decodeRangeBinary",
+                    emscripten::optional_override([](StreamReader const& self,
+                                                     js_size_t begin_idx,
+                                                     js_size_t end_idx,
+                                                     bool use_filter) {
+                        return self.decode_range_binary(
+                                from_js_size(begin_idx),
+                                from_js_size(end_idx),
+                                use_filter
+                        );
+                    })
+            )
+            .function(
+                    "getTimeHistogram",
+                    emscripten::optional_override([](StreamReader const& self,
+                                                     clp::ir::epoch_time_ms_t begin_ts,
+                                                     clp::ir::epoch_time_ms_t end_ts,
+                                                     js_size_t num_buckets,
+                                                     bool use_filter,
+                                                     bool split_by_log_level) {
+                        return self.get_time_histogram(
+                                begin_ts,
+                                end_ts,
+                                from_js_size(num_buckets),
+                                use_filter,
+                                split_by_log_level
+                        );
+                    })
+            )
+            .function("serializeSnapshot", &clp_ffi_js::ir::StreamReader::serialize_snapshot)
+            .function(
+                    "exportChunk",
+                    emscripten::optional_override([](StreamReader const& self,
+                                                     js_size_t begin_idx,
+                                                     bool use_filter,
+                                                     ExportOptionsTsType const& options) {
+                        return self.export_chunk(from_js_size(begin_idx), use_filter, options);
+                    })
+            )
+            .function(
+                    "getDecodedMessageCacheStats",
+                    &clp_ffi_js::ir::StreamReader::get_decoded_message_cache_stats
+            )
+            .function(
+                    "setDecodedMessageCacheCapacity",
+                    emscripten::optional_override([](StreamReader& self, js_size_t capacity) {
+                        self.set_decoded_message_cache_capacity(from_js_size(capacity));
+                    })
+            )
+            .function("setFormatTemplate", &clp_ffi_js::ir::StreamReader::set_format_template)
+            .function("isChronological", &clp_ffi_js::ir::StreamReader::is_chronological)
             .function(
                     "findNearestLogEventByTimestamp",
                     &clp_ffi_js::ir::StreamReader::find_nearest_log_event_by_timestamp
@@ -116,57 +599,612 @@ EMSCRIPTEN_BINDINGS(ClpStreamReader) {
 namespace clp_ffi_js::ir {
 auto StreamReader::create(DataArrayTsType const& data_array, ReaderOptions const& reader_options)
         -> std::unique_ptr<StreamReader> {
-    auto const length{data_array["length"].as<size_t>()};
+    auto const length{get_data_array_length(data_array)};
     SPDLOG_INFO("StreamReader::create: got buffer of length={}", length);
 
     // Copy array from JavaScript to C++.
-    ystdlib::containers::Array<char> data_buffer(length);
-    // NOLINTBEGIN(cppcoreguidelines-pro-type-reinterpret-cast)
-    emscripten::val::module_property("HEAPU8")
-            .call<void>("set", data_array, reinterpret_cast<uintptr_t>(data_buffer.data()));
-    // NOLINTEND(cppcoreguidelines-pro-type-reinterpret-cast)
+    std::vector<char> data_buffer(length);
+    copy_data_array(data_array, data_buffer);
+
+    return create_from_data_buffer(std::move(data_buffer), reader_options);
+}
 
+auto StreamReader::create_from_input_buffer(
+        InputBuffer& input_buffer,
+        ReaderOptions const& reader_options
+) -> std::unique_ptr<StreamReader> {
+    SPDLOG_INFO(
+            "StreamReader::create_from_input_buffer: got buffer of length={}",
+            input_buffer.get_size()
+    );
+    return create_from_data_buffer(input_buffer.release(), reader_options);
+}
+
+auto StreamReader::create_from_file(std::string const& path, ReaderOptions const& reader_options)
+        -> std::unique_ptr<StreamReader> {
+    SPDLOG_INFO("StreamReader::create_from_file: got path={}", path);
+
+    if (get_checkpoint_interval(reader_options).has_value() || has_index(reader_options)) {
+        // Windowed mode (which readers restored from an index are in) re-decodes log events from
+        // the compressed stream, so it needs all of it.
+        return create_from_data_buffer(FileDescriptorReader::read_file(path), reader_options);
+    }
+
+    std::unique_ptr<clp::ReaderInterface> reader{std::make_unique<ZstdFileReader>(path)};
+    return create_reader_for_version(
+            *reader,
+            [&]() -> std::unique_ptr<StreamReader> {
+                return std::make_unique<StructuredIrStreamReader>(
+                        StructuredIrStreamReader::create(std::move(reader), {}, reader_options)
+                );
+            },
+            [&]() -> std::unique_ptr<StreamReader> {
+                return std::make_unique<UnstructuredIrStreamReader>(
+                        UnstructuredIrStreamReader::create(std::move(reader), {})
+                );
+            }
+    );
+}
+
+auto StreamReader::create_from_data_buffer(
+        std::vector<char>&& data_buffer,
+        ReaderOptions const& reader_options
+) -> std::unique_ptr<StreamReader> {
+    if (has_index(reader_options)) {
+        auto const index{reader_options[cReaderOptionsIndexKey.data()]};
+        std::vector<char> index_buffer(get_data_array_length(DataArrayTsType{index}));
+        copy_data_array(DataArrayTsType{index}, index_buffer);
+        SPDLOG_INFO(
+                "StreamReader::create_from_data_buffer: got index of length={}",
+                index_buffer.size()
+        );
+        return create_from_snapshot_buffer(std::move(data_buffer), index_buffer, reader_options);
+    }
+
+    if (get_checkpoint_interval(reader_options).has_value()) {
+        // Windowed mode re-decodes log events from the compressed stream, which the chunked reader
+        // retains along with the IR units it replays from checkpoints.
+        auto chunked_reader{std::make_unique<ChunkedZstdReader>(std::move(data_buffer))};
+        chunked_reader->mark_end_of_input();
+        return create_from_chunked_reader(std::move(chunked_reader), reader_options);
+    }
+
+#ifdef CLP_FFI_JS_ENABLE_PTHREADS
+    // Decompress on a separate thread, overlapping decompression with deserialization, unless every
+    // preallocated worker is in use (see `PipelinedZstdReader`).
+    // NOTE: Moving `data_buffer` into the reader's data context doesn't move the bytes it holds.
+    std::unique_ptr<clp::ReaderInterface> reader{std::make_unique<PipelinedZstdReader>(
+            std::span<char const>{data_buffer.data(), data_buffer.size()}
+    )};
+#else
     auto zstd_decompressor{std::make_unique<ZstdDecompressor>()};
-    zstd_decompressor->open(data_buffer.data(), length);
+    zstd_decompressor->open(data_buffer.data(), data_buffer.size());
+    std::unique_ptr<clp::ReaderInterface> reader{std::move(zstd_decompressor)};
+#endif
 
-    rewind_reader_and_validate_encoding_type(*zstd_decompressor);
+    return create_reader_for_version(
+            *reader,
+            [&]() -> std::unique_ptr<StreamReader> {
+                return std::make_unique<StructuredIrStreamReader>(StructuredIrStreamReader::create(
+                        std::move(reader),
+                        std::move(data_buffer),
+                        reader_options
+                ));
+            },
+            [&]() -> std::unique_ptr<StreamReader> {
+                return std::make_unique<UnstructuredIrStreamReader>(
+                        UnstructuredIrStreamReader::create(
+                                std::move(reader),
+                                std::move(data_buffer)
+                        )
+                );
+            }
+    );
+}
 
-    // Validate the stream's version and decide which type of IR stream reader to create.
-    auto const version{get_version(*zstd_decompressor)};
-    zstd_decompressor->seek_from_begin(0);
-    try {
-        auto const version_validation_result{
-                clp::ffi::ir_stream::validate_protocol_version(version)
+auto StreamReader::create_streaming(
+        DataArrayTsType const& initial_chunk,
+        ReaderOptions const& reader_options
+) -> std::unique_ptr<StreamReader> {
+    if (has_index(reader_options)) {
+        throw ClpFfiJsException{
+                clp::ErrorCode::ErrorCode_Unsupported,
+                __FILENAME__,
+                __LINE__,
+                "Readers in streaming mode can't be created from an index."
         };
-        if (clp::ffi::ir_stream::IRProtocolErrorCode::Supported == version_validation_result) {
-            return std::make_unique<StructuredIrStreamReader>(StructuredIrStreamReader::create(
-                    std::move(zstd_decompressor),
-                    std::move(data_buffer),
-                    reader_options
-            ));
+    }
+
+    auto chunked_reader{std::make_unique<ChunkedZstdReader>()};
+    append_data_array(*chunked_reader, initial_chunk);
+    SPDLOG_INFO(
+            "StreamReader::create_streaming: got initial chunk of length={}",
+            chunked_reader->get_compressed_data().size()
+    );
+
+    if (false == is_preamble_complete(*chunked_reader)) {
+        throw ClpFfiJsException{
+                clp::ErrorCode::ErrorCode_Truncated,
+                __FILENAME__,
+                __LINE__,
+                "The initial chunk doesn't contain the IR stream's entire preamble."
+        };
+    }
+
+    return create_from_chunked_reader(std::move(chunked_reader), reader_options);
+}
+
+auto StreamReader::create_from_snapshot(
+        DataArrayTsType const& data_array,
+        DataArrayTsType const& snapshot,
+        ReaderOptions const& reader_options
+) -> std::unique_ptr<StreamReader> {
+    std::vector<char> data_buffer(get_data_array_length(data_array));
+    copy_data_array(data_array, data_buffer);
+    std::vector<char> snapshot_buffer(get_data_array_length(snapshot));
+    copy_data_array(snapshot, snapshot_buffer);
+    SPDLOG_INFO(
+            "StreamReader::create_from_snapshot: got buffer of length={} and snapshot of length={}",
+            data_buffer.size(),
+            snapshot_buffer.size()
+    );
+    return create_from_snapshot_buffer(std::move(data_buffer), snapshot_buffer, reader_options);
+}
+
+auto StreamReader::build_index_file(
+        std::string const& stream_path,
+        std::string const& index_path,
+        ReaderOptions const& reader_options
+) -> size_t {
+    SPDLOG_INFO(
+            "StreamReader::build_index_file: got stream_path={}, index_path={}",
+            stream_path,
+            index_path
+    );
+
+    // An index is the snapshot of a reader in windowed mode, so default the checkpoint interval.
+    auto options{emscripten::val::global("Object").call<emscripten::val>(
+            "assign",
+            emscripten::val::object(),
+            reader_options
+    )};
+    if (false == get_checkpoint_interval(reader_options).has_value()) {
+        options.set(
+                cReaderOptionsCheckpointIntervalKey.data(),
+                to_js_size(cDefaultIndexCheckpointInterval)
+        );
+    }
+    options.delete_(cReaderOptionsIndexKey.data());
+
+    auto const stream_reader{create_from_file(stream_path, ReaderOptions{options})};
+    auto const num_events{stream_reader->deserialize_stream()};
+    SnapshotWriter writer;
+    stream_reader->write_snapshot(writer);
+    write_file(index_path, writer.get_buffer());
+    return num_events;
+}
+
+auto StreamReader::create_from_snapshot_buffer(
+        std::vector<char>&& data_buffer,
+        std::span<char const> snapshot,
+        ReaderOptions const& reader_options
+) -> std::unique_ptr<StreamReader> {
+    SnapshotReader snapshot_reader{snapshot};
+    auto const stream_type{read_snapshot_header(snapshot_reader, data_buffer)};
+
+    // Log events are decoded on demand from the compressed stream, as in windowed mode.
+    auto chunked_reader{std::make_unique<ChunkedZstdReader>(std::move(data_buffer))};
+    chunked_reader->mark_end_of_input();
+    std::unique_ptr<StreamReader> stream_reader;
+    if (StreamType::Structured == stream_type) {
+        stream_reader = std::make_unique<StructuredIrStreamReader>(
+                StructuredIrStreamReader::create_from_snapshot(
+                        std::move(chunked_reader),
+                        snapshot_reader,
+                        reader_options
+                )
+        );
+    } else {
+        stream_reader = std::make_unique<UnstructuredIrStreamReader>(
+                UnstructuredIrStreamReader::create_from_snapshot(
+                        std::move(chunked_reader),
+                        snapshot_reader
+                )
+        );
+    }
+    if (0 != snapshot_reader.get_num_bytes_remaining()) {
+        throw_corrupt_snapshot("The snapshot has trailing data.");
+    }
+    return stream_reader;
+}
+
+auto StreamReader::serialize_snapshot() const -> SnapshotTsType {
+    SnapshotWriter writer;
+    write_snapshot(writer);
+    auto const buffer{writer.get_buffer()};
+    // Constructing a typed array from another typed array copies its elements, so the result
+    // remains valid after `writer` is freed.
+    // NOLINTBEGIN(cppcoreguidelines-pro-type-reinterpret-cast)
+    auto snapshot{emscripten::val::global("Uint8Array")
+                          .new_(emscripten::typed_memory_view(
+                                  buffer.size(),
+                                  reinterpret_cast<uint8_t const*>(buffer.data())
+                          ))};
+    // NOLINTEND(cppcoreguidelines-pro-type-reinterpret-cast)
+    return SnapshotTsType{snapshot};
+}
+
+auto StreamReader::write_snapshot_header(
+        SnapshotWriter& writer,
+        std::span<char const> compressed_data
+) const -> void {
+    writer.write(cSnapshotMagicNumber);
+    writer.write(cSnapshotFormatVersion);
+    writer.write(clp::enum_to_underlying_type(get_ir_stream_type()));
+    writer.write_size(compressed_data.size());
+    writer.write(hash_snapshot_source(compressed_data));
+}
+
+auto StreamReader::export_chunk(
+        size_t begin_idx,
+        bool use_filter,
+        ExportOptionsTsType const& options
+) const -> ExportedChunkTsType {
+    auto const& filtered_log_event_map{get_filtered_log_event_indices()};
+    if (use_filter && false == filtered_log_event_map.has_value()) {
+        return ExportedChunkTsType{emscripten::val::null()};
+    }
+    auto const& filter_columns{get_filter_columns()};
+    size_t const length{use_filter ? filtered_log_event_map->size() : filter_columns.size()};
+    if (begin_idx > length) {
+        SPDLOG_ERROR("Invalid export index: {}", begin_idx);
+        return ExportedChunkTsType{emscripten::val::null()};
+    }
+
+    auto const chunk_size{get_export_chunk_size(options)};
+    auto const format_timestamps{options[cExportOptionsFormatTimestampsKey.data()].isTrue()};
+
+    std::string chunk;
+    chunk.reserve(std::min(chunk_size, cDefaultExportChunkSize));
+    std::string timestamp;
+    auto idx{begin_idx};
+    for (; idx < length; ++idx) {
+        if (chunk.size() >= chunk_size) {
+            // End the chunk with the line that reached its size, rather than decoding a line that
+            // doesn't fit only to drop it and decode it again for the next chunk.
+            break;
         }
-        if (clp::ffi::ir_stream::IRProtocolErrorCode::BackwardCompatible
-            == version_validation_result)
-        {
-            return std::make_unique<UnstructuredIrStreamReader>(UnstructuredIrStreamReader::create(
-                    std::move(zstd_decompressor),
-                    std::move(data_buffer)
-            ));
+        auto const log_event_idx{use_filter ? filtered_log_event_map->at(idx) : idx};
+        auto const line_begin_pos{chunk.size()};
+        std::optional<std::string_view> optional_timestamp;
+        if (format_timestamps) {
+            timestamp.clear();
+            append_iso8601_timestamp(
+                    filter_columns.get_timestamp(log_event_idx),
+                    filter_columns.get_utc_offset(log_event_idx),
+                    timestamp
+            );
+            optional_timestamp = timestamp;
+        }
+        append_exported_line(log_event_idx, optional_timestamp, chunk);
+        // Unstructured messages usually end with a newline already.
+        if (chunk.size() == line_begin_pos || '\n' != chunk.back()) {
+            chunk.push_back('\n');
         }
-    } catch (ZstdDecompressor::OperationFailed const& e) {
+    }
+
+    auto result{emscripten::val::object()};
+    // Constructing a typed array from another typed array copies its elements, so the result
+    // remains valid after `chunk` is freed.
+    // NOLINTBEGIN(cppcoreguidelines-pro-type-reinterpret-cast)
+    result.set(
+            "data",
+            emscripten::val::global("Uint8Array")
+                    .new_(emscripten::typed_memory_view(
+                            chunk.size(),
+                            reinterpret_cast<uint8_t const*>(chunk.data())
+                    ))
+    );
+    // NOLINTEND(cppcoreguidelines-pro-type-reinterpret-cast)
+    result.set("nextIdx", to_js_size(idx));
+    result.set("isDone", idx == length);
+    return ExportedChunkTsType{result};
+}
+
+auto StreamReader::get_decoded_message_cache_stats() const -> DecodedMessageCacheStatsTsType {
+    auto stats{emscripten::val::object()};
+    stats.set("numHits", to_js_size(m_decoded_message_cache.get_num_hits()));
+    stats.set("numMisses", to_js_size(m_decoded_message_cache.get_num_misses()));
+    stats.set("numEntries", to_js_size(m_decoded_message_cache.get_num_entries()));
+    stats.set("numBytes", to_js_size(m_decoded_message_cache.get_num_bytes()));
+    stats.set("capacity", to_js_size(m_decoded_message_cache.get_capacity()));
+    return DecodedMessageCacheStatsTsType{stats};
+}
+
+auto StreamReader::get_filter_data_columns() const -> FilterDataColumnsTsType {
+    auto const& filter_columns{get_filter_columns()};
+    auto columns{emscripten::val::object()};
+    columns.set(
+            "logLevels",
+            emscripten::typed_memory_view(
+                    filter_columns.get_log_levels().size(),
+                    filter_columns.get_log_levels().data()
+            )
+    );
+    columns.set(
+            "timestamps",
+            emscripten::typed_memory_view(
+                    filter_columns.get_timestamps().size(),
+                    filter_columns.get_timestamps().data()
+            )
+    );
+    columns.set(
+            "utcOffsets",
+            emscripten::typed_memory_view(
+                    filter_columns.get_utc_offsets().size(),
+                    filter_columns.get_utc_offsets().data()
+            )
+    );
+    return FilterDataColumnsTsType{columns};
+}
+
+auto StreamReader::get_log_level_counts() const -> LogLevelCountsTsType {
+    auto const& filter_columns{get_filter_columns()};
+    auto counts{emscripten::val::array()};
+    for (auto log_level{clp::enum_to_underlying_type(LogLevel::NONE)};
+         log_level < clp::enum_to_underlying_type(LogLevel::LENGTH);
+         ++log_level)
+    {
+        counts.call<void>(
+                "push",
+                to_js_size(
+                        filter_columns.get_log_event_indices(static_cast<LogLevel>(log_level))
+                                .size()
+                )
+        );
+    }
+    return LogLevelCountsTsType{counts};
+}
+
+auto StreamReader::generic_get_time_histogram(
+        clp::ir::epoch_time_ms_t begin_ts,
+        clp::ir::epoch_time_ms_t end_ts,
+        size_t num_buckets,
+        FilteredLogEventsMap const& filtered_log_event_map,
+        LogEventFilterColumns const& filter_columns,
+        bool use_filter,
+        bool split_by_log_level
+) -> TimeHistogramTsType {
+    if (use_filter && false == filtered_log_event_map.has_value()) {
+        return TimeHistogramTsType{emscripten::val::null()};
+    }
+    if (0 == num_buckets || begin_ts >= end_ts) {
+        SPDLOG_ERROR(
+                "Invalid time histogram buckets: {} buckets over {}-{}",
+                num_buckets,
+                begin_ts,
+                end_ts
+        );
+        return TimeHistogramTsType{emscripten::val::null()};
+    }
+
+    // Compute in unsigned arithmetic so that the range can't overflow.
+    auto const range{static_cast<uint64_t>(end_ts) - static_cast<uint64_t>(begin_ts)};
+    auto const bucket_width{(range - 1) / num_buckets + 1};
+    size_t const num_counts_per_bucket{
+            split_by_log_level ? cLogLevelNames.size() : static_cast<size_t>(1)
+    };
+    std::vector<uint32_t> counts(num_buckets * num_counts_per_bucket, 0);
+
+    auto const timestamps{filter_columns.get_timestamps()};
+    auto const log_levels{filter_columns.get_log_levels()};
+    auto count_log_event = [&](size_t log_event_idx) {
+        auto const timestamp{timestamps[log_event_idx]};
+        if (timestamp < begin_ts || timestamp >= end_ts) {
+            return;
+        }
+        auto const bucket_idx{static_cast<size_t>(
+                (static_cast<uint64_t>(timestamp) - static_cast<uint64_t>(begin_ts)) / bucket_width
+        )};
+        auto count_idx{bucket_idx * num_counts_per_bucket};
+        if (split_by_log_level) {
+            count_idx += log_levels[log_event_idx];
+        }
+        ++counts[count_idx];
+    };
+
+    if (use_filter) {
+        for (auto const log_event_idx : filtered_log_event_map.value()) {
+            count_log_event(log_event_idx);
+        }
+    } else {
+        for (size_t log_event_idx{0}; log_event_idx < timestamps.size(); ++log_event_idx) {
+            count_log_event(log_event_idx);
+        }
+    }
+
+    // Constructing a typed array from another typed array copies its elements, so the result
+    // remains valid after `counts` is freed.
+    auto histogram{emscripten::val::global("Uint32Array")
+                           .new_(emscripten::typed_memory_view(counts.size(), counts.data()))};
+    return TimeHistogramTsType{histogram};
+}
+
+auto StreamReader::get_log_level_selection(LogLevelFilterTsType const& log_level_filter)
+        -> LogEventFilterColumns::LogLevelSelection {
+    LogEventFilterColumns::LogLevelSelection selection{};
+    for (auto const log_level :
+         emscripten::vecFromJSArray<LogEventFilterColumns::log_level_t>(log_level_filter))
+    {
+        if (log_level < selection.size()) {
+            selection.at(log_level) = true;
+        }
+    }
+    return selection;
+}
+
+auto StreamReader::create_log_event_filter(
+        LogLevelFilterTsType const& log_level_filter,
+        std::string kql_filter
+) -> std::optional<LogEventFilter> {
+    if (log_level_filter.isNull() && kql_filter.empty()) {
+        return std::nullopt;
+    }
+
+    LogEventFilter filter{.log_level_selection = std::nullopt, .query = std::move(kql_filter)};
+    if (false == log_level_filter.isNull()) {
+        filter.log_level_selection.emplace(get_log_level_selection(log_level_filter));
+    }
+    return filter;
+}
+
+auto StreamReader::generic_extend_filtered_log_events(
+        std::vector<size_t>& filtered_log_event_indices,
+        LogEventFilter const& filter,
+        LogEventFilterColumns const& filter_columns,
+        size_t begin_idx,
+        std::vector<size_t> const& query_matched_log_event_indices
+) -> void {
+    if (false == filter.log_level_selection.has_value()) {
+        filtered_log_event_indices.insert(
+                filtered_log_event_indices.end(),
+                query_matched_log_event_indices.cbegin(),
+                query_matched_log_event_indices.cend()
+        );
+        return;
+    }
+
+    auto const& selection{filter.log_level_selection.value()};
+    auto const is_selected = [&](size_t log_event_idx) {
+        return selection.at(
+                clp::enum_to_underlying_type(filter_columns.get_log_level(log_event_idx))
+        );
+    };
+    if (false == filter.query.empty()) {
+        auto const selected_positions{
+                collect_matching_indices(query_matched_log_event_indices.size(), [&]() {
+                    return [&](size_t position) {
+                        return is_selected(query_matched_log_event_indices[position]);
+                    };
+                })
+        };
+        filtered_log_event_indices.reserve(
+                filtered_log_event_indices.size() + selected_positions.size()
+        );
+        for (auto const position : selected_positions) {
+            filtered_log_event_indices.push_back(query_matched_log_event_indices[position]);
+        }
+        return;
+    }
+
+    if (0 == begin_idx) {
+        filtered_log_event_indices = filter_columns.get_log_event_indices(selection);
+        return;
+    }
+    // Scan only the new log events, rather than merging the selected levels' entire posting lists.
+    auto const selected_offsets{
+            collect_matching_indices(filter_columns.size() - begin_idx, [&]() {
+                return [&](size_t offset) { return is_selected(begin_idx + offset); };
+            })
+    };
+    filtered_log_event_indices.reserve(filtered_log_event_indices.size() + selected_offsets.size());
+    for (auto const offset : selected_offsets) {
+        filtered_log_event_indices.push_back(begin_idx + offset);
+    }
+}
+
+auto StreamReader::generic_find_nearest_log_event_by_timestamp(
+        LogEventFilterColumns const& filter_columns,
+        clp::ir::epoch_time_ms_t target_ts
+) -> NullableLogEventIdx {
+    auto const log_event_idx{filter_columns.find_nearest_log_event_by_timestamp(target_ts)};
+    if (false == log_event_idx.has_value()) {
+        return NullableLogEventIdx{emscripten::val::null()};
+    }
+    return NullableLogEventIdx{emscripten::val(to_js_size(log_event_idx.value()))};
+}
+
+auto StreamReader::get_checkpoint_interval(ReaderOptions const& reader_options)
+        -> std::optional<size_t> {
+    auto const checkpoint_interval{reader_options[cReaderOptionsCheckpointIntervalKey.data()]};
+    if (checkpoint_interval.isNull() || checkpoint_interval.isUndefined()) {
+        return std::nullopt;
+    }
+    if (checkpoint_interval.as<double>() < 1) {
         throw ClpFfiJsException{
-                clp::ErrorCode::ErrorCode_Failure,
+                clp::ErrorCode::ErrorCode_BadParam,
                 __FILENAME__,
                 __LINE__,
-                std::format("Unable to rewind zstd decompressor: {}", e.what())
+                "The checkpoint interval must be positive."
         };
     }
+    return from_js_size(checkpoint_interval.as<js_size_t>());
+}
 
-    throw ClpFfiJsException{
-            clp::ErrorCode::ErrorCode_Unsupported,
-            __FILENAME__,
-            __LINE__,
-            std::format("Unable to create reader for IR stream with version {}.", version)
+void StreamReader::append_data(DataArrayTsType const& chunk) {
+    auto* const chunked_reader{get_chunked_reader()};
+    if (nullptr == chunked_reader) {
+        throw ClpFfiJsException{
+                clp::ErrorCode::ErrorCode_Unsupported,
+                __FILENAME__,
+                __LINE__,
+                "The reader isn't in streaming mode or the stream has already been exhausted."
+        };
+    }
+    if (chunked_reader->is_end_of_input_marked()) {
+        throw ClpFfiJsException{
+                clp::ErrorCode::ErrorCode_Unsupported,
+                __FILENAME__,
+                __LINE__,
+                "Data can't be appended after the end of input has been marked."
+        };
+    }
+    append_data_array(*chunked_reader, chunk);
+}
+
+void StreamReader::mark_end_of_input() {
+    auto* const chunked_reader{get_chunked_reader()};
+    if (nullptr == chunked_reader) {
+        throw ClpFfiJsException{
+                clp::ErrorCode::ErrorCode_Unsupported,
+                __FILENAME__,
+                __LINE__,
+                "The reader isn't in streaming mode or the stream has already been exhausted."
+        };
+    }
+    chunked_reader->mark_end_of_input();
+}
+
+auto StreamReader::deserialize_stream() -> size_t {
+    std::ignore = deserialize_and_filter(
+            {.max_num_events = std::numeric_limits<size_t>::max(),
+             .max_num_bytes = std::numeric_limits<size_t>::max()}
+    );
+    return get_num_events_buffered();
+}
+
+auto StreamReader::deserialize_next(DeserializeNextOptionsTsType const& options)
+        -> DeserializationProgressTsType {
+    DeserializationBudget const budget{
+            .max_num_events
+            = get_deserialization_limit(options, cDeserializeNextOptionsMaxEventsKey),
+            .max_num_bytes = get_deserialization_limit(options, cDeserializeNextOptionsMaxBytesKey)
     };
+    auto const is_done{deserialize_and_filter(budget)};
+
+    auto progress{emscripten::val::object()};
+    progress.set("numBytesConsumed", to_js_size(get_num_bytes_consumed()));
+    progress.set("numEventsBuffered", to_js_size(get_num_events_buffered()));
+    progress.set("isDone", is_done);
+    return DeserializationProgressTsType{progress};
+}
+
+auto StreamReader::deserialize_and_filter(DeserializationBudget const& budget) -> bool {
+    auto const begin_num_events{get_num_events_buffered()};
+    auto const is_done{deserialize_within_budget(budget)};
+    if (get_num_events_buffered() > begin_num_events) {
+        extend_filtered_log_events(begin_num_events);
+    }
+    return is_done;
 }
 }  // namespace clp_ffi_js::ir
@@ -7,8 +7,11 @@
 #include <cstdint>
 #include <memory>
 #include <optional>
+#include <span>
 #include <string>
+#include <string_view>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
 #include <clp/ir/types.hpp>
@@ -22,33 +25,68 @@
 
 #include <clp_ffi_js/binding_types.hpp>
 #include <clp_ffi_js/constants.hpp>
-#include <clp_ffi_js/ir/LogEventWithFilterData.hpp>
+#include <clp_ffi_js/InputBuffer.hpp>
+#include <clp_ffi_js/ir/ChunkedZstdReader.hpp>
+#include <clp_ffi_js/ir/DecodedMessageCache.hpp>
+#include <clp_ffi_js/ir/DecodedResultsBinary.hpp>
+#include <clp_ffi_js/ir/LogEventFilterColumns.hpp>
+#include <clp_ffi_js/ir/LogEvents.hpp>
+#include <clp_ffi_js/ir/Snapshot.hpp>
 
 namespace clp_ffi_js::ir {
 // JS types used as inputs
+EMSCRIPTEN_DECLARE_VAL_TYPE(DeserializeNextOptionsTsType);
+EMSCRIPTEN_DECLARE_VAL_TYPE(ExportOptionsTsType);
 EMSCRIPTEN_DECLARE_VAL_TYPE(LogLevelFilterTsType);
 EMSCRIPTEN_DECLARE_VAL_TYPE(ReaderOptions);
 
 // JS types used as outputs
+EMSCRIPTEN_DECLARE_VAL_TYPE(DecodedMessageCacheStatsTsType);
+EMSCRIPTEN_DECLARE_VAL_TYPE(DecodedResultsBinaryTsType);
 EMSCRIPTEN_DECLARE_VAL_TYPE(DecodedResultsTsType);
+EMSCRIPTEN_DECLARE_VAL_TYPE(DeserializationProgressTsType);
+EMSCRIPTEN_DECLARE_VAL_TYPE(ExportedChunkTsType);
+EMSCRIPTEN_DECLARE_VAL_TYPE(FilterDataColumnsTsType);
 EMSCRIPTEN_DECLARE_VAL_TYPE(FilteredLogEventMapTsType);
+EMSCRIPTEN_DECLARE_VAL_TYPE(LogLevelCountsTsType);
 EMSCRIPTEN_DECLARE_VAL_TYPE(MetadataTsType);
 EMSCRIPTEN_DECLARE_VAL_TYPE(NullableLogEventIdx);
+EMSCRIPTEN_DECLARE_VAL_TYPE(SnapshotTsType);
+EMSCRIPTEN_DECLARE_VAL_TYPE(TimeHistogramTsType);
 
 enum class StreamType : uint8_t {
     Structured,
     Unstructured,
 };
 
-template <typename LogEvent>
-using LogEvents = std::vector<LogEventWithFilterData<LogEvent>>;
-
 /**
  * Mapping between an index in the filtered log events collection to an index in the unfiltered
  * log events collection.
  */
 using FilteredLogEventsMap = std::optional<std::vector<size_t>>;
 
+/**
+ * A filter applied by `filter_log_events`, which stays active for log events deserialized later.
+ */
+struct LogEventFilter {
+    // The selected log levels, or std::nullopt if log events aren't filtered by log level.
+    std::optional<LogEventFilterColumns::LogLevelSelection> log_level_selection;
+    // The query log events must match, or empty if log events aren't filtered by a query.
+    std::string query;
+};
+
+/**
+ * Limits on how much of a stream a single deserialization call processes. Deserialization stops
+ * before the next IR unit once either limit has been reached, so the number of bytes read may
+ * exceed `max_num_bytes` by up to one IR unit.
+ */
+struct DeserializationBudget {
+    // Maximum number of log events to deserialize.
+    size_t max_num_events;
+    // Maximum number of decompressed bytes to read.
+    size_t max_num_bytes;
+};
+
 /**
  * Class to deserialize and decode Zstandard-compressed CLP IR streams as well as format decoded
  * log events.
@@ -69,6 +107,102 @@ public:
     create(clp_ffi_js::DataArrayTsType const& data_array, ReaderOptions const& reader_options)
             -> std::unique_ptr<StreamReader>;
 
+    /**
+     * Creates a `StreamReader` that takes ownership of the given buffer rather than copying it.
+     *
+     * @param input_buffer A buffer containing a Zstandard-compressed IR stream. It's empty after
+     * this call.
+     * @param reader_options
+     * @return The created instance.
+     * @throw ClpFfiJsException if any error occurs.
+     */
+    [[nodiscard]] static auto
+    create_from_input_buffer(InputBuffer& input_buffer, ReaderOptions const& reader_options)
+            -> std::unique_ptr<StreamReader>;
+
+    /**
+     * Creates a `StreamReader` that reads the IR stream from a file, decompressing it in bounded
+     * chunks as it's deserialized rather than holding the entire compressed stream in memory.
+     *
+     * NOTE: This is only exposed to JavaScript in Node.js builds, where paths refer to the host's
+     * filesystem. In windowed mode (see `get_checkpoint_interval`) or with an index (see
+     * `create_from_data_buffer`), log events are decoded from the compressed stream, so the entire
+     * file is read into memory.
+     *
+     * @param path The path of a file containing a Zstandard-compressed IR stream.
+     * @param reader_options
+     * @return The created instance.
+     * @throw ClpFfiJsException if the file couldn't be opened or any other error occurs.
+     */
+    [[nodiscard]] static auto
+    create_from_file(std::string const& path, ReaderOptions const& reader_options)
+            -> std::unique_ptr<StreamReader>;
+
+    /**
+     * Creates a `StreamReader` in streaming mode, where the rest of the Zstandard-compressed IR
+     * stream is appended with `append_data` as it arrives, and `deserialize_stream` deserializes
+     * as many log events as the data appended so far allows.
+     *
+     * @param initial_chunk The first chunk of a Zstandard-compressed IR stream. It must contain (at
+     * least) the stream's entire preamble. Since Zstandard decompresses whole blocks, this
+     * generally means the chunk should contain the stream's first block.
+     * @param reader_options
+     * @return The created instance.
+     * @throw ClpFfiJsException with `clp::ErrorCode_Truncated` if `initial_chunk` doesn't contain
+     * the stream's entire preamble.
+     * @throw ClpFfiJsException with `clp::ErrorCode_Unsupported` if `reader_options` contains an
+     * index.
+     * @throw ClpFfiJsException if any other error occurs.
+     */
+    [[nodiscard]] static auto create_streaming(
+            clp_ffi_js::DataArrayTsType const& initial_chunk,
+            ReaderOptions const& reader_options
+    ) -> std::unique_ptr<StreamReader>;
+
+    /**
+     * Creates a `StreamReader` from a snapshot serialized by `serialize_snapshot`, without
+     * deserializing the stream again. The created reader is in windowed mode, with the checkpoint
+     * interval of the reader the snapshot was serialized from.
+     *
+     * @param data_array An array containing the Zstandard-compressed IR stream the snapshot was
+     * serialized from.
+     * @param snapshot
+     * @param reader_options The options the snapshot's reader was created with, except for
+     * `checkpointInterval`, which is ignored.
+     * @return The created instance.
+     * @throw ClpFfiJsException with `clp::ErrorCode_BadParam` if `data_array` isn't the stream the
+     * snapshot was serialized from.
+     * @throw ClpFfiJsException if the snapshot is invalid or any other error occurs.
+     */
+    [[nodiscard]] static auto create_from_snapshot(
+            clp_ffi_js::DataArrayTsType const& data_array,
+            clp_ffi_js::DataArrayTsType const& snapshot,
+            ReaderOptions const& reader_options
+    ) -> std::unique_ptr<StreamReader>;
+
+    /**
+     * Builds a sidecar index for an IR stream file, by deserializing the entire stream and writing
+     * the snapshot of the resulting reader to a file. Passing the index as the `index` reader
+     * option when the stream is opened later restores the reader's filter data and checkpoints, so
+     * that it can serve level filters, counts, and timestamp searches without deserializing the
+     * stream again.
+     *
+     * NOTE: This is only exposed to JavaScript in Node.js builds. See `create_from_file`.
+     *
+     * @param stream_path The path of a file containing a Zstandard-compressed IR stream.
+     * @param index_path The path of the file to write the index to. It's replaced if it exists.
+     * @param reader_options The options to deserialize the stream with. If `checkpointInterval`
+     * isn't set, checkpoints are recorded every 10,000 log events.
+     * @return The number of log events in the stream.
+     * @throw ClpFfiJsException if the stream couldn't be read, the index couldn't be written, or
+     * any other error occurs.
+     */
+    [[nodiscard]] static auto build_index_file(
+            std::string const& stream_path,
+            std::string const& index_path,
+            ReaderOptions const& reader_options
+    ) -> size_t;
+
     // Destructor
     virtual ~StreamReader() = default;
 
@@ -94,6 +228,24 @@ public:
      */
     [[nodiscard]] virtual auto get_num_events_buffered() const -> size_t = 0;
 
+    /**
+     * @return Typed-array views of the filter data of the buffered log events, as an object with
+     * the following properties, each with one element per log event:
+     * - logLevels: The log levels (as `Uint8Array`, indexing into `cLogLevelNames`).
+     * - timestamps: The timestamps in milliseconds since the Unix epoch (as `BigInt64Array`).
+     * - utcOffsets: The UTC offsets in minutes (as `Int16Array`).
+     *
+     * NOTE: The views are only valid until more log events are deserialized, or the WASM memory
+     * grows, so callers should copy any data they need to keep.
+     */
+    [[nodiscard]] auto get_filter_data_columns() const -> FilterDataColumnsTsType;
+
+    /**
+     * @return The number of buffered log events with each log level, as an array indexed by log
+     * level (see `cLogLevelNames`). The counts ignore any filter.
+     */
+    [[nodiscard]] auto get_log_level_counts() const -> LogLevelCountsTsType;
+
     /**
      * @return The filtered log events map.
      * This is a sorted list of log event indices that match the filter.
@@ -104,10 +256,15 @@ public:
     /**
      * Generates a filtered collection from all log events.
      *
+     * The filter stays active until the next call, so log events deserialized later (e.g., from
+     * data appended in streaming mode) are added to the filtered collection as they're
+     * deserialized, without re-filtering the log events before them.
+     *
      * @param log_level_filter Array of selected log levels.
      * @param kql_filter: A KQL expression used to filter kv-pairs.
      * - For structured IR: the filter is applied when non-empty.
-     * - For unstructured IR: the filter is always ignored, and a warning is logged when non-empty.
+     * - For unstructured IR: the filter is applied when non-empty, as a wildcard query on the log
+     *   events' messages (see `UnstructuredLogEventQuery`).
      */
     virtual void
     filter_log_events(LogLevelFilterTsType const& log_level_filter, std::string const& kql_filter)
@@ -122,13 +279,56 @@ public:
         filter_log_events(log_level_filter, "");
     }
 
+    /**
+     * Appends the next chunk of the compressed stream to a reader created with `create_streaming`.
+     *
+     * @param chunk
+     * @throw ClpFfiJsException if the reader isn't in streaming mode or `mark_end_of_input` has
+     * already been called.
+     */
+    void append_data(clp_ffi_js::DataArrayTsType const& chunk);
+
+    /**
+     * Marks that no more data will be appended to a reader created with `create_streaming`, so
+     * that `deserialize_stream` treats any trailing partial IR unit as an incomplete stream.
+     *
+     * @throw ClpFfiJsException if the reader isn't in streaming mode.
+     */
+    void mark_end_of_input();
+
     /**
      * Deserializes all log events in the stream.
      *
+     * In streaming mode, deserializes all log events in the data appended so far. A trailing
+     * partial IR unit is kept and deserialized by a later call once more data has been appended,
+     * unless `mark_end_of_input` has been called.
+     *
      * @return The number of successfully deserialized ("valid") log events.
      * @throw ClpFfiJsException if an error occurs during deserialization.
      */
-    [[nodiscard]] virtual auto deserialize_stream() -> size_t = 0;
+    [[nodiscard]] auto deserialize_stream() -> size_t;
+
+    /**
+     * Deserializes the next log events in the stream, up to the limits in `options`, continuing
+     * from where the previous call (or `deserialize_stream`) stopped. The log events deserialized
+     * so far can be decoded, filtered, and searched between calls.
+     *
+     * In streaming mode, a call that returns without `isDone` set and without deserializing any log
+     * events is waiting for more data to be appended.
+     *
+     * @param options An object with the optional limits:
+     * - `maxEvents`: The maximum number of log events to deserialize.
+     * - `maxBytes`: The maximum number of decompressed bytes to read, which may be exceeded by up
+     *   to one IR unit.
+     * @return An object containing:
+     * - `numBytesConsumed`: The number of decompressed bytes deserialized so far.
+     * - `numEventsBuffered`: The number of log events deserialized so far.
+     * - `isDone`: Whether the stream has been exhausted.
+     * @throw ClpFfiJsException if either limit isn't positive or an error occurs during
+     * deserialization.
+     */
+    [[nodiscard]] auto deserialize_next(DeserializeNextOptionsTsType const& options)
+            -> DeserializationProgressTsType;
 
     /**
      * Decodes log events in the range `[beginIdx, endIdx)` of the filtered or unfiltered
@@ -153,100 +353,462 @@ public:
             = 0;
 
     /**
-     * Finds the log event, L, where if we assume:
+     * Decodes log events in the range `[beginIdx, endIdx)` of the filtered or unfiltered
+     * (depending on the value of `useFilter`) log events collection, like `decode_range`, but
+     * returns the results as packed columns rather than an object per log event.
      *
-     * - the collection of log events is sorted in chronological order;
-     * - and we insert a marker log event, M, with timestamp `target_ts` into the collection (if log
+     * @param begin_idx
+     * @param end_idx
+     * @param use_filter Whether to decode from the filtered or unfiltered log events collection.
+     * @return See `DecodedResultsBinary::to_js_object`.
+     * @return null if any log event in the range doesn't exist (e.g. the range exceeds the number
+     * of log events in the collection).
+     * @throw ClpFfiJsException if a message cannot be decoded.
+     */
+    [[nodiscard]] virtual auto
+    decode_range_binary(size_t begin_idx, size_t end_idx, bool use_filter) const
+            -> DecodedResultsBinaryTsType
+            = 0;
+
+    /**
+     * Counts the log events in the filtered or unfiltered (depending on the value of `useFilter`)
+     * log events collection whose timestamps fall in each of `numBuckets` consecutive, equal-width
+     * buckets spanning `[beginTs, endTs)`.
+     *
+     * Bucket `i` covers `[beginTs + i * width, beginTs + (i + 1) * width)`, where `width` is
+     * `endTs - beginTs` divided by `numBuckets`, rounded up. Log events outside `[beginTs, endTs)`
+     * aren't counted.
+     *
+     * @param begin_ts
+     * @param end_ts
+     * @param num_buckets
+     * @param use_filter Whether to count the filtered or unfiltered log events collection.
+     * @param split_by_log_level Whether to count each log level separately.
+     * @return A `Uint32Array` of the counts, with one element per bucket, or, if
+     * `split_by_log_level` is true, `cLogLevelNames.size()` elements per bucket (indexed by log
+     * level) stored bucket-by-bucket.
+     * @return null if `use_filter` is true and there's no filter, or if the buckets are invalid
+     * (e.g. `num_buckets` is zero or `end_ts` isn't after `begin_ts`).
+     */
+    [[nodiscard]] virtual auto get_time_histogram(
+            clp::ir::epoch_time_ms_t begin_ts,
+            clp::ir::epoch_time_ms_t end_ts,
+            size_t num_buckets,
+            bool use_filter,
+            bool split_by_log_level
+    ) const -> TimeHistogramTsType
+            = 0;
+
+    /**
+     * Serializes the reader's state into a snapshot, from which `create_from_snapshot` can
+     * restore an equivalent reader without deserializing the stream again.
+     *
+     * The snapshot contains the log events' filter data, the stream's checkpoints (including the
+     * IR units needed to restore the stream's schema trees or logtypes), and a hash of the
+     * compressed stream to check that the snapshot is restored with the same stream. The active
+     * filter isn't included.
+     *
+     * @return A `Uint8Array` containing the snapshot.
+     * @throw ClpFfiJsException if the reader isn't in windowed mode (see
+     * `get_checkpoint_interval`), or the stream hasn't been fully deserialized.
+     */
+    [[nodiscard]] auto serialize_snapshot() const -> SnapshotTsType;
+
+    /**
+     * Exports the log events of the filtered or unfiltered (depending on the value of `use_filter`)
+     * collection, starting at `begin_idx`, as UTF-8 lines: JSON Lines for structured streams, and
+     * the decoded messages for unstructured streams. Callers export the entire collection by
+     * calling this repeatedly with the previous chunk's `nextIdx`, so that only one chunk is held
+     * in memory at a time.
+     *
+     * Chunks end on line boundaries, and only exceed the chunk size if a single line does. Exports
+     * bypass the decoded message cache, so that they don't evict the messages being viewed.
+     *
+     * @param begin_idx
+     * @param use_filter
+     * @param options An object with the following optional properties:
+     * - chunkSize: The number of bytes after which the chunk ends (default 1 MiB). The chunk ends
+     *   with the line that reaches this size, so it may exceed it by up to one line.
+     * - formatTimestamps: Whether to include each log event's timestamp in ISO 8601 format, in the
+     *   log event's UTC offset. It's prepended to unstructured lines, and added as the `timestamp`
+     *   key of structured lines.
+     * @return An object with the following properties:
+     * - data: A `Uint8Array` containing the chunk, which has its own buffer, so it can be
+     *   transferred to another thread.
+     * - nextIdx: The index of the first log event that isn't in the chunk.
+     * - isDone: Whether the chunk ends the collection.
+     * @return null if `begin_idx` exceeds the number of log events in the collection, or
+     * `use_filter` is true and there's no filter.
+     * @throw ClpFfiJsException if the chunk size isn't positive or a message cannot be decoded.
+     */
+    [[nodiscard]] auto
+    export_chunk(size_t begin_idx, bool use_filter, ExportOptionsTsType const& options) const
+            -> ExportedChunkTsType;
+
+    /**
+     * @return The statistics of the cache of decoded messages that `decode_range` and
+     * `decode_range_binary` reuse, as an object with the following properties:
+     * - numHits: The number of messages found in the cache.
+     * - numMisses: The number of messages that had to be decoded.
+     * - numEntries: The number of cached messages.
+     * - numBytes: The estimated number of bytes used by the cached messages.
+     * - capacity: The maximum number of bytes the cached messages can use.
+     */
+    [[nodiscard]] auto get_decoded_message_cache_stats() const -> DecodedMessageCacheStatsTsType;
+
+    /**
+     * Sets the maximum number of bytes the cache of decoded messages can use, evicting the least
+     * recently used messages until it fits. A capacity of 0 disables the cache.
+     *
+     * @param capacity
+     */
+    void set_decoded_message_cache_capacity(size_t capacity) {
+        m_decoded_message_cache.set_capacity(capacity);
+    }
+
+    /**
+     * Sets the template that `decode_range` and `decode_range_binary` render each log event's
+     * message with, instead of its default rendering. See `FormatTemplate` for the pattern's
+     * syntax. Exports aren't affected.
+     *
+     * @param pattern The template's pattern, or an empty string to clear the template.
+     * @throw ClpFfiJsException if the pattern is invalid, or the stream type doesn't support
+     * format templates.
+     */
+    virtual void set_format_template(std::string const& pattern) = 0;
+
+    /**
+     * @return Whether the timestamps of the log events buffered so far are non-decreasing.
+     */
+    [[nodiscard]] auto is_chronological() const -> bool {
+        return get_filter_columns().is_chronological();
+    }
+
+    /**
+     * Finds the log event, L, where if we:
+     *
+     * - order the collection of log events chronologically (log events with equal timestamps being
+     *   ordered by index);
+     * - and insert a marker log event, M, with timestamp `target_ts` into the collection (if log
      *   events with timestamp `target_ts` already exist in the collection, M should be inserted
      *   after them).
      *
      * L is the event just before M, if M is not the first event in the collection; otherwise L is
      * the event just after M.
      *
-     * NOTE: If the collection of log events isn't in chronological order, this method has undefined
-     * behaviour.
+     * If the collection isn't in chronological order (see `is_chronological`), the first search
+     * after more log events are buffered takes longer, since it sorts them by timestamp.
      *
      * @param target_ts
      * @return The index of the log event L.
+     * @return null if there are no log events.
      */
     [[nodiscard]] virtual auto
     find_nearest_log_event_by_timestamp(clp::ir::epoch_time_ms_t target_ts) -> NullableLogEventIdx
             = 0;
 
 protected:
+    // `MergedStreamReader` merges its streams' log events using their filter data.
+    friend class MergedStreamReader;
+
     explicit StreamReader() = default;
 
     /**
-     * Templated implementation of `decode_range` that uses `log_event_to_string` to convert
-     * `log_event` to a string for the returned result.
+     * Creates a `StreamReader` that owns the given buffer.
+     *
+     * If `reader_options` contains an `index` (see `build_index_file`), the reader is restored from
+     * it as by `create_from_snapshot`, rather than deserializing the stream.
      *
-     * @tparam LogEvent
-     * @tparam ToStringFunc Function to convert a log event into a string.
+     * @param data_buffer A buffer containing a Zstandard-compressed IR stream.
+     * @param reader_options
+     * @return The created instance.
+     * @throw ClpFfiJsException with `clp::ErrorCode_BadParam` if the index wasn't built from the
+     * stream.
+     * @throw ClpFfiJsException if any other error occurs.
+     */
+    [[nodiscard]] static auto
+    create_from_data_buffer(std::vector<char>&& data_buffer, ReaderOptions const& reader_options)
+            -> std::unique_ptr<StreamReader>;
+
+    /**
+     * Creates the type of `StreamReader` that a snapshot was serialized from.
+     *
+     * @param data_buffer A buffer containing the Zstandard-compressed IR stream the snapshot was
+     * serialized from.
+     * @param snapshot
+     * @param reader_options
+     * @return The created instance.
+     * @throw ClpFfiJsException with `clp::ErrorCode_BadParam` if `data_buffer` isn't the stream the
+     * snapshot was serialized from.
+     * @throw ClpFfiJsException if the snapshot is invalid or any other error occurs.
+     */
+    [[nodiscard]] static auto create_from_snapshot_buffer(
+            std::vector<char>&& data_buffer,
+            std::span<char const> snapshot,
+            ReaderOptions const& reader_options
+    ) -> std::unique_ptr<StreamReader>;
+
+    /**
+     * @param reader_options
+     * @return The checkpoint interval if the options enable windowed mode, where the reader only
+     * buffers each log event's filter data and decodes log events on demand from checkpoints
+     * recorded every `checkpointInterval` log events.
+     * @return std::nullopt otherwise.
+     * @throw ClpFfiJsException if the checkpoint interval isn't positive.
+     */
+    [[nodiscard]] static auto get_checkpoint_interval(ReaderOptions const& reader_options)
+            -> std::optional<size_t>;
+
+    /**
+     * Writes the reader's state to a snapshot, starting with the header written by
+     * `write_snapshot_header`.
+     *
+     * @param writer
+     * @throw ClpFfiJsException if the reader isn't in windowed mode, or the stream hasn't been
+     * fully deserialized.
+     */
+    virtual auto write_snapshot(SnapshotWriter& writer) const -> void = 0;
+
+    /**
+     * Writes a snapshot's header, which identifies the format, the type of stream, and the
+     * compressed stream.
+     *
+     * @param writer
+     * @param compressed_data
+     */
+    auto write_snapshot_header(SnapshotWriter& writer, std::span<char const> compressed_data) const
+            -> void;
+
+    /**
+     * Decodes the message of the log event at the given index and appends it to `output`.
+     *
+     * @param log_event_idx
+     * @param output
+     * @throw ClpFfiJsException if the message cannot be decoded.
+     */
+    virtual auto append_decoded_message(size_t log_event_idx, std::string& output) const -> void
+            = 0;
+
+    /**
+     * Appends the line that `export_chunk` exports for the log event at the given index to
+     * `output`, without the newline that ends it.
+     *
+     * @param log_event_idx
+     * @param timestamp The log event's formatted timestamp to include in the line, if any.
+     * @param output
+     * @throw ClpFfiJsException if the message cannot be decoded.
+     */
+    virtual auto append_exported_line(
+            size_t log_event_idx,
+            std::optional<std::string_view> timestamp,
+            std::string& output
+    ) const -> void = 0;
+
+    /**
+     * Removes every message from the decoded message cache, for when the way messages are rendered
+     * changes.
+     */
+    auto clear_decoded_message_cache() -> void { m_decoded_message_cache.clear(); }
+
+    /**
+     * @return The reader that data is appended to if the reader is in streaming mode and still
+     * accepting data.
+     * @return nullptr otherwise.
+     */
+    [[nodiscard]] virtual auto get_chunked_reader() const -> ChunkedZstdReader* = 0;
+
+    /**
+     * @return The filter data of the buffered log events.
+     */
+    [[nodiscard]] virtual auto get_filter_columns() const -> LogEventFilterColumns const& = 0;
+
+    /**
+     * @return The indices of the buffered log events that match the active filter, or std::nullopt
+     * if there's no filter.
+     */
+    [[nodiscard]] virtual auto get_filtered_log_event_indices() const
+            -> FilteredLogEventsMap const& = 0;
+
+    /**
+     * Deserializes log events until the stream is exhausted or the budget is used up.
+     *
+     * @param budget
+     * @return Whether the stream has been exhausted.
+     * @throw ClpFfiJsException if an error occurs during deserialization.
+     */
+    [[nodiscard]] virtual auto deserialize_within_budget(DeserializationBudget const& budget)
+            -> bool = 0;
+
+    /**
+     * @return The number of decompressed bytes deserialized so far.
+     */
+    [[nodiscard]] virtual auto get_num_bytes_consumed() const -> size_t = 0;
+
+    /**
+     * Adds the log events in `[begin_idx, get_num_events_buffered())` that match the active filter
+     * (if any) to the filtered collection.
+     *
+     * @param begin_idx The number of log events the filtered collection was generated from.
+     * @throw ClpFfiJsException if the log events couldn't be filtered.
+     */
+    virtual auto extend_filtered_log_events(size_t begin_idx) -> void = 0;
+
+    /**
+     * Templated implementation of `decode_range` that uses `log_event_idx_to_string` to convert the
+     * log event at a given index to a string for the returned result, unless the string is in the
+     * decoded message cache.
+     *
+     * @tparam IdxToStringFunc Function to convert the log event at an index into a string.
      * @param begin_idx
      * @param end_idx
      * @param filtered_log_event_map
-     * @param log_events
+     * @param filter_columns The filter data of every log event.
+     * @param log_event_idx_to_string
      * @param use_filter
-     * @param log_event_to_string
      * @return See `decode_range`.
-     * @throws Propagates `ToStringFunc`'s exceptions.
+     * @throws Propagates `IdxToStringFunc`'s exceptions.
      */
-    template <typename LogEvent, typename ToStringFunc>
-    requires requires(ToStringFunc func, LogEvent const& log_event) {
-        { func(log_event) } -> std::convertible_to<std::string>;
+    template <typename IdxToStringFunc>
+    requires requires(IdxToStringFunc func, size_t log_event_idx) {
+        { func(log_event_idx) } -> std::convertible_to<std::string>;
     }
-    static auto generic_decode_range(
+    auto generic_decode_range(
             size_t begin_idx,
             size_t end_idx,
             FilteredLogEventsMap const& filtered_log_event_map,
-            LogEvents<LogEvent> const& log_events,
-            ToStringFunc log_event_to_string,
+            LogEventFilterColumns const& filter_columns,
+            IdxToStringFunc log_event_idx_to_string,
             bool use_filter
-    ) -> DecodedResultsTsType;
+    ) const -> DecodedResultsTsType;
 
     /**
-     * Templated implementation of `filter_log_events`.
+     * Templated implementation of `decode_range_binary` that uses `append_message` to decode the
+     * message of the log event at a given index into the results' message buffer, unless the
+     * message is in the decoded message cache.
      *
-     * @tparam LogEvent
+     * @tparam AppendMessageFunc Function to append the message of the log event at an index to a
+     * string.
+     * @param begin_idx
+     * @param end_idx
+     * @param filtered_log_event_map
+     * @param filter_columns The filter data of every log event.
+     * @param append_message
+     * @param use_filter
+     * @return See `decode_range_binary`.
+     * @throws Propagates `AppendMessageFunc`'s and `DecodedResultsBinary`'s exceptions.
+     */
+    template <typename AppendMessageFunc>
+    requires std::invocable<AppendMessageFunc, size_t, std::string&>
+    auto generic_decode_range_binary(
+            size_t begin_idx,
+            size_t end_idx,
+            FilteredLogEventsMap const& filtered_log_event_map,
+            LogEventFilterColumns const& filter_columns,
+            AppendMessageFunc append_message,
+            bool use_filter
+    ) const -> DecodedResultsBinaryTsType;
+
+    /**
+     * Generic implementation of `get_time_histogram`.
+     *
+     * @param begin_ts
+     * @param end_ts
+     * @param num_buckets
+     * @param filtered_log_event_map
+     * @param filter_columns Derived class's log events' filter data.
+     * @param use_filter
+     * @param split_by_log_level
+     * @return See `get_time_histogram`.
+     */
+    [[nodiscard]] static auto generic_get_time_histogram(
+            clp::ir::epoch_time_ms_t begin_ts,
+            clp::ir::epoch_time_ms_t end_ts,
+            size_t num_buckets,
+            FilteredLogEventsMap const& filtered_log_event_map,
+            LogEventFilterColumns const& filter_columns,
+            bool use_filter,
+            bool split_by_log_level
+    ) -> TimeHistogramTsType;
+
+    /**
+     * @param log_level_filter A non-null array of selected log levels.
+     * @return Whether each log level is selected. Unknown log levels are ignored.
+     */
+    [[nodiscard]] static auto get_log_level_selection(LogLevelFilterTsType const& log_level_filter)
+            -> LogEventFilterColumns::LogLevelSelection;
+
+    /**
      * @param log_level_filter
-     * @param log_events Derived class's log events.
-     * @param log_events
-     * @param[out] filtered_log_event_map Returns the filtered log events.
-     */
-    template <typename LogEvent>
-    static auto generic_filter_log_events(
-            FilteredLogEventsMap& filtered_log_event_map,
-            LogLevelFilterTsType const& log_level_filter,
-            LogEvents<LogEvent> const& log_events
+     * @param kql_filter
+     * @return The filter to apply for the given `filter_log_events` arguments.
+     * @return std::nullopt if the arguments don't filter out any log events.
+     */
+    [[nodiscard]] static auto
+    create_log_event_filter(LogLevelFilterTsType const& log_level_filter, std::string kql_filter)
+            -> std::optional<LogEventFilter>;
+
+    /**
+     * Generic implementation of `extend_filtered_log_events` that filters by log level.
+     *
+     * @param[in,out] filtered_log_event_indices The filtered indices of the log events before
+     * `begin_idx`, to which the matching log events from `begin_idx` onwards are appended.
+     * @param filter
+     * @param filter_columns Derived class's log events' filter data.
+     * @param begin_idx
+     * @param query_matched_log_event_indices The indices of the log events from `begin_idx` onwards
+     * that match `filter.query`, in ascending order. Ignored if `filter.query` is empty.
+     */
+    static auto generic_extend_filtered_log_events(
+            std::vector<size_t>& filtered_log_event_indices,
+            LogEventFilter const& filter,
+            LogEventFilterColumns const& filter_columns,
+            size_t begin_idx,
+            std::vector<size_t> const& query_matched_log_event_indices
     ) -> void;
 
     /**
-     * Templated implementation of `find_nearest_log_event_by_timestamp`.
+     * Generic implementation of `find_nearest_log_event_by_timestamp`.
      *
-     * @tparam LogEvent
-     * @param log_events
+     * @param filter_columns Derived class's log events' filter data.
      * @param target_ts
      * @return See `find_nearest_log_event_by_timestamp`.
      */
-    template <typename LogEvent>
-    auto generic_find_nearest_log_event_by_timestamp(
-            LogEvents<LogEvent> const& log_events,
+    static auto generic_find_nearest_log_event_by_timestamp(
+            LogEventFilterColumns const& filter_columns,
             clp::ir::epoch_time_ms_t target_ts
     ) -> NullableLogEventIdx;
+
+private:
+    // Methods
+    /**
+     * Deserializes log events with `deserialize_within_budget`, then extends the filtered
+     * collection with the newly deserialized log events.
+     *
+     * @param budget
+     * @return Whether the stream has been exhausted.
+     * @throw Propagates `deserialize_within_budget`'s and `extend_filtered_log_events`'s
+     * exceptions.
+     */
+    [[nodiscard]] auto deserialize_and_filter(DeserializationBudget const& budget) -> bool;
+
+    // Variables
+    // Repeated renders of the same rows reuse their messages rather than decoding them again. It's
+    // mutable since it's only a cache, to allow decoding in const methods.
+    mutable DecodedMessageCache m_decoded_message_cache;
 };
 
-template <typename LogEvent, typename ToStringFunc>
-requires requires(ToStringFunc func, LogEvent const& log_event) {
-    { func(log_event) } -> std::convertible_to<std::string>;
+template <typename IdxToStringFunc>
+requires requires(IdxToStringFunc func, size_t log_event_idx) {
+    { func(log_event_idx) } -> std::convertible_to<std::string>;
 }
 auto StreamReader::generic_decode_range(
         size_t begin_idx,
         size_t end_idx,
         FilteredLogEventsMap const& filtered_log_event_map,
-        LogEvents<LogEvent> const& log_events,
-        ToStringFunc log_event_to_string,
+        LogEventFilterColumns const& filter_columns,
+        IdxToStringFunc log_event_idx_to_string,
         bool use_filter
-) -> DecodedResultsTsType {
+) const -> DecodedResultsTsType {
     if (use_filter && false == filtered_log_event_map.has_value()) {
         return DecodedResultsTsType{emscripten::val::null()};
     }
@@ -255,7 +817,7 @@ auto StreamReader::generic_decode_range(
     if (use_filter) {
         length = filtered_log_event_map->size();
     } else {
-        length = log_events.size();
+        length = filter_columns.size();
     }
     if (length < end_idx || begin_idx > end_idx) {
         SPDLOG_ERROR("Invalid log event index range: {}-{}", begin_idx, end_idx);
@@ -272,11 +834,23 @@ auto StreamReader::generic_decode_range(
             log_event_idx = i;
         }
 
-        auto const& log_event_with_filter_data{log_events.at(log_event_idx)};
-        auto const& log_event = log_event_with_filter_data.get_log_event();
-        auto const& timestamp = log_event_with_filter_data.get_timestamp();
-        auto const& log_level = log_event_with_filter_data.get_log_level();
-        auto const& utc_offset = log_event_with_filter_data.get_utc_offset().count();
+        auto const timestamp = filter_columns.get_timestamp(log_event_idx);
+        auto const log_level = filter_columns.get_log_level(log_event_idx);
+        auto const utc_offset = filter_columns.get_utc_offset(log_event_idx).count();
+
+        std::string decoded_message;
+        auto const* message{m_decoded_message_cache.find(log_event_idx)};
+        if (nullptr == message) {
+            decoded_message = log_event_idx_to_string(log_event_idx);
+            if (m_decoded_message_cache.can_cache(decoded_message.size())) {
+                message = m_decoded_message_cache.insert(
+                        log_event_idx,
+                        std::move(decoded_message)
+                );
+            } else {
+                message = &decoded_message;
+            }
+        }
 
         EM_ASM(
                 {
@@ -289,9 +863,9 @@ auto StreamReader::generic_decode_range(
                     });
                 },
                 results.as_handle(),
-                log_event_idx + 1,
+                to_js_size(log_event_idx + 1),
                 log_level,
-                log_event_to_string(log_event).c_str(),
+                message->c_str(),
                 timestamp,
                 utc_offset
         );
@@ -300,60 +874,53 @@ auto StreamReader::generic_decode_range(
     return DecodedResultsTsType(results);
 }
 
-template <typename LogEvent>
-auto StreamReader::generic_filter_log_events(
-        FilteredLogEventsMap& filtered_log_event_map,
-        LogLevelFilterTsType const& log_level_filter,
-        LogEvents<LogEvent> const& log_events
-) -> void {
-    if (log_level_filter.isNull()) {
-        filtered_log_event_map.reset();
-        return;
-    }
-
-    filtered_log_event_map.emplace();
-    auto filter_levels
-            = emscripten::vecFromJSArray<std::underlying_type_t<LogLevel>>(log_level_filter);
-
-    for (size_t log_event_idx = 0; log_event_idx < log_events.size(); ++log_event_idx) {
-        auto const& log_event = log_events[log_event_idx];
-        if (std::ranges::find(
-                    filter_levels,
-                    clp::enum_to_underlying_type(log_event.get_log_level())
-            )
-            != filter_levels.end())
-        {
-            filtered_log_event_map->emplace_back(log_event_idx);
-        }
+template <typename AppendMessageFunc>
+requires std::invocable<AppendMessageFunc, size_t, std::string&>
+auto StreamReader::generic_decode_range_binary(
+        size_t begin_idx,
+        size_t end_idx,
+        FilteredLogEventsMap const& filtered_log_event_map,
+        LogEventFilterColumns const& filter_columns,
+        AppendMessageFunc append_message,
+        bool use_filter
+) const -> DecodedResultsBinaryTsType {
+    if (use_filter && false == filtered_log_event_map.has_value()) {
+        return DecodedResultsBinaryTsType{emscripten::val::null()};
     }
-}
 
-template <typename LogEvent>
-auto StreamReader::generic_find_nearest_log_event_by_timestamp(
-        LogEvents<LogEvent> const& log_events,
-        clp::ir::epoch_time_ms_t target_ts
-) -> NullableLogEventIdx {
-    if (log_events.empty()) {
-        return NullableLogEventIdx{emscripten::val::null()};
+    size_t const length{use_filter ? filtered_log_event_map->size() : filter_columns.size()};
+    if (length < end_idx || begin_idx > end_idx) {
+        SPDLOG_ERROR("Invalid log event index range: {}-{}", begin_idx, end_idx);
+        return DecodedResultsBinaryTsType{emscripten::val::null()};
     }
 
-    // Find the log event whose timestamp is just after `target_ts`
-    auto first_greater_it{std::upper_bound(
-            log_events.begin(),
-            log_events.end(),
-            target_ts,
-            [](clp::ir::epoch_time_ms_t ts, LogEventWithFilterData<LogEvent> const& log_event) {
-                return ts < log_event.get_timestamp();
+    DecodedResultsBinary results;
+    results.reserve(end_idx - begin_idx);
+    auto& message_buffer{results.get_message_buffer()};
+    for (size_t i = begin_idx; i < end_idx; ++i) {
+        auto const log_event_idx{use_filter ? filtered_log_event_map->at(i) : i};
+        if (auto const* message{m_decoded_message_cache.find(log_event_idx)}; nullptr != message) {
+            message_buffer.append(*message);
+        } else {
+            auto const message_begin_pos{message_buffer.size()};
+            append_message(log_event_idx, message_buffer);
+            auto const message_size{message_buffer.size() - message_begin_pos};
+            if (m_decoded_message_cache.can_cache(message_size)) {
+                m_decoded_message_cache.insert(
+                        log_event_idx,
+                        message_buffer.substr(message_begin_pos)
+                );
             }
-    )};
-
-    if (first_greater_it == log_events.begin()) {
-        return NullableLogEventIdx{emscripten::val(0)};
+        }
+        results.add_log_event(
+                log_event_idx + 1,
+                filter_columns.get_log_levels()[log_event_idx],
+                filter_columns.get_timestamp(log_event_idx),
+                filter_columns.get_utc_offsets()[log_event_idx]
+        );
     }
 
-    auto const first_greater_idx{std::distance(log_events.begin(), first_greater_it)};
-
-    return NullableLogEventIdx{emscripten::val(first_greater_idx - 1)};
+    return DecodedResultsBinaryTsType{results.to_js_object()};
 }
 }  // namespace clp_ffi_js::ir
 
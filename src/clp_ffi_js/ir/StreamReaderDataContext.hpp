@@ -2,16 +2,23 @@
 #define CLP_FFI_JS_IR_STREAMREADERDATACONTEXT_HPP
 
 #include <memory>
+#include <span>
 #include <utility>
+#include <vector>
 
 #include <clp/ReaderInterface.hpp>
-#include <ystdlib/containers/Array.hpp>
+
+#include <clp_ffi_js/ir/ChunkedZstdReader.hpp>
 
 namespace clp_ffi_js::ir {
 /**
  * The data context for a `StreamReader`. It encapsulates a chain of the following resources:
- * An IR deserializer class that reads from a `clp::ReaderInterface`, which in turn reads from a
- * `ystdlib::containers::Array`.
+ * An IR deserializer class that reads from a `clp::ReaderInterface`, which in turn reads from
+ * either:
+ * - a buffer containing the entire compressed stream;
+ * - a file that's decompressed in bounded chunks (see `ZstdFileReader`), in which case the buffer
+ *   is empty;
+ * - or, in streaming mode, a `ChunkedZstdReader` that the compressed stream is appended to.
  * @tparam Deserializer Type of deserializer.
  */
 template <typename Deserializer>
@@ -19,7 +26,7 @@ class StreamReaderDataContext {
 public:
     // Constructors
     StreamReaderDataContext(
-            ystdlib::containers::Array<char>&& data_buffer,
+            std::vector<char>&& data_buffer,
             std::unique_ptr<clp::ReaderInterface>&& reader,
             Deserializer deserializer
     )
@@ -27,6 +34,14 @@ public:
               m_reader{std::move(reader)},
               m_deserializer{std::move(deserializer)} {}
 
+    StreamReaderDataContext(
+            std::unique_ptr<ChunkedZstdReader>&& chunked_reader,
+            Deserializer deserializer
+    )
+            : m_chunked_reader{chunked_reader.get()},
+              m_reader{std::move(chunked_reader)},
+              m_deserializer{std::move(deserializer)} {}
+
     // Disable copy constructor and assignment operator
     StreamReaderDataContext(StreamReaderDataContext const&) = delete;
     auto operator=(StreamReaderDataContext const&) -> StreamReaderDataContext& = delete;
@@ -43,8 +58,26 @@ public:
 
     [[nodiscard]] auto get_reader() -> clp::ReaderInterface& { return *m_reader; }
 
+    /**
+     * @return The chunked reader if the context is in streaming mode.
+     * @return nullptr otherwise.
+     */
+    [[nodiscard]] auto get_chunked_reader() const -> ChunkedZstdReader* { return m_chunked_reader; }
+
+    /**
+     * @return A view of the compressed stream (or the part of it that has been appended so far).
+     */
+    [[nodiscard]] auto get_compressed_data() const -> std::span<char const> {
+        if (nullptr != m_chunked_reader) {
+            return m_chunked_reader->get_compressed_data();
+        }
+        return {m_data_buffer.data(), m_data_buffer.size()};
+    }
+
 private:
-    ystdlib::containers::Array<char> m_data_buffer;
+    std::vector<char> m_data_buffer;
+    // Non-owning alias of `m_reader` in streaming mode.
+    ChunkedZstdReader* m_chunked_reader{nullptr};
     std::unique_ptr<clp::ReaderInterface> m_reader;
     Deserializer m_deserializer;
 };
@@ -8,41 +8,53 @@
 #include <string>
 #include <string_view>
 #include <system_error>
-#include <type_traits>
+#include <tuple>
 #include <utility>
 #include <vector>
 
 #include <clp/ErrorCode.hpp>
 #include <clp/ffi/ir_stream/Deserializer.hpp>
+#include <clp/ffi/ir_stream/IrUnitType.hpp>
 #include <clp/ffi/SchemaTree.hpp>
 #include <clp/ir/types.hpp>
+#include <clp/ReaderInterface.hpp>
 #include <clp/type_utils.hpp>
 #include <emscripten/bind.h>
 #include <emscripten/val.h>
 #include <nlohmann/json.hpp>
 #include <spdlog/spdlog.h>
-#include <ystdlib/containers/Array.hpp>
 
+#include <clp_ffi_js/binding_types.hpp>
 #include <clp_ffi_js/ClpFfiJsException.hpp>
 #include <clp_ffi_js/constants.hpp>
+#include <clp_ffi_js/ir/CheckpointIndex.hpp>
+#include <clp_ffi_js/ir/ChunkedZstdReader.hpp>
 #include <clp_ffi_js/ir/decoding_methods.hpp>
-#include <clp_ffi_js/ir/LogEventWithFilterData.hpp>
+#include <clp_ffi_js/ir/FormatTemplate.hpp>
+#include <clp_ffi_js/ir/GrowableBufferReader.hpp>
+#include <clp_ffi_js/ir/KeyProjection.hpp>
+#include <clp_ffi_js/ir/LogEventWindowDecoder.hpp>
+#include <clp_ffi_js/ir/LogEventFilterColumns.hpp>
+#include <clp_ffi_js/ir/LogEvents.hpp>
 #include <clp_ffi_js/ir/query_methods.hpp>
+#include <clp_ffi_js/ir/Snapshot.hpp>
 #include <clp_ffi_js/ir/StreamReader.hpp>
 #include <clp_ffi_js/ir/StreamReaderDataContext.hpp>
 #include <clp_ffi_js/ir/StructuredIrUnitHandler.hpp>
-#include <clp_ffi_js/utils.hpp>
+#include <clp_ffi_js/ir/StructuredLogEventJsonWriter.hpp>
 
 namespace clp_ffi_js::ir {
 namespace {
-constexpr std::string_view cEmptyJsonStr{"{}"};
 constexpr std::string_view cFilterOptionIsAutoGeneratedKey{"isAutoGenerated"};
 constexpr std::string_view cFilterOptionPartsKey{"parts"};
 constexpr std::string_view cReaderOptionsLogLevelKey{"logLevelKey"};
+constexpr std::string_view cReaderOptionsProjectionKeysKey{"projectionKeys"};
 constexpr std::string_view cReaderOptionsTimestampKey{"timestampKey"};
 constexpr std::string_view cReaderOptionsUtcOffsetKey{"utcOffsetKey"};
 constexpr std::string_view cMergedKvPairsAutoGeneratedKey{"auto-generated"};
 constexpr std::string_view cMergedKvPairsUserGeneratedKey{"user-generated"};
+// Key of the formatted timestamp added to exported JSON objects.
+constexpr std::string_view cExportedTimestampKey{"timestamp"};
 
 /**
  * @param filter_option The JavaScript object representing a filter option.
@@ -71,26 +83,90 @@ auto get_schema_tree_full_branch_from_filter_option(
     };
 }
 
-EMSCRIPTEN_BINDINGS(ClpStructuredIrStreamReader) {
-    emscripten::constant(
-            "MERGED_KV_PAIRS_AUTO_GENERATED_KEY",
-            std::string{cMergedKvPairsAutoGeneratedKey}
-    );
-    emscripten::constant(
-            "MERGED_KV_PAIRS_USER_GENERATED_KEY",
-            std::string{cMergedKvPairsUserGeneratedKey}
-    );
+/**
+ * @param reader_options
+ * @return A key projection of the key paths in the reader options' projection keys.
+ * @return nullptr if the reader options don't specify projection keys.
+ */
+[[nodiscard]] auto get_key_projection_from_reader_options(ReaderOptions const& reader_options)
+        -> std::shared_ptr<KeyProjection>;
+
+auto get_key_projection_from_reader_options(ReaderOptions const& reader_options)
+        -> std::shared_ptr<KeyProjection> {
+    auto const projection_keys{reader_options[cReaderOptionsProjectionKeysKey.data()]};
+    if (projection_keys.isNull() || projection_keys.isUndefined()) {
+        return nullptr;
+    }
+
+    std::vector<KeyProjection::KeyPath> key_paths;
+    for (auto const& projection_key : emscripten::vecFromJSArray<emscripten::val>(projection_keys))
+    {
+        key_paths.push_back(
+                {projection_key[cFilterOptionIsAutoGeneratedKey.data()].as<bool>(),
+                 emscripten::vecFromJSArray<std::string>(
+                         projection_key[cFilterOptionPartsKey.data()]
+                 )}
+        );
+    }
+    return std::make_shared<KeyProjection>(std::move(key_paths));
 }
-}  // namespace
 
-auto StructuredIrStreamReader::create(
-        std::unique_ptr<ZstdDecompressor>&& zstd_decompressor,
-        ystdlib::containers::Array<char> data_array,
+/**
+ * Creates a deserializer for the IR stream.
+ * @param reader
+ * @param ir_unit_handler
+ * @return The created deserializer.
+ * @throw ClpFfiJsException if any error occurs.
+ */
+[[nodiscard]] auto
+create_deserializer(clp::ReaderInterface& reader, StructuredIrUnitHandler ir_unit_handler)
+        -> StructuredIrDeserializer;
+
+/**
+ * Creates a deserializer for the IR stream that extracts the filter data selected by the reader
+ * options.
+ * @param reader
+ * @param deserialized_log_events The collection in which the deserializer should store log events.
+ * @param key_projection The key projection to resolve as schema-tree nodes are inserted, or nullptr
+ * if there's none.
+ * @param reader_options
+ * @return The created deserializer.
+ * @throw ClpFfiJsException if any error occurs.
+ */
+[[nodiscard]] auto create_deserializer(
+        clp::ReaderInterface& reader,
+        std::shared_ptr<StructuredLogEvents> const& deserialized_log_events,
+        std::shared_ptr<KeyProjection> const& key_projection,
         ReaderOptions const& reader_options
-) -> StructuredIrStreamReader {
-    auto deserialized_log_events{std::make_shared<StructuredLogEvents>()};
-    auto result{StructuredIrDeserializer::create(
-            *zstd_decompressor,
+) -> StructuredIrDeserializer;
+
+auto create_deserializer(clp::ReaderInterface& reader, StructuredIrUnitHandler ir_unit_handler)
+        -> StructuredIrDeserializer {
+    auto result{StructuredIrDeserializer::create(reader, std::move(ir_unit_handler))};
+    if (result.has_error()) {
+        auto const error_code{result.error()};
+        throw ClpFfiJsException{
+                clp::ErrorCode::ErrorCode_Failure,
+                __FILENAME__,
+                __LINE__,
+                std::format(
+                        "Failed to create deserializer: {} {}",
+                        error_code.category().name(),
+                        error_code.message()
+                )
+        };
+    }
+    return std::move(result.value());
+}
+
+auto create_deserializer(
+        clp::ReaderInterface& reader,
+        std::shared_ptr<StructuredLogEvents> const& deserialized_log_events,
+        std::shared_ptr<KeyProjection> const& key_projection,
+        ReaderOptions const& reader_options
+) -> StructuredIrDeserializer {
+    return create_deserializer(
+            reader,
             StructuredIrUnitHandler{
                     deserialized_log_events,
                     get_schema_tree_full_branch_from_filter_option(
@@ -104,28 +180,198 @@ auto StructuredIrStreamReader::create(
                     get_schema_tree_full_branch_from_filter_option(
                             reader_options[cReaderOptionsUtcOffsetKey.data()],
                             clp::ffi::SchemaTree::Node::Type::Int
-                    )
+                    ),
+                    key_projection
             }
+    );
+}
+
+/**
+ * Creates a window decoder whose deserializers only buffer the log event being decoded, without
+ * extracting any filter data.
+ * @param checkpoint_index
+ * @return The created window decoder.
+ */
+[[nodiscard]] auto create_window_decoder(CheckpointIndex checkpoint_index)
+        -> std::unique_ptr<StructuredLogEventWindowDecoder>;
+
+auto create_window_decoder(CheckpointIndex checkpoint_index)
+        -> std::unique_ptr<StructuredLogEventWindowDecoder> {
+    auto decoded_log_events{std::make_shared<StructuredLogEvents>()};
+
+    auto create_window_deserializer = [decoded_log_events](clp::ReaderInterface& reader) {
+        return create_deserializer(
+                reader,
+                StructuredIrUnitHandler{
+                        decoded_log_events,
+                        std::nullopt,
+                        std::nullopt,
+                        std::nullopt
+                }
+        );
+    };
+
+    auto deserialize_log_event = [decoded_log_events](
+                                         StructuredIrDeserializer& deserializer,
+                                         clp::ReaderInterface& reader
+                                 ) -> StructuredLogEvent {
+        while (decoded_log_events->empty()) {
+            if (deserializer.is_stream_completed()) {
+                throw ClpFfiJsException{
+                        clp::ErrorCode::ErrorCode_Corrupt,
+                        __FILENAME__,
+                        __LINE__,
+                        "The IR stream ended before the log event."
+                };
+            }
+            auto const result{deserializer.deserialize_next_ir_unit(reader)};
+            if (result.has_error()) {
+                auto const error{result.error()};
+                throw ClpFfiJsException{
+                        clp::ErrorCode::ErrorCode_Corrupt,
+                        __FILENAME__,
+                        __LINE__,
+                        std::format(
+                                "Failed to deserialize IR unit: {}:{}",
+                                error.category().name(),
+                                error.message()
+                        )
+                };
+            }
+        }
+        auto log_event{std::move(decoded_log_events->get_log_event(0))};
+        decoded_log_events->clear();
+        return log_event;
+    };
+
+    return std::make_unique<StructuredLogEventWindowDecoder>(
+            std::move(checkpoint_index),
+            std::move(create_window_deserializer),
+            std::move(deserialize_log_event)
+    );
+}
+
+EMSCRIPTEN_BINDINGS(ClpStructuredIrStreamReader) {
+    emscripten::constant(
+            "MERGED_KV_PAIRS_AUTO_GENERATED_KEY",
+            std::string{cMergedKvPairsAutoGeneratedKey}
+    );
+    emscripten::constant(
+            "MERGED_KV_PAIRS_USER_GENERATED_KEY",
+            std::string{cMergedKvPairsUserGeneratedKey}
+    );
+}
+}  // namespace
+
+auto StructuredIrStreamReader::create(
+        std::unique_ptr<clp::ReaderInterface>&& reader,
+        std::vector<char> data_array,
+        ReaderOptions const& reader_options
+) -> StructuredIrStreamReader {
+    auto deserialized_log_events{std::make_shared<StructuredLogEvents>()};
+    auto key_projection{get_key_projection_from_reader_options(reader_options)};
+    auto deserializer{create_deserializer(
+            *reader,
+            deserialized_log_events,
+            key_projection,
+            reader_options
     )};
-    if (result.has_error()) {
-        auto const error_code{result.error()};
-        throw ClpFfiJsException{
-                clp::ErrorCode::ErrorCode_Failure,
-                __FILENAME__,
-                __LINE__,
-                std::format(
-                        "Failed to create deserializer: {} {}",
-                        error_code.category().name(),
-                        error_code.message()
-                )
-        };
-    }
     StreamReaderDataContext<StructuredIrDeserializer> data_context{
             std::move(data_array),
-            std::move(zstd_decompressor),
-            std::move(result.value())
+            std::move(reader),
+            std::move(deserializer)
+    };
+    return StructuredIrStreamReader{
+            std::move(data_context),
+            std::move(deserialized_log_events),
+            std::move(key_projection)
+    };
+}
+
+auto StructuredIrStreamReader::create(
+        std::unique_ptr<ChunkedZstdReader>&& chunked_reader,
+        ReaderOptions const& reader_options
+) -> StructuredIrStreamReader {
+    // In windowed mode, log events are decoded on demand, so only their filter data is stored.
+    auto const checkpoint_interval{get_checkpoint_interval(reader_options)};
+    auto deserialized_log_events{
+            std::make_shared<StructuredLogEvents>(false == checkpoint_interval.has_value())
+    };
+    auto key_projection{get_key_projection_from_reader_options(reader_options)};
+    auto deserializer{create_deserializer(
+            *chunked_reader,
+            deserialized_log_events,
+            key_projection,
+            reader_options
+    )};
+
+    std::unique_ptr<StructuredLogEventWindowDecoder> window_decoder;
+    if (checkpoint_interval.has_value()) {
+        window_decoder = create_window_decoder(
+                CheckpointIndex::create(checkpoint_interval.value(), *chunked_reader)
+        );
+    }
+
+    chunked_reader->checkpoint();
+    StreamReaderDataContext<StructuredIrDeserializer> data_context{
+            std::move(chunked_reader),
+            std::move(deserializer)
+    };
+    return StructuredIrStreamReader{
+            std::move(data_context),
+            std::move(deserialized_log_events),
+            std::move(key_projection),
+            std::move(window_decoder)
     };
-    return StructuredIrStreamReader{std::move(data_context), std::move(deserialized_log_events)};
+}
+
+auto StructuredIrStreamReader::create_from_snapshot(
+        std::unique_ptr<ChunkedZstdReader>&& chunked_reader,
+        SnapshotReader& snapshot_reader,
+        ReaderOptions const& reader_options
+) -> StructuredIrStreamReader {
+    auto const num_bytes_consumed{snapshot_reader.read_size()};
+    auto deserialized_log_events{std::make_shared<StructuredLogEvents>(false)};
+    deserialized_log_events->read_filter_data_snapshot(snapshot_reader);
+    auto checkpoint_index{CheckpointIndex::read_snapshot(snapshot_reader)};
+
+    auto key_projection{get_key_projection_from_reader_options(reader_options)};
+    auto deserializer{create_deserializer(
+            *chunked_reader,
+            deserialized_log_events,
+            key_projection,
+            reader_options
+    )};
+
+    // Replay the schema-tree node insertions, so that the deserializer's schema trees (and the key
+    // projection resolved against them) are the same as after deserializing the entire stream.
+    auto const replay_units{checkpoint_index.get_replay_units()};
+    GrowableBufferReader replay_reader{std::vector<char>(replay_units.begin(), replay_units.end())};
+    while (replay_reader.get_pos() < replay_units.size()) {
+        auto const result{deserializer.deserialize_next_ir_unit(replay_reader)};
+        if (result.has_error()) {
+            auto const error{result.error()};
+            throw_corrupt_snapshot(std::format(
+                    "Failed to replay the snapshot's IR units: {}:{}",
+                    error.category().name(),
+                    error.message()
+            ));
+        }
+    }
+
+    StreamReaderDataContext<StructuredIrDeserializer> data_context{
+            std::move(chunked_reader),
+            std::move(deserializer)
+    };
+    StructuredIrStreamReader stream_reader{
+            std::move(data_context),
+            std::move(deserialized_log_events),
+            std::move(key_projection),
+            create_window_decoder(std::move(checkpoint_index))
+    };
+    stream_reader.m_num_bytes_consumed = num_bytes_consumed;
+    stream_reader.m_is_stream_exhausted = true;
+    return stream_reader;
 }
 
 auto StructuredIrStreamReader::get_metadata() const -> MetadataTsType {
@@ -141,7 +387,7 @@ auto StructuredIrStreamReader::get_filtered_log_event_map() const -> FilteredLog
         return FilteredLogEventMapTsType{emscripten::val::null()};
     }
 
-    return FilteredLogEventMapTsType{emscripten::val::array(m_filtered_log_event_map.value())};
+    return FilteredLogEventMapTsType{to_js_array(m_filtered_log_event_map.value())};
 }
 
 void StructuredIrStreamReader::filter_log_events(
@@ -149,113 +395,326 @@ void StructuredIrStreamReader::filter_log_events(
         std::string const& kql_filter
 ) {
     m_filtered_log_event_map.reset();
-
-    if (false == kql_filter.empty()) {
-        auto& reader{m_stream_reader_data_context->get_reader()};
-        reader.seek_from_begin(0);
-        m_filtered_log_event_map.emplace(collect_matched_log_event_indices(reader, kql_filter));
+    m_log_event_filter = create_log_event_filter(log_level_filter, kql_filter);
+    if (false == m_log_event_filter.has_value()) {
+        return;
     }
+    m_filtered_log_event_map.emplace();
+    try {
+        extend_filtered_log_events(0);
+    } catch (...) {
+        // Don't keep applying a filter that can't be evaluated (e.g., an invalid query) to log
+        // events deserialized later.
+        m_log_event_filter.reset();
+        m_filtered_log_event_map.reset();
+        throw;
+    }
+}
 
-    if (false == log_level_filter.isNull()) {
-        std::vector<size_t> filtered_log_event_map;
-
-        auto const filter_levels{
-                emscripten::vecFromJSArray<std::underlying_type_t<LogLevel>>(log_level_filter)
-        };
+void StructuredIrStreamReader::set_format_template(std::string const& pattern) {
+    if (pattern.empty()) {
+        m_format_template.reset();
+    } else {
+        m_format_template.emplace(FormatTemplate::compile(pattern));
+    }
+    // Cached messages were rendered with the previous template.
+    clear_decoded_message_cache();
+}
 
-        auto filter_and_collect_idx = [&](size_t const log_event_idx) {
-            auto const& log_event{m_deserialized_log_events->at(log_event_idx)};
-            if (std::ranges::find(
-                        filter_levels,
-                        clp::enum_to_underlying_type(log_event.get_log_level())
-                )
-                != filter_levels.end())
-            {
-                filtered_log_event_map.emplace_back(log_event_idx);
-            }
-        };
+auto StructuredIrStreamReader::deserialize_within_budget(DeserializationBudget const& budget)
+        -> bool {
+    if (nullptr == m_stream_reader_data_context || m_is_stream_exhausted) {
+        return true;
+    }
 
-        if (m_filtered_log_event_map.has_value()) {
-            for (auto const log_event_idx : m_filtered_log_event_map.value()) {
-                filter_and_collect_idx(log_event_idx);
-            }
-        } else {
-            for (size_t log_event_idx{0}; log_event_idx < m_deserialized_log_events->size();
-                 ++log_event_idx)
-            {
-                filter_and_collect_idx(log_event_idx);
-            }
-        }
+    constexpr size_t cDefaultNumReservedLogEvents{500'000};
+    auto& deserializer = m_stream_reader_data_context->get_deserializer();
+    auto& reader{m_stream_reader_data_context->get_reader()};
+    m_deserialized_log_events->reserve(cDefaultNumReservedLogEvents);
 
-        m_filtered_log_event_map = std::move(filtered_log_event_map);
-    }
+    auto const begin_num_events{m_deserialized_log_events->size()};
+    auto const begin_pos{reader.get_pos()};
+    auto const should_pause = [&]() {
+        return m_deserialized_log_events->size() - begin_num_events >= budget.max_num_events
+               || reader.get_pos() - begin_pos >= budget.max_num_bytes;
+    };
 
-    if (m_filtered_log_event_map.has_value()
-        && m_filtered_log_event_map->size() == m_deserialized_log_events->size())
+    if (nullptr != m_window_decoder) {
+        auto& chunked_reader{*m_stream_reader_data_context->get_chunked_reader()};
+        auto& checkpoint_index{m_window_decoder->get_checkpoint_index()};
+        checkpoint_index.add_checkpoint_if_due(
+                m_deserialized_log_events->size(),
+                chunked_reader.get_pos()
+        );
+        m_is_stream_exhausted = deserialize_available_log_events(
+                deserializer,
+                chunked_reader,
+                [&](clp::ffi::ir_stream::IrUnitType ir_unit_type) {
+                    if (clp::ffi::ir_stream::IrUnitType::SchemaTreeNodeInsertion == ir_unit_type) {
+                        // Resuming from any later checkpoint requires the inserted node.
+                        checkpoint_index.add_replay_unit(
+                                chunked_reader.get_bytes_since_checkpoint()
+                        );
+                    }
+                    checkpoint_index.add_checkpoint_if_due(
+                            m_deserialized_log_events->size(),
+                            chunked_reader.get_pos()
+                    );
+                },
+                should_pause
+        );
+    } else if (auto* const chunked_reader{m_stream_reader_data_context->get_chunked_reader()};
+               nullptr != chunked_reader)
     {
-        m_filtered_log_event_map = std::nullopt;
+        m_is_stream_exhausted = deserialize_available_log_events(
+                deserializer,
+                *chunked_reader,
+                []([[maybe_unused]] clp::ffi::ir_stream::IrUnitType ir_unit_type) {},
+                should_pause
+        );
+    } else {
+        m_is_stream_exhausted = deserialize_log_events(deserializer, reader, should_pause);
     }
+    m_num_bytes_consumed = reader.get_pos();
+    return m_is_stream_exhausted;
 }
 
-auto StructuredIrStreamReader::deserialize_stream() -> size_t {
-    if (nullptr == m_stream_reader_data_context) {
-        return m_deserialized_log_events->size();
+auto StructuredIrStreamReader::extend_filtered_log_events(size_t begin_idx) -> void {
+    if (false == m_log_event_filter.has_value()) {
+        return;
     }
 
-    constexpr size_t cDefaultNumReservedLogEvents{500'000};
-    m_deserialized_log_events->reserve(cDefaultNumReservedLogEvents);
-    auto& reader{m_stream_reader_data_context->get_reader()};
-    auto& deserializer = m_stream_reader_data_context->get_deserializer();
+    auto const& query{m_log_event_filter->query};
+    std::vector<size_t> matched_log_event_indices;
+    if (false == query.empty() && nullptr == m_window_decoder) {
+        matched_log_event_indices
+                = collect_matched_log_event_indices(*m_deserialized_log_events, query, begin_idx);
+    } else if (false == query.empty()) {
+        // Windowed mode doesn't buffer log events, so decode the new log events from the
+        // checkpoint before `begin_idx`, which also rebuilds the schema trees the query's columns
+        // are resolved against.
+        auto const compressed_data{m_stream_reader_data_context->get_compressed_data()};
+        matched_log_event_indices = collect_matched_log_event_indices(
+                [&](size_t log_event_idx) {
+                    return m_window_decoder->decode(compressed_data, log_event_idx);
+                },
+                query,
+                begin_idx,
+                get_num_events_buffered()
+        );
+    }
 
-    deserialize_log_events(deserializer, reader);
-    return m_deserialized_log_events->size();
+    generic_extend_filtered_log_events(
+            m_filtered_log_event_map.value(),
+            m_log_event_filter.value(),
+            m_deserialized_log_events->get_filter_columns(),
+            begin_idx,
+            matched_log_event_indices
+    );
+}
+
+auto StructuredIrStreamReader::write_snapshot(SnapshotWriter& writer) const -> void {
+    if (nullptr == m_window_decoder || false == m_is_stream_exhausted) {
+        throw ClpFfiJsException{
+                clp::ErrorCode::ErrorCode_Unsupported,
+                __FILENAME__,
+                __LINE__,
+                "Only readers in windowed mode that have deserialized the entire stream can be"
+                " snapshotted."
+        };
+    }
+    write_snapshot_header(writer, m_stream_reader_data_context->get_compressed_data());
+    writer.write_size(m_num_bytes_consumed);
+    m_deserialized_log_events->write_filter_data_snapshot(writer);
+    m_window_decoder->get_checkpoint_index().write_snapshot(writer);
 }
 
 auto StructuredIrStreamReader::decode_range(size_t begin_idx, size_t end_idx, bool use_filter) const
         -> DecodedResultsTsType {
-    auto log_event_to_string = [](StructuredLogEvent const& log_event) -> std::string {
-        auto json_pair_result{log_event.serialize_to_json()};
-        if (json_pair_result.has_error()) {
-            auto const error_code{json_pair_result.error()};
-            // NOLINTBEGIN(bugprone-lambda-function-name)
-            SPDLOG_ERROR(
-                    "Failed to deserialize log event to JSON: {}:{}",
-                    error_code.category().name(),
-                    error_code.message()
-            );
-            // NOLINTEND(bugprone-lambda-function-name)
-            return std::string{cEmptyJsonStr};
-        }
-
-        auto& [auto_generated, user_generated] = json_pair_result.value();
-        nlohmann::json const merged_kv_pairs
-                = {{std::string{cMergedKvPairsAutoGeneratedKey}, std::move(auto_generated)},
-                   {std::string{cMergedKvPairsUserGeneratedKey}, std::move(user_generated)}};
-        return dump_json_with_replace(merged_kv_pairs);
-    };
-
     return generic_decode_range(
             begin_idx,
             end_idx,
             m_filtered_log_event_map,
-            *m_deserialized_log_events,
-            log_event_to_string,
+            m_deserialized_log_events->get_filter_columns(),
+            [this](size_t log_event_idx) -> std::string {
+                std::string message;
+                append_rendered_message(log_event_idx, message);
+                return message;
+            },
+            use_filter
+    );
+}
+
+auto StructuredIrStreamReader::decode_range_binary(
+        size_t begin_idx,
+        size_t end_idx,
+        bool use_filter
+) const -> DecodedResultsBinaryTsType {
+    return generic_decode_range_binary(
+            begin_idx,
+            end_idx,
+            m_filtered_log_event_map,
+            m_deserialized_log_events->get_filter_columns(),
+            [this](size_t log_event_idx, std::string& output) {
+                append_rendered_message(log_event_idx, output);
+            },
             use_filter
     );
 }
 
+auto StructuredIrStreamReader::get_time_histogram(
+        clp::ir::epoch_time_ms_t begin_ts,
+        clp::ir::epoch_time_ms_t end_ts,
+        size_t num_buckets,
+        bool use_filter,
+        bool split_by_log_level
+) const -> TimeHistogramTsType {
+    return generic_get_time_histogram(
+            begin_ts,
+            end_ts,
+            num_buckets,
+            m_filtered_log_event_map,
+            m_deserialized_log_events->get_filter_columns(),
+            use_filter,
+            split_by_log_level
+    );
+}
+
 auto StructuredIrStreamReader::find_nearest_log_event_by_timestamp(
         clp::ir::epoch_time_ms_t const target_ts
 ) -> NullableLogEventIdx {
-    return generic_find_nearest_log_event_by_timestamp(*m_deserialized_log_events, target_ts);
+    return generic_find_nearest_log_event_by_timestamp(
+            m_deserialized_log_events->get_filter_columns(),
+            target_ts
+    );
+}
+
+auto StructuredIrStreamReader::get_chunked_reader() const -> ChunkedZstdReader* {
+    if (m_is_stream_exhausted
+        || m_stream_reader_data_context->get_deserializer().is_stream_completed())
+    {
+        return nullptr;
+    }
+    return m_stream_reader_data_context->get_chunked_reader();
+}
+
+auto StructuredIrStreamReader::append_decoded_message(
+        size_t log_event_idx,
+        std::string& output
+) const -> void {
+    output.push_back('{');
+    append_decoded_message_members(log_event_idx, output);
+    output.push_back('}');
+}
+
+auto StructuredIrStreamReader::append_exported_line(
+        size_t log_event_idx,
+        std::optional<std::string_view> timestamp,
+        std::string& output
+) const -> void {
+    if (false == timestamp.has_value()) {
+        append_decoded_message(log_event_idx, output);
+        return;
+    }
+
+    output.push_back('{');
+    StructuredLogEventJsonWriter::append_string(cExportedTimestampKey, output);
+    output.push_back(':');
+    StructuredLogEventJsonWriter::append_string(timestamp.value(), output);
+    auto const separator_pos{output.size()};
+    output.push_back(',');
+    append_decoded_message_members(log_event_idx, output);
+    if (separator_pos + 1 == output.size()) {
+        output.pop_back();
+    }
+    output.push_back('}');
+}
+
+auto StructuredIrStreamReader::append_decoded_message_members(
+        size_t log_event_idx,
+        std::string& output
+) const -> void {
+    auto append_members = [&](StructuredLogEvent const& log_event) {
+        // `nlohmann::json` objects are ordered by key, so the auto-generated kv-pairs come first.
+        auto const original_size{output.size()};
+        StructuredLogEventJsonWriter::append_string(cMergedKvPairsAutoGeneratedKey, output);
+        output.push_back(':');
+        bool is_serialized{m_json_writer.append_kv_pairs(
+                *log_event.get_auto_gen_keys_schema_tree(),
+                log_event.get_auto_gen_node_id_value_pairs(),
+                output,
+                nullptr != m_key_projection ? &m_key_projection->get_projected_nodes(true)
+                                            : nullptr
+        )};
+        if (is_serialized) {
+            output.push_back(',');
+            StructuredLogEventJsonWriter::append_string(cMergedKvPairsUserGeneratedKey, output);
+            output.push_back(':');
+            is_serialized = m_json_writer.append_kv_pairs(
+                    *log_event.get_user_gen_keys_schema_tree(),
+                    log_event.get_user_gen_node_id_value_pairs(),
+                    output,
+                    nullptr != m_key_projection ? &m_key_projection->get_projected_nodes(false)
+                                                : nullptr
+            );
+        }
+        if (false == is_serialized) {
+            // NOLINTNEXTLINE(bugprone-lambda-function-name)
+            SPDLOG_ERROR("Failed to serialize log event to JSON.");
+            output.resize(original_size);
+        }
+    };
+
+    if (nullptr != m_window_decoder) {
+        append_members(m_window_decoder->decode(
+                m_stream_reader_data_context->get_compressed_data(),
+                log_event_idx
+        ));
+        return;
+    }
+    append_members(m_deserialized_log_events->get_log_event(log_event_idx));
+}
+
+auto StructuredIrStreamReader::append_rendered_message(
+        size_t log_event_idx,
+        std::string& output
+) const -> void {
+    if (false == m_format_template.has_value()) {
+        append_decoded_message(log_event_idx, output);
+        return;
+    }
+
+    auto const& filter_columns{m_deserialized_log_events->get_filter_columns()};
+    auto append_rendered_log_event = [&](StructuredLogEvent const& log_event) {
+        m_format_template->append_rendered_log_event(
+                log_event,
+                filter_columns.get_log_level(log_event_idx),
+                filter_columns.get_timestamp(log_event_idx),
+                filter_columns.get_utc_offset(log_event_idx),
+                output
+        );
+    };
+
+    if (nullptr != m_window_decoder) {
+        append_rendered_log_event(m_window_decoder->decode(
+                m_stream_reader_data_context->get_compressed_data(),
+                log_event_idx
+        ));
+        return;
+    }
+    append_rendered_log_event(m_deserialized_log_events->get_log_event(log_event_idx));
 }
 
 StructuredIrStreamReader::StructuredIrStreamReader(
         StreamReaderDataContext<StructuredIrDeserializer>&& stream_reader_data_context,
-        std::shared_ptr<StructuredLogEvents> deserialized_log_events
+        std::shared_ptr<StructuredLogEvents> deserialized_log_events,
+        std::shared_ptr<KeyProjection> key_projection,
+        std::unique_ptr<StructuredLogEventWindowDecoder> window_decoder
 )
         : m_metadata(stream_reader_data_context.get_deserializer().get_metadata()),
           m_deserialized_log_events{std::move(deserialized_log_events)},
+          m_key_projection{std::move(key_projection)},
+          m_window_decoder{std::move(window_decoder)},
           m_stream_reader_data_context{
                   std::make_unique<StreamReaderDataContext<StructuredIrDeserializer>>(
                           std::move(stream_reader_data_context)
@@ -4,23 +4,35 @@
 #include <cstddef>
 #include <memory>
 #include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
 
 #include <clp/ffi/ir_stream/Deserializer.hpp>
 #include <clp/ffi/SchemaTree.hpp>
 #include <clp/ir/types.hpp>
+#include <clp/ReaderInterface.hpp>
 #include <emscripten/val.h>
 #include <nlohmann/json.hpp>
-#include <ystdlib/containers/Array.hpp>
 
-#include <clp_ffi_js/ir/LogEventWithFilterData.hpp>
+#include <clp_ffi_js/ir/ChunkedZstdReader.hpp>
+#include <clp_ffi_js/ir/FormatTemplate.hpp>
+#include <clp_ffi_js/ir/KeyProjection.hpp>
+#include <clp_ffi_js/ir/LogEventWindowDecoder.hpp>
+#include <clp_ffi_js/ir/LogEventFilterColumns.hpp>
+#include <clp_ffi_js/ir/LogEvents.hpp>
+#include <clp_ffi_js/ir/Snapshot.hpp>
 #include <clp_ffi_js/ir/StreamReader.hpp>
 #include <clp_ffi_js/ir/StreamReaderDataContext.hpp>
 #include <clp_ffi_js/ir/StructuredIrUnitHandler.hpp>
+#include <clp_ffi_js/ir/StructuredLogEventJsonWriter.hpp>
 
 namespace clp_ffi_js::ir {
 using schema_tree_node_id_t = std::optional<clp::ffi::SchemaTree::Node::id_t>;
 using StructuredIrDeserializer = clp::ffi::ir_stream::Deserializer<StructuredIrUnitHandler>;
 using StructuredLogEvents = LogEvents<StructuredLogEvent>;
+using StructuredLogEventWindowDecoder
+        = LogEventWindowDecoder<StructuredIrDeserializer, StructuredLogEvent>;
 
 /**
  * Class to deserialize and decode Zstd-compressed CLP structured IR streams, as well as format
@@ -29,15 +41,41 @@ using StructuredLogEvents = LogEvents<StructuredLogEvent>;
 class StructuredIrStreamReader : public StreamReader {
 public:
     /**
-     * @param zstd_decompressor A decompressor for an IR stream.
-     * @param data_array The array backing `zstd_decompressor`.
+     * @param reader A reader for a decompressed IR stream.
+     * @param data_array The array of compressed bytes backing `reader`.
      * @param reader_options
      * @return The created instance.
      * @throw ClpFfiJsException if any error occurs.
      */
     [[nodiscard]] static auto create(
-            std::unique_ptr<ZstdDecompressor>&& zstd_decompressor,
-            ystdlib::containers::Array<char> data_array,
+            std::unique_ptr<clp::ReaderInterface>&& reader,
+            std::vector<char> data_array,
+            ReaderOptions const& reader_options
+    ) -> StructuredIrStreamReader;
+
+    /**
+     * @param chunked_reader A reader for an IR stream that's appended in chunks.
+     * @param reader_options
+     * @return The created instance, in windowed mode if `reader_options` enables it (see
+     * `StreamReader::get_checkpoint_interval`).
+     * @throw ClpFfiJsException if any error occurs.
+     */
+    [[nodiscard]] static auto create(
+            std::unique_ptr<ChunkedZstdReader>&& chunked_reader,
+            ReaderOptions const& reader_options
+    ) -> StructuredIrStreamReader;
+
+    /**
+     * @param chunked_reader A reader for the IR stream the snapshot was serialized from, with its
+     * end of input marked.
+     * @param snapshot_reader A reader positioned after the snapshot's header.
+     * @param reader_options
+     * @return The created instance, in windowed mode.
+     * @throw ClpFfiJsException if the snapshot is invalid or any other error occurs.
+     */
+    [[nodiscard]] static auto create_from_snapshot(
+            std::unique_ptr<ChunkedZstdReader>&& chunked_reader,
+            SnapshotReader& snapshot_reader,
             ReaderOptions const& reader_options
     ) -> StructuredIrStreamReader;
 
@@ -68,33 +106,123 @@ public:
             std::string const& kql_filter
     ) override;
 
+    void set_format_template(std::string const& pattern) override;
+
+    [[nodiscard]] auto decode_range(size_t begin_idx, size_t end_idx, bool use_filter) const
+            -> DecodedResultsTsType override;
+
+    [[nodiscard]] auto
+    decode_range_binary(size_t begin_idx, size_t end_idx, bool use_filter) const
+            -> DecodedResultsBinaryTsType override;
+
+    [[nodiscard]] auto get_time_histogram(
+            clp::ir::epoch_time_ms_t begin_ts,
+            clp::ir::epoch_time_ms_t end_ts,
+            size_t num_buckets,
+            bool use_filter,
+            bool split_by_log_level
+    ) const -> TimeHistogramTsType override;
+
+    [[nodiscard]] auto find_nearest_log_event_by_timestamp(clp::ir::epoch_time_ms_t target_ts)
+            -> NullableLogEventIdx override;
+
+protected:
+    [[nodiscard]] auto get_chunked_reader() const -> ChunkedZstdReader* override;
+
     /**
-     * @see StreamReader::deserialize_stream
+     * @see StreamReader::deserialize_within_budget
      *
      * After the stream has been exhausted, it will be deallocated.
      *
-     * @return @see StreamReader::deserialize_stream
+     * @return @see StreamReader::deserialize_within_budget
      */
-    [[nodiscard]] auto deserialize_stream() -> size_t override;
+    [[nodiscard]] auto deserialize_within_budget(DeserializationBudget const& budget)
+            -> bool override;
 
-    [[nodiscard]] auto decode_range(size_t begin_idx, size_t end_idx, bool use_filter) const
-            -> DecodedResultsTsType override;
+    [[nodiscard]] auto get_num_bytes_consumed() const -> size_t override {
+        return m_num_bytes_consumed;
+    }
 
-    [[nodiscard]] auto find_nearest_log_event_by_timestamp(clp::ir::epoch_time_ms_t target_ts)
-            -> NullableLogEventIdx override;
+    [[nodiscard]] auto get_filter_columns() const -> LogEventFilterColumns const& override {
+        return m_deserialized_log_events->get_filter_columns();
+    }
+
+    [[nodiscard]] auto get_filtered_log_event_indices() const
+            -> FilteredLogEventsMap const& override {
+        return m_filtered_log_event_map;
+    }
+
+    /**
+     * @see StreamReader::extend_filtered_log_events
+     *
+     * In windowed mode, since log events aren't buffered, a query is evaluated by decoding the log
+     * events from `begin_idx` onwards, resuming from the checkpoint before it.
+     */
+    auto extend_filtered_log_events(size_t begin_idx) -> void override;
+
+    auto write_snapshot(SnapshotWriter& writer) const -> void override;
+
+    auto append_decoded_message(size_t log_event_idx, std::string& output) const -> void override;
+
+    /**
+     * @see StreamReader::append_exported_line
+     *
+     * The timestamp, if any, is added as the first kv-pair of the log event's JSON object.
+     */
+    auto append_exported_line(
+            size_t log_event_idx,
+            std::optional<std::string_view> timestamp,
+            std::string& output
+    ) const -> void override;
 
 private:
     // Constructor
     explicit StructuredIrStreamReader(
             StreamReaderDataContext<StructuredIrDeserializer>&& stream_reader_data_context,
-            std::shared_ptr<StructuredLogEvents> deserialized_log_events
+            std::shared_ptr<StructuredLogEvents> deserialized_log_events,
+            std::shared_ptr<KeyProjection> key_projection,
+            std::unique_ptr<StructuredLogEventWindowDecoder> window_decoder = nullptr
     );
 
+    // Methods
+    /**
+     * Appends the members of the log event's JSON object at the given index (i.e., its decoded
+     * message without the enclosing braces) to `output`. If the log event can't be serialized, no
+     * members are appended.
+     *
+     * @param log_event_idx
+     * @param output
+     */
+    auto append_decoded_message_members(size_t log_event_idx, std::string& output) const -> void;
+
+    /**
+     * Renders the log event at the given index with the format template if one is set, or decodes
+     * its message otherwise, and appends the result to `output`.
+     *
+     * @param log_event_idx
+     * @param output
+     * @throw ClpFfiJsException if the message cannot be decoded.
+     */
+    auto append_rendered_message(size_t log_event_idx, std::string& output) const -> void;
+
     // Variables
     nlohmann::json m_metadata;
+    // In windowed mode, only the log events' filter data is buffered, and `m_window_decoder`
+    // decodes log events on demand.
     std::shared_ptr<StructuredLogEvents> m_deserialized_log_events;
+    // Resolved by the deserializer as schema-tree nodes are inserted. nullptr if decoded log events
+    // include all kv-pairs.
+    std::shared_ptr<KeyProjection> m_key_projection;
+    std::unique_ptr<StructuredLogEventWindowDecoder> m_window_decoder;
     std::unique_ptr<StreamReaderDataContext<StructuredIrDeserializer>> m_stream_reader_data_context;
+    bool m_is_stream_exhausted{false};
+    size_t m_num_bytes_consumed{0};
+    std::optional<LogEventFilter> m_log_event_filter;
     FilteredLogEventsMap m_filtered_log_event_map;
+    // Only holds scratch buffers, so it's mutable to allow decoding in const methods.
+    mutable StructuredLogEventJsonWriter m_json_writer;
+    // Mutable since rendering only resolves key paths and caches formatted timestamps.
+    mutable std::optional<FormatTemplate> m_format_template;
 };
 }  // namespace clp_ffi_js::ir
 
@@ -20,7 +20,8 @@
 #include <spdlog/spdlog.h>
 
 #include <clp_ffi_js/constants.hpp>
-#include <clp_ffi_js/ir/LogEventWithFilterData.hpp>
+#include <clp_ffi_js/ir/KeyProjection.hpp>
+#include <clp_ffi_js/ir/LogEvents.hpp>
 
 namespace clp_ffi_js::ir {
 namespace {
@@ -199,6 +200,10 @@ auto StructuredIrUnitHandler::handle_schema_tree_node_insertion(
         }
     }
 
+    if (nullptr != m_key_projection) {
+        m_key_projection->handle_node_insertion(is_auto_generated, *schema_tree, inserted_node_id);
+    }
+
     return clp::ffi::ir_stream::IRErrorCode::IRErrorCode_Success;
 }
 
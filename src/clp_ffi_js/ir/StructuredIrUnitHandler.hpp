@@ -15,7 +15,8 @@
 #include <clp/time_types.hpp>
 
 #include <clp_ffi_js/constants.hpp>
-#include <clp_ffi_js/ir/LogEventWithFilterData.hpp>
+#include <clp_ffi_js/ir/KeyProjection.hpp>
+#include <clp_ffi_js/ir/LogEvents.hpp>
 
 namespace clp_ffi_js::ir {
 /**
@@ -84,21 +85,24 @@ public:
 
     // Constructors
     /**
-     * @param deserialized_log_events The vector in which to store deserialized log events.
+     * @param deserialized_log_events The collection in which to store deserialized log events.
      * @param log_level_full_branch A schema tree full branch for the authoritative log level.
      * @param timestamp_full_branch A schema tree full branch for the authoritative timestamp.
+     * @param key_projection The key projection to resolve as nodes are inserted, or nullptr if
+     * there's none.
      */
     StructuredIrUnitHandler(
-            std::shared_ptr<std::vector<LogEventWithFilterData<StructuredLogEvent>>>
-                    deserialized_log_events,
+            std::shared_ptr<LogEvents<StructuredLogEvent>> deserialized_log_events,
             std::optional<SchemaTreeFullBranch> log_level_full_branch,
             std::optional<SchemaTreeFullBranch> timestamp_full_branch,
-            std::optional<SchemaTreeFullBranch> utc_offset_full_branch
+            std::optional<SchemaTreeFullBranch> utc_offset_full_branch,
+            std::shared_ptr<KeyProjection> key_projection = nullptr
     )
             : m_optional_log_level_full_branch{std::move(log_level_full_branch)},
               m_optional_timestamp_full_branch{std::move(timestamp_full_branch)},
               m_optional_utc_offset_full_branch{std::move(utc_offset_full_branch)},
-              m_deserialized_log_events{std::move(deserialized_log_events)} {}
+              m_deserialized_log_events{std::move(deserialized_log_events)},
+              m_key_projection{std::move(key_projection)} {}
 
     // Methods implementing `clp::ffi::ir_stream::IrUnitHandlerInterface`.
     /**
@@ -123,7 +127,7 @@ public:
 
     /**
      * Saves the node's ID if it corresponds to events' authoritative log level or timestamp
-     * kv-pair.
+     * kv-pair, and resolves whether the node is projected.
      * @param is_auto_generated
      * @param schema_tree_node_locator
      * @param schema_tree
@@ -186,8 +190,8 @@ private:
     // TODO: Technically, we don't need to use a `shared_ptr` since the parent stream reader will
     // have a longer lifetime than this class. Instead, we could use `gsl::not_null` once we add
     // `gsl` into the project.
-    std::shared_ptr<std::vector<LogEventWithFilterData<StructuredLogEvent>>>
-            m_deserialized_log_events;
+    std::shared_ptr<LogEvents<StructuredLogEvent>> m_deserialized_log_events;
+    std::shared_ptr<KeyProjection> m_key_projection;
 };
 }  // namespace clp_ffi_js::ir
 
@@ -0,0 +1,463 @@
+#include "StructuredLogEventJsonWriter.hpp"
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <clp/ffi/SchemaTree.hpp>
+#include <clp/ffi/Value.hpp>
+#include <nlohmann/json.hpp>
+
+#include <clp_ffi_js/utils.hpp>
+
+namespace clp_ffi_js::ir {
+namespace {
+constexpr std::string_view cUtf8ReplacementChar{"\xEF\xBF\xBD"};
+constexpr std::string_view cHexDigits{"0123456789abcdef"};
+// Same size as the buffer `nlohmann::json` formats numbers into.
+constexpr size_t cNumberBufferSize{64};
+// `nlohmann::json::dump` writes a float in scientific notation if the position of its decimal point
+// relative to its first significant digit is outside of `(cMinFloatPointPos, cMaxFloatPointPos]`.
+constexpr int cMinFloatPointPos{-4};
+constexpr int cMaxFloatPointPos{15};
+
+/**
+ * Determines the length of the UTF-8 sequence at the start of `str`, rejecting overlong encodings,
+ * surrogates, and code points above U+10FFFF.
+ * @param str A non-empty string.
+ * @param num_bytes Returns the length of the sequence if it's valid. Otherwise, returns the number
+ * of bytes that form the invalid sequence, excluding the first byte that doesn't belong to it
+ * (which may start another sequence).
+ * @return Whether the sequence is valid.
+ */
+[[nodiscard]] auto get_utf8_sequence_length(std::string_view str, size_t& num_bytes) -> bool;
+
+/**
+ * @tparam EncodedTextAst
+ * @param value
+ * @return The decoded string, or std::nullopt if it couldn't be decoded.
+ */
+template <typename EncodedTextAst>
+[[nodiscard]] auto decode_encoded_text_ast(clp::ffi::Value const& value)
+        -> std::optional<std::string>;
+
+/**
+ * @param value
+ * @return The decoded string if `value` is an encoded text AST that could be decoded.
+ * @return std::nullopt otherwise.
+ */
+[[nodiscard]] auto decode_as_encoded_text_ast(clp::ffi::Value const& value)
+        -> std::optional<std::string>;
+
+/**
+ * Appends `value` with the shortest digits that round-trip, in the notation `nlohmann::json::dump`
+ * uses.
+ * @param value
+ * @param output
+ */
+auto append_float(clp::ffi::value_float_t value, std::string& output) -> void;
+
+auto get_utf8_sequence_length(std::string_view str, size_t& num_bytes) -> bool {
+    constexpr uint8_t cContinuationMin{0x80};
+    constexpr uint8_t cContinuationMax{0xBF};
+
+    auto const lead{static_cast<uint8_t>(str.front())};
+    size_t length{0};
+    uint8_t second_byte_min{cContinuationMin};
+    uint8_t second_byte_max{cContinuationMax};
+    if (lead >= 0xC2 && lead <= 0xDF) {
+        length = 2;
+    } else if (lead >= 0xE0 && lead <= 0xEF) {
+        length = 3;
+        if (0xE0 == lead) {
+            second_byte_min = 0xA0;
+        } else if (0xED == lead) {
+            second_byte_max = 0x9F;
+        }
+    } else if (lead >= 0xF0 && lead <= 0xF4) {
+        length = 4;
+        if (0xF0 == lead) {
+            second_byte_min = 0x90;
+        } else if (0xF4 == lead) {
+            second_byte_max = 0x8F;
+        }
+    } else {
+        num_bytes = 1;
+        return false;
+    }
+
+    for (num_bytes = 1; num_bytes < length; ++num_bytes) {
+        if (num_bytes >= str.size()) {
+            return false;
+        }
+        auto const byte{static_cast<uint8_t>(str[num_bytes])};
+        auto const min{1 == num_bytes ? second_byte_min : cContinuationMin};
+        auto const max{1 == num_bytes ? second_byte_max : cContinuationMax};
+        if (byte < min || byte > max) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename EncodedTextAst>
+auto decode_encoded_text_ast(clp::ffi::Value const& value) -> std::optional<std::string> {
+    auto result{value.get_immutable_view<EncodedTextAst>().to_string()};
+    if (result.has_error()) {
+        return std::nullopt;
+    }
+    return std::move(result.value());
+}
+
+auto decode_as_encoded_text_ast(clp::ffi::Value const& value) -> std::optional<std::string> {
+    if (value.is<clp::ffi::FourByteEncodedTextAst>()) {
+        return decode_encoded_text_ast<clp::ffi::FourByteEncodedTextAst>(value);
+    }
+    if (value.is<clp::ffi::EightByteEncodedTextAst>()) {
+        return decode_encoded_text_ast<clp::ffi::EightByteEncodedTextAst>(value);
+    }
+    return std::nullopt;
+}
+
+auto append_float(clp::ffi::value_float_t value, std::string& output) -> void {
+    if (false == std::isfinite(value)) {
+        output.append("null");
+        return;
+    }
+    if (std::signbit(value)) {
+        output.push_back('-');
+        value = -value;
+    }
+    if (0.0 == value) {
+        output.append("0.0");
+        return;
+    }
+
+    // Format the shortest digits that round-trip in scientific notation (e.g., `1.25e+05`), and
+    // then lay them out like `nlohmann::json::dump` does.
+    std::array<char, cNumberBufferSize> buffer{};
+    auto const [end, error_code]{std::to_chars(
+            buffer.data(),
+            buffer.data() + buffer.size(),
+            value,
+            std::chars_format::scientific
+    )};
+    std::string_view const scientific{buffer.data(), static_cast<size_t>(end - buffer.data())};
+    auto const exponent_pos{scientific.find('e')};
+    std::string_view exponent_str{scientific.substr(exponent_pos + 1)};
+    if ('+' == exponent_str.front()) {
+        exponent_str.remove_prefix(1);
+    }
+    int exponent{0};
+    std::from_chars(exponent_str.data(), exponent_str.data() + exponent_str.size(), exponent);
+
+    std::array<char, cNumberBufferSize> digits{};
+    size_t num_digits{0};
+    for (auto const c : scientific.substr(0, exponent_pos)) {
+        if ('.' != c) {
+            digits[num_digits++] = c;
+        }
+    }
+    std::string_view const digits_str{digits.data(), num_digits};
+
+    // The value is 0.`digits_str` * 10^`point_pos`.
+    auto const num_digits_int{static_cast<int>(num_digits)};
+    auto const point_pos{exponent + 1};
+    if (num_digits_int <= point_pos && point_pos <= cMaxFloatPointPos) {
+        output.append(digits_str);
+        output.append(static_cast<size_t>(point_pos - num_digits_int), '0');
+        output.append(".0");
+        return;
+    }
+    if (0 < point_pos && point_pos <= cMaxFloatPointPos) {
+        output.append(digits_str.substr(0, static_cast<size_t>(point_pos)));
+        output.push_back('.');
+        output.append(digits_str.substr(static_cast<size_t>(point_pos)));
+        return;
+    }
+    if (cMinFloatPointPos < point_pos && point_pos <= 0) {
+        output.append("0.");
+        output.append(static_cast<size_t>(-point_pos), '0');
+        output.append(digits_str);
+        return;
+    }
+
+    // Otherwise, nlohmann also uses scientific notation, with a signed exponent of at least two
+    // digits.
+    output.append(scientific);
+}
+}  // namespace
+
+auto StructuredLogEventJsonWriter::append_kv_pairs(
+        clp::ffi::SchemaTree const& schema_tree,
+        NodeIdValuePairs const& node_id_value_pairs,
+        std::string& output,
+        std::vector<bool> const* projected_nodes
+) -> bool {
+    auto const original_size{output.size()};
+    mark_nodes_with_values(schema_tree, node_id_value_pairs, projected_nodes);
+    m_child_ids.clear();
+    if (false
+        == append_object(schema_tree, node_id_value_pairs, clp::ffi::SchemaTree::cRootId, output))
+    {
+        output.resize(original_size);
+        return false;
+    }
+    return true;
+}
+
+auto StructuredLogEventJsonWriter::append_string(std::string_view str, std::string& output)
+        -> void {
+    output.push_back('"');
+
+    // Bytes that don't need escaping are appended in runs.
+    size_t run_begin_idx{0};
+    size_t idx{0};
+    auto append_run = [&]() { output.append(str.substr(run_begin_idx, idx - run_begin_idx)); };
+    while (idx < str.size()) {
+        auto const byte{static_cast<uint8_t>(str[idx])};
+
+        if (byte >= 0x80) {
+            size_t num_bytes{0};
+            if (get_utf8_sequence_length(str.substr(idx), num_bytes)) {
+                idx += num_bytes;
+                continue;
+            }
+            append_run();
+            output.append(cUtf8ReplacementChar);
+            idx += num_bytes;
+            run_begin_idx = idx;
+            continue;
+        }
+
+        std::string_view escape_sequence;
+        switch (byte) {
+            case '\b':
+                escape_sequence = "\\b";
+                break;
+            case '\t':
+                escape_sequence = "\\t";
+                break;
+            case '\n':
+                escape_sequence = "\\n";
+                break;
+            case '\f':
+                escape_sequence = "\\f";
+                break;
+            case '\r':
+                escape_sequence = "\\r";
+                break;
+            case '"':
+                escape_sequence = "\\\"";
+                break;
+            case '\\':
+                escape_sequence = "\\\\";
+                break;
+            default:
+                break;
+        }
+        if (escape_sequence.empty() && byte > 0x1F) {
+            ++idx;
+            continue;
+        }
+
+        append_run();
+        if (escape_sequence.empty()) {
+            // Other control characters are escaped as `\u00XX`.
+            output.append("\\u00");
+            output.push_back(cHexDigits[byte >> 4U]);
+            output.push_back(cHexDigits[byte & 0xFU]);
+        } else {
+            output.append(escape_sequence);
+        }
+        ++idx;
+        run_begin_idx = idx;
+    }
+    append_run();
+
+    output.push_back('"');
+}
+
+auto StructuredLogEventJsonWriter::append_text_value(
+        clp::ffi::SchemaTree::Node const& node,
+        std::optional<clp::ffi::Value> const& optional_value,
+        std::string& output
+) -> bool {
+    if (clp::ffi::SchemaTree::Node::Type::Str != node.get_type()
+        || false == optional_value.has_value() || optional_value->is_null())
+    {
+        return append_value(node, optional_value, output);
+    }
+
+    auto const& value{optional_value.value()};
+    if (value.is<std::string>()) {
+        output.append(value.get_immutable_view<std::string>());
+        return true;
+    }
+    auto const decoded{decode_as_encoded_text_ast(value)};
+    if (false == decoded.has_value()) {
+        return false;
+    }
+    output.append(decoded.value());
+    return true;
+}
+
+auto StructuredLogEventJsonWriter::append_object(
+        clp::ffi::SchemaTree const& schema_tree,
+        NodeIdValuePairs const& node_id_value_pairs,
+        clp::ffi::SchemaTree::Node::id_t node_id,
+        std::string& output
+) -> bool {
+    // `nlohmann::json` objects are ordered by key. Keys are unique among the siblings of a valid
+    // log event, so the order of children with equal keys doesn't matter.
+    auto const children_begin_idx{m_child_ids.size()};
+    for (auto const child_id : schema_tree.get_node(node_id).get_children_ids()) {
+        if (child_id < m_is_node_marked.size() && m_is_node_marked[child_id]) {
+            m_child_ids.push_back(child_id);
+        }
+    }
+    auto const children_end_idx{m_child_ids.size()};
+    std::sort(
+            m_child_ids.begin() + static_cast<std::ptrdiff_t>(children_begin_idx),
+            m_child_ids.end(),
+            [&](auto const lhs, auto const rhs) {
+                return schema_tree.get_node(lhs).get_key_name()
+                       < schema_tree.get_node(rhs).get_key_name();
+            }
+    );
+
+    output.push_back('{');
+    // Use indices since serializing the children pushes onto `m_child_ids`.
+    for (auto idx{children_begin_idx}; idx < children_end_idx; ++idx) {
+        if (idx > children_begin_idx) {
+            output.push_back(',');
+        }
+        auto const child_id{m_child_ids[idx]};
+        auto const& child{schema_tree.get_node(child_id)};
+        append_string(child.get_key_name(), output);
+        output.push_back(':');
+
+        if (auto const it{node_id_value_pairs.find(child_id)}; node_id_value_pairs.end() != it) {
+            if (false == append_value(child, it->second, output)) {
+                return false;
+            }
+        } else if (false == append_object(schema_tree, node_id_value_pairs, child_id, output)) {
+            return false;
+        }
+    }
+    output.push_back('}');
+
+    m_child_ids.resize(children_begin_idx);
+    return true;
+}
+
+auto StructuredLogEventJsonWriter::mark_nodes_with_values(
+        clp::ffi::SchemaTree const& schema_tree,
+        NodeIdValuePairs const& node_id_value_pairs,
+        std::vector<bool> const* projected_nodes
+) -> void {
+    unmark_nodes();
+    if (m_is_node_marked.size() < schema_tree.get_size()) {
+        m_is_node_marked.resize(schema_tree.get_size(), false);
+    }
+
+    for (auto const& [node_id, value] : node_id_value_pairs) {
+        if (nullptr != projected_nodes
+            && (node_id >= projected_nodes->size() || false == (*projected_nodes)[node_id]))
+        {
+            continue;
+        }
+        // Stop at the first marked ancestor since its own ancestors are already marked.
+        for (auto id{node_id}; false == m_is_node_marked[id];) {
+            m_is_node_marked[id] = true;
+            m_marked_node_ids.push_back(id);
+            auto const& node{schema_tree.get_node(id)};
+            if (node.is_root()) {
+                break;
+            }
+            id = node.get_parent_id_unsafe();
+        }
+    }
+}
+
+auto StructuredLogEventJsonWriter::unmark_nodes() -> void {
+    for (auto const node_id : m_marked_node_ids) {
+        m_is_node_marked[node_id] = false;
+    }
+    m_marked_node_ids.clear();
+}
+
+auto StructuredLogEventJsonWriter::append_value(
+        clp::ffi::SchemaTree::Node const& node,
+        std::optional<clp::ffi::Value> const& optional_value,
+        std::string& output
+) -> bool {
+    // An `Obj` node without a value represents an empty object.
+    if (false == optional_value.has_value()) {
+        output.append("{}");
+        return true;
+    }
+
+    auto const& value{optional_value.value()};
+    if (value.is_null()) {
+        output.append("null");
+        return true;
+    }
+
+    switch (node.get_type()) {
+        case clp::ffi::SchemaTree::Node::Type::Int: {
+            std::array<char, cNumberBufferSize> buffer{};
+            auto const [end, error_code]{std::to_chars(
+                    buffer.data(),
+                    buffer.data() + buffer.size(),
+                    value.get_immutable_view<clp::ffi::value_int_t>()
+            )};
+            output.append(buffer.data(), end - buffer.data());
+            return true;
+        }
+        case clp::ffi::SchemaTree::Node::Type::Float:
+            append_float(value.get_immutable_view<clp::ffi::value_float_t>(), output);
+            return true;
+        case clp::ffi::SchemaTree::Node::Type::Bool:
+            output.append(value.get_immutable_view<clp::ffi::value_bool_t>() ? "true" : "false");
+            return true;
+        case clp::ffi::SchemaTree::Node::Type::Str: {
+            if (value.is<std::string>()) {
+                append_string(value.get_immutable_view<std::string>(), output);
+                return true;
+            }
+            auto const decoded{decode_as_encoded_text_ast(value)};
+            if (false == decoded.has_value()) {
+                return false;
+            }
+            append_string(decoded.value(), output);
+            return true;
+        }
+        case clp::ffi::SchemaTree::Node::Type::UnstructuredArray: {
+            // Arrays are rare, so they're reformatted through `nlohmann::json` (like
+            // `KeyValuePairLogEvent::serialize_to_json` does) rather than reimplementing its
+            // parser.
+            auto const decoded{decode_as_encoded_text_ast(value)};
+            if (false == decoded.has_value()) {
+                return false;
+            }
+            auto const array{nlohmann::json::parse(decoded.value(), nullptr, false)};
+            if (array.is_discarded()) {
+                return false;
+            }
+            output.append(dump_json_with_replace(array));
+            return true;
+        }
+        default:
+            return false;
+    }
+}
+}  // namespace clp_ffi_js::ir
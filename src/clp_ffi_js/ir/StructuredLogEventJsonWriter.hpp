@@ -0,0 +1,126 @@
+#ifndef CLP_FFI_JS_IR_STRUCTUREDLOGEVENTJSONWRITER_HPP
+#define CLP_FFI_JS_IR_STRUCTUREDLOGEVENTJSONWRITER_HPP
+
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <clp/ffi/KeyValuePairLogEvent.hpp>
+#include <clp/ffi/SchemaTree.hpp>
+#include <clp/ffi/Value.hpp>
+
+namespace clp_ffi_js::ir {
+/**
+ * Class that serializes the kv-pairs of structured log events as JSON text written directly into a
+ * caller-provided buffer, without building intermediate `nlohmann::json` values.
+ *
+ * The output matches dumping the result of `clp::ffi::KeyValuePairLogEvent::serialize_to_json`
+ * with `dump_json_with_replace`: object keys are sorted, strings are escaped the same way (with
+ * invalid UTF-8 sequences replaced by U+FFFD), and floats are written in the same notation. Float
+ * digits are chosen by `std::to_chars`, so in rare cases they're shorter or closer to the value
+ * than nlohmann's, but they always round-trip.
+ *
+ * The class retains its scratch buffers between calls to avoid reallocating them per log event.
+ */
+class StructuredLogEventJsonWriter {
+public:
+    // Types
+    using NodeIdValuePairs = clp::ffi::KeyValuePairLogEvent::NodeIdValuePairs;
+
+    // Methods
+    /**
+     * Appends the given kv-pairs to `output` as a JSON object, where each kv-pair's key is the path
+     * of its node in `schema_tree`.
+     * @param schema_tree
+     * @param node_id_value_pairs
+     * @param output
+     * @param projected_nodes A bitmap, indexed by node ID, of the nodes whose kv-pairs should be
+     * serialized, or nullptr to serialize all kv-pairs. Nodes beyond the end of the bitmap aren't
+     * projected.
+     * @return Whether the kv-pairs were serialized successfully. On failure, `output` is restored
+     * to its original size.
+     */
+    [[nodiscard]] auto append_kv_pairs(
+            clp::ffi::SchemaTree const& schema_tree,
+            NodeIdValuePairs const& node_id_value_pairs,
+            std::string& output,
+            std::vector<bool> const* projected_nodes = nullptr
+    ) -> bool;
+
+    /**
+     * Appends `str` to `output` as a JSON string.
+     * @param str
+     * @param output
+     */
+    static auto append_string(std::string_view str, std::string& output) -> void;
+
+    /**
+     * Appends the value of a leaf node as text: strings are appended as is, and other values as
+     * JSON.
+     * @param node
+     * @param optional_value
+     * @param output
+     * @return Whether the value could be serialized.
+     */
+    [[nodiscard]] static auto append_text_value(
+            clp::ffi::SchemaTree::Node const& node,
+            std::optional<clp::ffi::Value> const& optional_value,
+            std::string& output
+    ) -> bool;
+
+private:
+    // Methods
+    /**
+     * Appends the object represented by the subtree rooted at `node_id`, containing only the nodes
+     * marked by `mark_nodes_with_values`.
+     * @param schema_tree
+     * @param node_id_value_pairs
+     * @param node_id
+     * @param output
+     * @return Whether any value in the object could be serialized.
+     */
+    [[nodiscard]] auto append_object(
+            clp::ffi::SchemaTree const& schema_tree,
+            NodeIdValuePairs const& node_id_value_pairs,
+            clp::ffi::SchemaTree::Node::id_t node_id,
+            std::string& output
+    ) -> bool;
+
+    /**
+     * Marks every (projected) node with a value, along with its ancestors.
+     * @param schema_tree
+     * @param node_id_value_pairs
+     * @param projected_nodes See `append_kv_pairs`.
+     */
+    auto mark_nodes_with_values(
+            clp::ffi::SchemaTree const& schema_tree,
+            NodeIdValuePairs const& node_id_value_pairs,
+            std::vector<bool> const* projected_nodes
+    ) -> void;
+
+    auto unmark_nodes() -> void;
+
+    /**
+     * Appends the value of a leaf node.
+     * @param node
+     * @param optional_value
+     * @param output
+     * @return Whether the value could be serialized.
+     */
+    [[nodiscard]] static auto append_value(
+            clp::ffi::SchemaTree::Node const& node,
+            std::optional<clp::ffi::Value> const& optional_value,
+            std::string& output
+    ) -> bool;
+
+    // Variables
+    std::vector<bool> m_is_node_marked;
+    std::vector<clp::ffi::SchemaTree::Node::id_t> m_marked_node_ids;
+    // Stack of the marked children of the objects being serialized.
+    std::vector<clp::ffi::SchemaTree::Node::id_t> m_child_ids;
+};
+}  // namespace clp_ffi_js::ir
+
+#endif  // CLP_FFI_JS_IR_STRUCTUREDLOGEVENTJSONWRITER_HPP
@@ -1,48 +1,78 @@
 #include "UnstructuredIrStreamReader.hpp"
 
-#include <algorithm>
 #include <chrono>
 #include <cstddef>
 #include <format>
-#include <iterator>
 #include <memory>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <system_error>
 #include <utility>
+#include <vector>
 
 #include <clp/ErrorCode.hpp>
 #include <clp/ir/LogEventDeserializer.hpp>
 #include <clp/ir/types.hpp>
+#include <clp/ReaderInterface.hpp>
 #include <clp/TraceableException.hpp>
 #include <emscripten/bind.h>
 #include <emscripten/val.h>
 #include <nlohmann/json.hpp>
 #include <spdlog/spdlog.h>
-#include <ystdlib/containers/Array.hpp>
 
+#include <clp_ffi_js/binding_types.hpp>
 #include <clp_ffi_js/ClpFfiJsException.hpp>
 #include <clp_ffi_js/constants.hpp>
+#include <clp_ffi_js/ir/CheckpointIndex.hpp>
+#include <clp_ffi_js/ir/ChunkedZstdReader.hpp>
 #include <clp_ffi_js/ir/decoding_methods.hpp>
-#include <clp_ffi_js/ir/LogEventWithFilterData.hpp>
+#include <clp_ffi_js/ir/filtering_methods.hpp>
+#include <clp_ffi_js/ir/LogEventWindowDecoder.hpp>
+#include <clp_ffi_js/ir/LogEvents.hpp>
+#include <clp_ffi_js/ir/LogtypeDictionary.hpp>
+#include <clp_ffi_js/ir/Snapshot.hpp>
 #include <clp_ffi_js/ir/StreamReader.hpp>
 #include <clp_ffi_js/ir/StreamReaderDataContext.hpp>
+#include <clp_ffi_js/ir/UnstructuredLogEventQuery.hpp>
 
 namespace clp_ffi_js::ir {
 using namespace std::literals::string_literals;
 using clp::ir::four_byte_encoded_variable_t;
 
-auto UnstructuredIrStreamReader::create(
-        std::unique_ptr<ZstdDecompressor>&& zstd_decompressor,
-        ystdlib::containers::Array<char> data_array
-) -> UnstructuredIrStreamReader {
-    // Deserialize metadata from the IR stream's preamble.
-    rewind_reader_and_validate_encoding_type(*zstd_decompressor);
-    auto const pos{zstd_decompressor->get_pos()};
-    auto metadata_json = deserialize_metadata(*zstd_decompressor);
-    zstd_decompressor->seek_from_begin(pos);
+namespace {
+/**
+ * Creates a deserializer from the preamble at the reader's current position.
+ * @param reader
+ * @return The created deserializer.
+ * @throw ClpFfiJsException if any error occurs.
+ */
+[[nodiscard]] auto create_deserializer_from_preamble(clp::ReaderInterface& reader)
+        -> UnstructuredIrDeserializer;
+
+/**
+ * Deserializes the metadata and creates a deserializer for the IR stream.
+ * @param reader
+ * @return A pair containing the metadata and the deserializer.
+ * @throw ClpFfiJsException if any error occurs.
+ */
+[[nodiscard]] auto create_deserializer(clp::ReaderInterface& reader)
+        -> std::pair<nlohmann::json, UnstructuredIrDeserializer>;
 
-    auto result{UnstructuredIrDeserializer::create(*zstd_decompressor)};
+/**
+ * Deserializes the next log event for an `UnstructuredLogEventWindowDecoder`.
+ * @param deserializer
+ * @return The deserialized log event.
+ * @throw ClpFfiJsException if the log event couldn't be deserialized.
+ */
+[[nodiscard]] auto deserialize_window_log_event(
+        UnstructuredIrDeserializer& deserializer,
+        [[maybe_unused]] clp::ReaderInterface& reader
+) -> UnstructuredLogEvent;
+
+auto create_deserializer_from_preamble(clp::ReaderInterface& reader)
+        -> UnstructuredIrDeserializer {
+    auto result{UnstructuredIrDeserializer::create(reader)};
     if (result.has_error()) {
         auto const error_code{result.error()};
         throw ClpFfiJsException{
@@ -56,14 +86,115 @@ auto UnstructuredIrStreamReader::create(
                 )
         };
     }
+    return std::move(result.value());
+}
+
+auto create_deserializer(clp::ReaderInterface& reader)
+        -> std::pair<nlohmann::json, UnstructuredIrDeserializer> {
+    // Deserialize metadata from the IR stream's preamble.
+    rewind_reader_and_validate_encoding_type(reader);
+    auto const pos{reader.get_pos()};
+    auto metadata_json = deserialize_metadata(reader);
+    reader.seek_from_begin(pos);
+
+    return {std::move(metadata_json), create_deserializer_from_preamble(reader)};
+}
+
+auto deserialize_window_log_event(
+        UnstructuredIrDeserializer& deserializer,
+        [[maybe_unused]] clp::ReaderInterface& reader
+) -> UnstructuredLogEvent {
+    auto result{deserializer.deserialize_log_event()};
+    if (result.has_error()) {
+        auto const error{result.error()};
+        throw ClpFfiJsException{
+                clp::ErrorCode::ErrorCode_Corrupt,
+                __FILENAME__,
+                __LINE__,
+                std::format(
+                        "Failed to deserialize: {}:{}",
+                        error.category().name(),
+                        error.message()
+                )
+        };
+    }
+    return std::move(result.value());
+}
+}  // namespace
+
+auto UnstructuredIrStreamReader::create(
+        std::unique_ptr<clp::ReaderInterface>&& reader,
+        std::vector<char> data_array
+) -> UnstructuredIrStreamReader {
+    auto [metadata_json, deserializer] = create_deserializer(*reader);
     auto data_context = StreamReaderDataContext<UnstructuredIrDeserializer>(
             std::move(data_array),
-            std::move(zstd_decompressor),
-            std::move(result.value())
+            std::move(reader),
+            std::move(deserializer)
     );
     return UnstructuredIrStreamReader{std::move(data_context), std::move(metadata_json)};
 }
 
+auto UnstructuredIrStreamReader::create(
+        std::unique_ptr<ChunkedZstdReader>&& chunked_reader,
+        ReaderOptions const& reader_options
+) -> UnstructuredIrStreamReader {
+    auto [metadata_json, deserializer] = create_deserializer(*chunked_reader);
+
+    std::unique_ptr<UnstructuredLogEventWindowDecoder> window_decoder;
+    if (auto const checkpoint_interval{get_checkpoint_interval(reader_options)};
+        checkpoint_interval.has_value())
+    {
+        window_decoder = std::make_unique<UnstructuredLogEventWindowDecoder>(
+                CheckpointIndex::create(checkpoint_interval.value(), *chunked_reader),
+                create_deserializer_from_preamble,
+                deserialize_window_log_event
+        );
+    }
+
+    chunked_reader->checkpoint();
+    auto data_context = StreamReaderDataContext<UnstructuredIrDeserializer>(
+            std::move(chunked_reader),
+            std::move(deserializer)
+    );
+    return UnstructuredIrStreamReader{
+            std::move(data_context),
+            std::move(metadata_json),
+            std::move(window_decoder)
+    };
+}
+
+auto UnstructuredIrStreamReader::create_from_snapshot(
+        std::unique_ptr<ChunkedZstdReader>&& chunked_reader,
+        SnapshotReader& snapshot_reader
+) -> UnstructuredIrStreamReader {
+    auto [metadata_json, deserializer] = create_deserializer(*chunked_reader);
+    auto const num_bytes_consumed{snapshot_reader.read_size()};
+    UnstructuredLogEvents encoded_log_events{false};
+    encoded_log_events.read_filter_data_snapshot(snapshot_reader);
+    auto logtype_dictionary{LogtypeDictionary::read_snapshot(snapshot_reader)};
+    auto window_decoder{std::make_unique<UnstructuredLogEventWindowDecoder>(
+            CheckpointIndex::read_snapshot(snapshot_reader),
+            create_deserializer_from_preamble,
+            deserialize_window_log_event
+    )};
+
+    auto data_context = StreamReaderDataContext<UnstructuredIrDeserializer>(
+            std::move(chunked_reader),
+            std::move(deserializer)
+    );
+    UnstructuredIrStreamReader stream_reader{
+            std::move(data_context),
+            std::move(metadata_json),
+            std::move(window_decoder)
+    };
+    stream_reader.m_logtype_dictionary = std::move(logtype_dictionary);
+    stream_reader.m_encoded_log_events = std::move(encoded_log_events);
+    stream_reader.m_num_bytes_consumed = num_bytes_consumed;
+    stream_reader.m_is_stream_exhausted = true;
+    return stream_reader;
+}
+
 auto UnstructuredIrStreamReader::get_metadata() const -> MetadataTsType {
     return convert_metadata_to_js_object(m_metadata);
 }
@@ -77,31 +208,71 @@ auto UnstructuredIrStreamReader::get_filtered_log_event_map() const -> FilteredL
         return FilteredLogEventMapTsType{emscripten::val::null()};
     }
 
-    return FilteredLogEventMapTsType{emscripten::val::array(m_filtered_log_event_map.value())};
+    return FilteredLogEventMapTsType{to_js_array(m_filtered_log_event_map.value())};
 }
 
 void UnstructuredIrStreamReader::filter_log_events(
         LogLevelFilterTsType const& log_level_filter,
-        [[maybe_unused]] std::string const& kql_filter
+        std::string const& kql_filter
 ) {
-    if (false == kql_filter.empty()) {
-        SPDLOG_WARN(
-                "KQL filters aren't supported for unstructured IR streams, so they're being "
-                "ignored."
-        );
+    m_filtered_log_event_map.reset();
+    m_log_event_filter = create_log_event_filter(log_level_filter, kql_filter);
+    if (false == m_log_event_filter.has_value()) {
+        return;
+    }
+    m_filtered_log_event_map.emplace();
+    try {
+        extend_filtered_log_events(0);
+    } catch (...) {
+        // Don't keep applying a filter that can't be evaluated (e.g., an invalid query) to log
+        // events deserialized later.
+        m_log_event_filter.reset();
+        m_filtered_log_event_map.reset();
+        throw;
+    }
+}
+
+void UnstructuredIrStreamReader::set_format_template(std::string const& pattern) {
+    if (pattern.empty()) {
+        return;
     }
-    generic_filter_log_events(m_filtered_log_event_map, log_level_filter, m_encoded_log_events);
+    throw ClpFfiJsException{
+            clp::ErrorCode::ErrorCode_Unsupported,
+            __FILENAME__,
+            __LINE__,
+            "Format templates are only supported for structured IR streams."
+    };
 }
 
-auto UnstructuredIrStreamReader::deserialize_stream() -> size_t {
-    if (nullptr == m_stream_reader_data_context) {
-        return m_encoded_log_events.size();
+auto UnstructuredIrStreamReader::deserialize_within_budget(DeserializationBudget const& budget)
+        -> bool {
+    if (m_is_stream_exhausted) {
+        return true;
     }
 
     constexpr size_t cDefaultNumReservedLogEvents{500'000};
     m_encoded_log_events.reserve(cDefaultNumReservedLogEvents);
 
+    CheckpointIndex* checkpoint_index{nullptr};
+    if (nullptr != m_window_decoder) {
+        checkpoint_index = &m_window_decoder->get_checkpoint_index();
+    }
+
+    auto& reader{m_stream_reader_data_context->get_reader()};
+    auto* const chunked_reader{m_stream_reader_data_context->get_chunked_reader()};
+    auto const begin_num_events{m_encoded_log_events.size()};
+    auto const begin_pos{reader.get_pos()};
     while (true) {
+        if (m_encoded_log_events.size() - begin_num_events >= budget.max_num_events
+            || reader.get_pos() - begin_pos >= budget.max_num_bytes)
+        {
+            m_num_bytes_consumed = reader.get_pos();
+            return false;
+        }
+        if (nullptr != checkpoint_index) {
+            checkpoint_index->add_checkpoint_if_due(m_encoded_log_events.size(), reader.get_pos());
+        }
+
         auto result{m_stream_reader_data_context->get_deserializer().deserialize_log_event()};
         if (result.has_error()) {
             auto const error{result.error()};
@@ -109,6 +280,13 @@ auto UnstructuredIrStreamReader::deserialize_stream() -> size_t {
                 break;
             }
             if (std::errc::result_out_of_range == error) {
+                if (nullptr != chunked_reader && false == chunked_reader->is_end_of_input_marked())
+                {
+                    // Wait for the rest of the log event to be appended.
+                    chunked_reader->rewind_to_checkpoint();
+                    m_num_bytes_consumed = reader.get_pos();
+                    return false;
+                }
                 SPDLOG_ERROR("File contains an incomplete IR stream");
                 break;
             }
@@ -123,76 +301,251 @@ auto UnstructuredIrStreamReader::deserialize_stream() -> size_t {
                     )
             };
         }
+        if (nullptr != chunked_reader) {
+            chunked_reader->checkpoint();
+        }
         auto const& log_event = result.value();
         auto const& message = log_event.get_message();
 
-        auto const& logtype = message.get_logtype();
-        constexpr size_t cLogLevelPositionInMessages{1};
-        LogLevel log_level{LogLevel::NONE};
-        if (logtype.length() > cLogLevelPositionInMessages) {
-            // NOLINTNEXTLINE(readability-qualified-auto)
-            auto const log_level_name_it{std::find_if(
-                    cLogLevelNames.begin() + static_cast<size_t>(cValidLogLevelsBeginIdx),
-                    cLogLevelNames.end(),
-                    [&](std::string_view level) {
-                        return logtype.substr(cLogLevelPositionInMessages).starts_with(level);
-                    }
-            )};
-            if (log_level_name_it != cLogLevelNames.end()) {
-                log_level = static_cast<LogLevel>(
-                        std::distance(cLogLevelNames.begin(), log_level_name_it)
+        InternedUnstructuredLogEvent interned_log_event{
+                .logtype_id = m_logtype_dictionary.intern(message.get_logtype()),
+                .encoded_vars = {},
+                .dict_vars = {}
+        };
+        if (m_encoded_log_events.is_storing_log_events()) {
+            interned_log_event.encoded_vars = message.get_encoded_vars();
+            interned_log_event.dict_vars = message.get_dict_vars();
+        }
+        // The log level is detected once per distinct logtype, when it's interned.
+        auto const& logtype_entry{m_logtype_dictionary.get_entry(interned_log_event.logtype_id)};
+        auto const log_level{logtype_entry.log_level};
+        auto const timestamp{log_event.get_timestamp()};
+        auto const utc_offset{std::chrono::duration_cast<UtcOffset>(log_event.get_utc_offset())};
+        m_encoded_log_events
+                .emplace_back(std::move(interned_log_event), log_level, timestamp, utc_offset);
+    }
+    m_is_stream_exhausted = true;
+    m_num_bytes_consumed = reader.get_pos();
+    if (nullptr == m_window_decoder) {
+        m_stream_reader_data_context.reset(nullptr);
+    }
+    return true;
+}
+
+auto UnstructuredIrStreamReader::extend_filtered_log_events(size_t begin_idx) -> void {
+    if (false == m_log_event_filter.has_value()) {
+        return;
+    }
+
+    auto const& query_string{m_log_event_filter->query};
+    std::vector<size_t> matched_log_event_indices;
+    if (false == query_string.empty() && nullptr == m_window_decoder) {
+        auto create_query_predicate = [&]() {
+            // Each thread uses its own query, since queries cache per-logtype results.
+            return [this,
+                    begin_idx,
+                    query = UnstructuredLogEventQuery{query_string, m_logtype_dictionary}](
+                           size_t offset
+                   ) mutable -> bool {
+                auto const& log_event{m_encoded_log_events.get_log_event(begin_idx + offset)};
+                return query.matches(
+                        log_event.logtype_id,
+                        log_event.encoded_vars,
+                        log_event.dict_vars
                 );
+            };
+        };
+        matched_log_event_indices = collect_matching_indices(
+                m_encoded_log_events.size() - begin_idx,
+                create_query_predicate
+        );
+        for (auto& log_event_idx : matched_log_event_indices) {
+            log_event_idx += begin_idx;
+        }
+    } else if (false == query_string.empty()) {
+        // Windowed mode doesn't buffer log events, so decode them with the window decoder, which
+        // resumes from the nearest checkpoint before `begin_idx`.
+        UnstructuredLogEventQuery query{query_string, m_logtype_dictionary};
+        auto const compressed_data{m_stream_reader_data_context->get_compressed_data()};
+        auto const num_events_buffered{m_encoded_log_events.size()};
+        for (auto log_event_idx{begin_idx}; log_event_idx < num_events_buffered; ++log_event_idx) {
+            auto const log_event{m_window_decoder->decode(compressed_data, log_event_idx)};
+            auto const& message{log_event.get_message()};
+            if (query.matches(
+                        find_logtype_id(message.get_logtype()),
+                        message.get_encoded_vars(),
+                        message.get_dict_vars()
+                ))
+            {
+                matched_log_event_indices.push_back(log_event_idx);
             }
         }
+    }
 
-        m_encoded_log_events.emplace_back(
-                log_event,
-                log_level,
-                log_event.get_timestamp(),
-                std::chrono::duration_cast<UtcOffset>(log_event.get_utc_offset())
-        );
+    generic_extend_filtered_log_events(
+            m_filtered_log_event_map.value(),
+            m_log_event_filter.value(),
+            m_encoded_log_events.get_filter_columns(),
+            begin_idx,
+            matched_log_event_indices
+    );
+}
+
+auto UnstructuredIrStreamReader::write_snapshot(SnapshotWriter& writer) const -> void {
+    if (nullptr == m_window_decoder || false == m_is_stream_exhausted) {
+        throw ClpFfiJsException{
+                clp::ErrorCode::ErrorCode_Unsupported,
+                __FILENAME__,
+                __LINE__,
+                "Only readers in windowed mode that have deserialized the entire stream can be"
+                " snapshotted."
+        };
     }
-    m_stream_reader_data_context.reset(nullptr);
-    return m_encoded_log_events.size();
+    write_snapshot_header(writer, m_stream_reader_data_context->get_compressed_data());
+    writer.write_size(m_num_bytes_consumed);
+    m_encoded_log_events.write_filter_data_snapshot(writer);
+    m_logtype_dictionary.write_snapshot(writer);
+    m_window_decoder->get_checkpoint_index().write_snapshot(writer);
 }
 
 auto
 UnstructuredIrStreamReader::decode_range(size_t begin_idx, size_t end_idx, bool use_filter) const
         -> DecodedResultsTsType {
-    auto log_event_to_string = [this](UnstructuredLogEvent const& log_event) -> std::string {
-        auto const parsed{log_event.get_message().decode_and_unparse()};
-        if (false == parsed.has_value()) {
-            throw ClpFfiJsException{
-                    clp::ErrorCode::ErrorCode_Failure,
-                    __FILENAME__,
-                    __LINE__,
-                    "Failed to decode message"
-            };
-        }
-        return parsed.value();
-    };
-
     return generic_decode_range(
             begin_idx,
             end_idx,
             m_filtered_log_event_map,
-            m_encoded_log_events,
-            log_event_to_string,
+            m_encoded_log_events.get_filter_columns(),
+            [this](size_t log_event_idx) -> std::string {
+                std::string message;
+                append_decoded_message(log_event_idx, message);
+                return message;
+            },
+            use_filter
+    );
+}
+
+auto UnstructuredIrStreamReader::decode_range_binary(
+        size_t begin_idx,
+        size_t end_idx,
+        bool use_filter
+) const -> DecodedResultsBinaryTsType {
+    return generic_decode_range_binary(
+            begin_idx,
+            end_idx,
+            m_filtered_log_event_map,
+            m_encoded_log_events.get_filter_columns(),
+            [this](size_t log_event_idx, std::string& output) {
+                append_decoded_message(log_event_idx, output);
+            },
             use_filter
     );
 }
 
+auto UnstructuredIrStreamReader::get_time_histogram(
+        clp::ir::epoch_time_ms_t begin_ts,
+        clp::ir::epoch_time_ms_t end_ts,
+        size_t num_buckets,
+        bool use_filter,
+        bool split_by_log_level
+) const -> TimeHistogramTsType {
+    return generic_get_time_histogram(
+            begin_ts,
+            end_ts,
+            num_buckets,
+            m_filtered_log_event_map,
+            m_encoded_log_events.get_filter_columns(),
+            use_filter,
+            split_by_log_level
+    );
+}
+
 auto UnstructuredIrStreamReader::find_nearest_log_event_by_timestamp(
         clp::ir::epoch_time_ms_t const target_ts
 ) -> NullableLogEventIdx {
-    return generic_find_nearest_log_event_by_timestamp(m_encoded_log_events, target_ts);
+    return generic_find_nearest_log_event_by_timestamp(
+            m_encoded_log_events.get_filter_columns(),
+            target_ts
+    );
+}
+
+auto UnstructuredIrStreamReader::get_chunked_reader() const -> ChunkedZstdReader* {
+    if (m_is_stream_exhausted) {
+        return nullptr;
+    }
+    return m_stream_reader_data_context->get_chunked_reader();
+}
+
+auto UnstructuredIrStreamReader::append_decoded_message(
+        size_t log_event_idx,
+        std::string& output
+) const -> void {
+    bool is_decoded{false};
+    if (nullptr != m_window_decoder) {
+        auto const log_event{m_window_decoder->decode(
+                m_stream_reader_data_context->get_compressed_data(),
+                log_event_idx
+        )};
+        auto const& message{log_event.get_message()};
+        is_decoded = m_logtype_dictionary.append_decoded_message(
+                find_logtype_id(message.get_logtype()),
+                message.get_encoded_vars(),
+                message.get_dict_vars(),
+                output
+        );
+    } else {
+        auto const& log_event{m_encoded_log_events.get_log_event(log_event_idx)};
+        is_decoded = m_logtype_dictionary.append_decoded_message(
+                log_event.logtype_id,
+                log_event.encoded_vars,
+                log_event.dict_vars,
+                output
+        );
+    }
+    if (false == is_decoded) {
+        throw ClpFfiJsException{
+                clp::ErrorCode::ErrorCode_Failure,
+                __FILENAME__,
+                __LINE__,
+                "Failed to decode message"
+        };
+    }
+}
+
+auto UnstructuredIrStreamReader::append_exported_line(
+        size_t log_event_idx,
+        std::optional<std::string_view> timestamp,
+        std::string& output
+) const -> void {
+    if (timestamp.has_value()) {
+        output.append(timestamp.value());
+        output.push_back(' ');
+    }
+    append_decoded_message(log_event_idx, output);
+}
+
+auto UnstructuredIrStreamReader::find_logtype_id(std::string const& logtype) const
+        -> LogtypeDictionary::logtype_id_t {
+    auto const logtype_id{m_logtype_dictionary.find(logtype)};
+    if (false == logtype_id.has_value()) {
+        throw ClpFfiJsException{
+                clp::ErrorCode::ErrorCode_Corrupt,
+                __FILENAME__,
+                __LINE__,
+                "Logtype of a buffered log event isn't in the logtype dictionary."
+        };
+    }
+    return logtype_id.value();
 }
 
 UnstructuredIrStreamReader::UnstructuredIrStreamReader(
         StreamReaderDataContext<UnstructuredIrDeserializer>&& stream_reader_data_context,
-        nlohmann::json metadata
+        nlohmann::json metadata,
+        std::unique_ptr<UnstructuredLogEventWindowDecoder> window_decoder
 )
         : m_metadata(std::move(metadata)),
+          m_encoded_log_events{nullptr == window_decoder},
+          m_window_decoder{std::move(window_decoder)},
           m_stream_reader_data_context{
                   std::make_unique<StreamReaderDataContext<UnstructuredIrDeserializer>>(
                           std::move(stream_reader_data_context)
@@ -3,21 +3,32 @@
 
 #include <cstddef>
 #include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
 
 #include <clp/ir/LogEventDeserializer.hpp>
 #include <clp/ir/types.hpp>
+#include <clp/ReaderInterface.hpp>
 #include <emscripten/val.h>
 #include <nlohmann/json.hpp>
-#include <ystdlib/containers/Array.hpp>
 
-#include <clp_ffi_js/ir/LogEventWithFilterData.hpp>
+#include <clp_ffi_js/ir/ChunkedZstdReader.hpp>
+#include <clp_ffi_js/ir/LogEventWindowDecoder.hpp>
+#include <clp_ffi_js/ir/LogEventFilterColumns.hpp>
+#include <clp_ffi_js/ir/LogEvents.hpp>
+#include <clp_ffi_js/ir/LogtypeDictionary.hpp>
+#include <clp_ffi_js/ir/Snapshot.hpp>
 #include <clp_ffi_js/ir/StreamReader.hpp>
 #include <clp_ffi_js/ir/StreamReaderDataContext.hpp>
 
 namespace clp_ffi_js::ir {
 using clp::ir::four_byte_encoded_variable_t;
 using UnstructuredIrDeserializer = clp::ir::LogEventDeserializer<four_byte_encoded_variable_t>;
-using UnstructuredLogEvents = LogEvents<UnstructuredLogEvent>;
+using UnstructuredLogEvents = LogEvents<InternedUnstructuredLogEvent>;
+using UnstructuredLogEventWindowDecoder
+        = LogEventWindowDecoder<UnstructuredIrDeserializer, UnstructuredLogEvent>;
 
 /**
  * Class to deserialize and decode Zstd-compressed CLP unstructured IR streams, as well as format
@@ -38,14 +49,38 @@ public:
     auto operator=(UnstructuredIrStreamReader&&) -> UnstructuredIrStreamReader& = delete;
 
     /**
-     * @param zstd_decompressor A decompressor for an IR stream.
-     * @param data_array The array backing `zstd_decompressor`.
+     * @param reader A reader for a decompressed IR stream.
+     * @param data_array The array of compressed bytes backing `reader`.
      * @return The created instance.
      * @throw ClpFfiJsException if any error occurs.
      */
     [[nodiscard]] static auto create(
-            std::unique_ptr<ZstdDecompressor>&& zstd_decompressor,
-            ystdlib::containers::Array<char> data_array
+            std::unique_ptr<clp::ReaderInterface>&& reader,
+            std::vector<char> data_array
+    ) -> UnstructuredIrStreamReader;
+
+    /**
+     * @param chunked_reader A reader for an IR stream that's appended in chunks.
+     * @param reader_options
+     * @return The created instance, in windowed mode if `reader_options` enables it (see
+     * `StreamReader::get_checkpoint_interval`).
+     * @throw ClpFfiJsException if any error occurs.
+     */
+    [[nodiscard]] static auto create(
+            std::unique_ptr<ChunkedZstdReader>&& chunked_reader,
+            ReaderOptions const& reader_options
+    ) -> UnstructuredIrStreamReader;
+
+    /**
+     * @param chunked_reader A reader for the IR stream the snapshot was serialized from, with its
+     * end of input marked.
+     * @param snapshot_reader A reader positioned after the snapshot's header.
+     * @return The created instance, in windowed mode.
+     * @throw ClpFfiJsException if the snapshot is invalid or any other error occurs.
+     */
+    [[nodiscard]] static auto create_from_snapshot(
+            std::unique_ptr<ChunkedZstdReader>&& chunked_reader,
+            SnapshotReader& snapshot_reader
     ) -> UnstructuredIrStreamReader;
 
     [[nodiscard]] auto get_metadata() const -> MetadataTsType override;
@@ -60,36 +95,110 @@ public:
 
     void filter_log_events(
             LogLevelFilterTsType const& log_level_filter,
-            [[maybe_unused]] std::string const& kql_filter
+            std::string const& kql_filter
     ) override;
 
     /**
-     * @see StreamReader::deserialize_stream
+     * @see StreamReader::set_format_template
      *
-     * After the stream has been exhausted, it will be deallocated.
+     * Unstructured log events have no fields to format, so only clearing the template (with an
+     * empty pattern) is supported.
      *
-     * @return @see StreamReader::deserialize_stream
+     * @throw ClpFfiJsException if `pattern` isn't empty.
      */
-    [[nodiscard]] auto deserialize_stream() -> size_t override;
+    void set_format_template(std::string const& pattern) override;
 
     [[nodiscard]] auto decode_range(size_t begin_idx, size_t end_idx, bool use_filter) const
             -> DecodedResultsTsType override;
 
+    [[nodiscard]] auto
+    decode_range_binary(size_t begin_idx, size_t end_idx, bool use_filter) const
+            -> DecodedResultsBinaryTsType override;
+
+    [[nodiscard]] auto get_time_histogram(
+            clp::ir::epoch_time_ms_t begin_ts,
+            clp::ir::epoch_time_ms_t end_ts,
+            size_t num_buckets,
+            bool use_filter,
+            bool split_by_log_level
+    ) const -> TimeHistogramTsType override;
+
     [[nodiscard]] auto find_nearest_log_event_by_timestamp(clp::ir::epoch_time_ms_t target_ts)
             -> NullableLogEventIdx override;
 
+protected:
+    [[nodiscard]] auto get_chunked_reader() const -> ChunkedZstdReader* override;
+
+    /**
+     * @see StreamReader::deserialize_within_budget
+     *
+     * After the stream has been exhausted, it will be deallocated, unless the reader is in windowed
+     * mode, where it's needed to decode log events.
+     *
+     * @return @see StreamReader::deserialize_within_budget
+     */
+    [[nodiscard]] auto deserialize_within_budget(DeserializationBudget const& budget)
+            -> bool override;
+
+    [[nodiscard]] auto get_num_bytes_consumed() const -> size_t override {
+        return m_num_bytes_consumed;
+    }
+
+    [[nodiscard]] auto get_filter_columns() const -> LogEventFilterColumns const& override {
+        return m_encoded_log_events.get_filter_columns();
+    }
+
+    [[nodiscard]] auto get_filtered_log_event_indices() const
+            -> FilteredLogEventsMap const& override {
+        return m_filtered_log_event_map;
+    }
+
+    auto extend_filtered_log_events(size_t begin_idx) -> void override;
+
+    auto write_snapshot(SnapshotWriter& writer) const -> void override;
+
+    auto append_decoded_message(size_t log_event_idx, std::string& output) const -> void override;
+
+    /**
+     * @see StreamReader::append_exported_line
+     *
+     * The timestamp, if any, is prepended to the log event's message.
+     */
+    auto append_exported_line(
+            size_t log_event_idx,
+            std::optional<std::string_view> timestamp,
+            std::string& output
+    ) const -> void override;
+
 private:
     // Constructor
     explicit UnstructuredIrStreamReader(
             StreamReaderDataContext<UnstructuredIrDeserializer>&& stream_reader_data_context,
-            nlohmann::json metadata
+            nlohmann::json metadata,
+            std::unique_ptr<UnstructuredLogEventWindowDecoder> window_decoder = nullptr
     );
 
+    // Methods
+    /**
+     * @param logtype The logtype of a buffered log event.
+     * @return The logtype's ID in the logtype dictionary.
+     * @throw ClpFfiJsException if the logtype isn't in the dictionary.
+     */
+    [[nodiscard]] auto find_logtype_id(std::string const& logtype) const
+            -> LogtypeDictionary::logtype_id_t;
+
     // Variables
     nlohmann::json m_metadata;
+    LogtypeDictionary m_logtype_dictionary;
+    // In windowed mode, only the log events' filter data is buffered, and `m_window_decoder`
+    // decodes log events on demand.
     UnstructuredLogEvents m_encoded_log_events;
+    std::unique_ptr<UnstructuredLogEventWindowDecoder> m_window_decoder;
     std::unique_ptr<StreamReaderDataContext<UnstructuredIrDeserializer>>
             m_stream_reader_data_context;
+    bool m_is_stream_exhausted{false};
+    size_t m_num_bytes_consumed{0};
+    std::optional<LogEventFilter> m_log_event_filter;
     FilteredLogEventsMap m_filtered_log_event_map;
 };
 }  // namespace clp_ffi_js::ir
@@ -0,0 +1,204 @@
+#include "UnstructuredLogEventQuery.hpp"
+
+#include <cstddef>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <clp/ErrorCode.hpp>
+#include <clp/ir/types.hpp>
+#include <clp/string_utils/string_utils.hpp>
+
+#include <clp_ffi_js/ClpFfiJsException.hpp>
+#include <clp_ffi_js/ir/LogtypeDictionary.hpp>
+
+namespace clp_ffi_js::ir {
+namespace {
+using WildcardToken = UnstructuredLogEventQuery::WildcardToken;
+
+/**
+ * @param wildcard_string A cleaned-up wildcard string.
+ * @return The wildcard string's tokens.
+ */
+[[nodiscard]] auto tokenize_wildcard_string(std::string_view wildcard_string)
+        -> std::vector<WildcardToken>;
+
+/**
+ * @param lhs
+ * @param rhs
+ * @return Whether there's any string that matches both `lhs` and `rhs`.
+ */
+[[nodiscard]] auto
+can_match_same_string(std::span<WildcardToken const> lhs, std::span<WildcardToken const> rhs)
+        -> bool;
+
+auto tokenize_wildcard_string(std::string_view wildcard_string) -> std::vector<WildcardToken> {
+    std::vector<WildcardToken> tokens;
+    for (size_t i{0}; i < wildcard_string.size(); ++i) {
+        auto const c{wildcard_string[i]};
+        if ('\\' == c && i + 1 < wildcard_string.size()) {
+            ++i;
+            tokens.push_back({WildcardToken::Type::Literal, wildcard_string[i]});
+        } else if ('*' == c) {
+            tokens.push_back({WildcardToken::Type::AnyString, c});
+        } else if ('?' == c) {
+            tokens.push_back({WildcardToken::Type::AnyChar, c});
+        } else {
+            tokens.push_back({WildcardToken::Type::Literal, c});
+        }
+    }
+    return tokens;
+}
+
+auto can_match_same_string(std::span<WildcardToken const> lhs, std::span<WildcardToken const> rhs)
+        -> bool {
+    // Search the states of matching both token sequences against a common string, where a state is
+    // the number of tokens of each sequence consumed so far.
+    auto const num_rhs_states{rhs.size() + 1};
+    std::vector<bool> is_state_visited((lhs.size() + 1) * num_rhs_states, false);
+    std::vector<std::pair<size_t, size_t>> pending_states;
+    auto visit = [&](size_t lhs_idx, size_t rhs_idx) {
+        auto const state_idx{lhs_idx * num_rhs_states + rhs_idx};
+        if (false == is_state_visited[state_idx]) {
+            is_state_visited[state_idx] = true;
+            pending_states.emplace_back(lhs_idx, rhs_idx);
+        }
+    };
+
+    visit(0, 0);
+    while (false == pending_states.empty()) {
+        auto const [lhs_idx, rhs_idx]{pending_states.back()};
+        pending_states.pop_back();
+
+        bool const is_lhs_consumed{lhs.size() == lhs_idx};
+        bool const is_rhs_consumed{rhs.size() == rhs_idx};
+        if (is_lhs_consumed && is_rhs_consumed) {
+            return true;
+        }
+        bool const is_lhs_any_string{
+                false == is_lhs_consumed && WildcardToken::Type::AnyString == lhs[lhs_idx].type
+        };
+        bool const is_rhs_any_string{
+                false == is_rhs_consumed && WildcardToken::Type::AnyString == rhs[rhs_idx].type
+        };
+
+        if (is_lhs_any_string) {
+            // Either the `*` ends, or it absorbs the next character matched by `rhs`.
+            visit(lhs_idx + 1, rhs_idx);
+            if (false == is_rhs_consumed && false == is_rhs_any_string) {
+                visit(lhs_idx, rhs_idx + 1);
+            }
+        }
+        if (is_rhs_any_string) {
+            visit(lhs_idx, rhs_idx + 1);
+            if (false == is_lhs_consumed && false == is_lhs_any_string) {
+                visit(lhs_idx + 1, rhs_idx);
+            }
+        }
+        if (is_lhs_consumed || is_rhs_consumed || is_lhs_any_string || is_rhs_any_string) {
+            continue;
+        }
+
+        auto const& lhs_token{lhs[lhs_idx]};
+        auto const& rhs_token{rhs[rhs_idx]};
+        if (WildcardToken::Type::AnyChar == lhs_token.type
+            || WildcardToken::Type::AnyChar == rhs_token.type
+            || lhs_token.literal == rhs_token.literal)
+        {
+            visit(lhs_idx + 1, rhs_idx + 1);
+        }
+    }
+    return false;
+}
+}  // namespace
+
+UnstructuredLogEventQuery::UnstructuredLogEventQuery(
+        std::string_view query,
+        LogtypeDictionary const& logtype_dictionary
+)
+        : m_logtype_dictionary{logtype_dictionary} {
+    // Clean up the query before surrounding it with `*`, so that a trailing escape character can't
+    // escape the appended `*`.
+    m_wildcard_query = clp::string_utils::clean_up_wildcard_search_string(
+            "*" + clp::string_utils::clean_up_wildcard_search_string(query) + "*"
+    );
+    m_query_tokens = tokenize_wildcard_string(m_wildcard_query);
+}
+
+auto UnstructuredLogEventQuery::matches(
+        LogtypeDictionary::logtype_id_t logtype_id,
+        std::span<clp::ir::four_byte_encoded_variable_t const> encoded_vars,
+        std::span<std::string const> dict_vars
+) -> bool {
+    if (m_logtype_match_results.size() <= logtype_id) {
+        m_logtype_match_results.resize(m_logtype_dictionary.size());
+    }
+    auto& match_result{m_logtype_match_results[logtype_id]};
+    if (false == match_result.has_value()) {
+        match_result = evaluate_logtype(m_logtype_dictionary.get_entry(logtype_id));
+    }
+
+    switch (match_result.value()) {
+        case LogtypeMatchResult::NoMatch:
+            return false;
+        case LogtypeMatchResult::Match:
+            return true;
+        case LogtypeMatchResult::MaybeMatch:
+        default:
+            break;
+    }
+
+    m_decoded_message.clear();
+    if (false
+        == m_logtype_dictionary
+                   .append_decoded_message(logtype_id, encoded_vars, dict_vars, m_decoded_message))
+    {
+        throw ClpFfiJsException{
+                clp::ErrorCode::ErrorCode_Failure,
+                __FILENAME__,
+                __LINE__,
+                "Failed to decode message"
+        };
+    }
+    return clp::string_utils::wildcard_match_unsafe(m_decoded_message, m_wildcard_query);
+}
+
+auto UnstructuredLogEventQuery::evaluate_logtype(LogtypeDictionary::Entry const& logtype_entry
+) const -> LogtypeMatchResult {
+    if (1 == m_query_tokens.size() && WildcardToken::Type::AnyString == m_query_tokens[0].type) {
+        return LogtypeMatchResult::Match;
+    }
+    if (false == logtype_entry.is_valid) {
+        // Leave it to decoding to report the error.
+        return LogtypeMatchResult::MaybeMatch;
+    }
+    if (logtype_entry.placeholders.empty()) {
+        // The logtype's constant text is the entire message.
+        return clp::string_utils::wildcard_match_unsafe(
+                       logtype_entry.constants.front(),
+                       m_wildcard_query
+               )
+                       ? LogtypeMatchResult::Match
+                       : LogtypeMatchResult::NoMatch;
+    }
+
+    // Tokenize the logtype's constant text, with each run of variable placeholders standing for any
+    // text.
+    std::vector<WildcardToken> logtype_tokens;
+    for (size_t i{0}; i < logtype_entry.constants.size(); ++i) {
+        if (i > 0
+            && (logtype_tokens.empty()
+                || WildcardToken::Type::AnyString != logtype_tokens.back().type))
+        {
+            logtype_tokens.push_back({WildcardToken::Type::AnyString, '*'});
+        }
+        for (auto const c : logtype_entry.constants[i]) {
+            logtype_tokens.push_back({WildcardToken::Type::Literal, c});
+        }
+    }
+    return can_match_same_string(logtype_tokens, m_query_tokens) ? LogtypeMatchResult::MaybeMatch
+                                                                  : LogtypeMatchResult::NoMatch;
+}
+}  // namespace clp_ffi_js::ir
@@ -0,0 +1,92 @@
+#ifndef CLP_FFI_JS_IR_UNSTRUCTUREDLOGEVENTQUERY_HPP
+#define CLP_FFI_JS_IR_UNSTRUCTUREDLOGEVENTQUERY_HPP
+
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <clp/ir/types.hpp>
+
+#include <clp_ffi_js/ir/LogtypeDictionary.hpp>
+
+namespace clp_ffi_js::ir {
+/**
+ * Class that evaluates a wildcard query against unstructured log events the way CLP searches its
+ * archives: the query is first evaluated against the log event's logtype (with each variable
+ * placeholder standing for arbitrary text), and only log events whose logtypes may match are
+ * decoded and matched in full. Since a stream usually contains far fewer distinct logtypes than log
+ * events, each logtype's result is cached by its ID in the stream's `LogtypeDictionary`.
+ *
+ * In the query, `*` matches zero or more characters, `?` matches any single character, and `\`
+ * escapes the next character. The query is implicitly surrounded by `*`, so a query without
+ * wildcards matches any message that contains it.
+ */
+class UnstructuredLogEventQuery {
+public:
+    // Types
+    /**
+     * A query or logtype parsed into wildcard tokens.
+     */
+    struct WildcardToken {
+        enum class Type : uint8_t {
+            Literal,
+            AnyChar,
+            AnyString,
+        };
+
+        Type type;
+        char literal;
+    };
+
+    // Constructor
+    /**
+     * @param query
+     * @param logtype_dictionary The dictionary of the logtypes of the log events to match, which
+     * must outlive the query.
+     */
+    UnstructuredLogEventQuery(std::string_view query, LogtypeDictionary const& logtype_dictionary);
+
+    // Methods
+    /**
+     * @param logtype_id The ID of the log event's logtype in the logtype dictionary.
+     * @param encoded_vars The log event's encoded variables.
+     * @param dict_vars The log event's dictionary variables.
+     * @return Whether the log event's message matches the query.
+     * @throw ClpFfiJsException if the message of a log event whose logtype may match couldn't be
+     * decoded.
+     */
+    [[nodiscard]] auto matches(
+            LogtypeDictionary::logtype_id_t logtype_id,
+            std::span<clp::ir::four_byte_encoded_variable_t const> encoded_vars,
+            std::span<std::string const> dict_vars
+    ) -> bool;
+
+private:
+    // Types
+    enum class LogtypeMatchResult : uint8_t {
+        // No message with the logtype can match the query.
+        NoMatch,
+        // Every message with the logtype matches the query.
+        Match,
+        // Messages with the logtype may match the query, depending on their variables.
+        MaybeMatch,
+    };
+
+    // Methods
+    [[nodiscard]] auto evaluate_logtype(LogtypeDictionary::Entry const& logtype_entry) const
+            -> LogtypeMatchResult;
+
+    // Variables
+    LogtypeDictionary const& m_logtype_dictionary;
+    std::string m_wildcard_query;
+    std::vector<WildcardToken> m_query_tokens;
+    // Indexed by logtype ID.
+    std::vector<std::optional<LogtypeMatchResult>> m_logtype_match_results;
+    std::string m_decoded_message;
+};
+}  // namespace clp_ffi_js::ir
+
+#endif  // CLP_FFI_JS_IR_UNSTRUCTUREDLOGEVENTQUERY_HPP
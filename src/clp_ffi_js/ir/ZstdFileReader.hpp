@@ -0,0 +1,86 @@
+#ifndef CLP_FFI_JS_IR_ZSTDFILEREADER_HPP
+#define CLP_FFI_JS_IR_ZSTDFILEREADER_HPP
+
+#include <cstddef>
+#include <string>
+
+#include <clp/ErrorCode.hpp>
+#include <clp/ReaderInterface.hpp>
+#include <clp/streaming_compression/zstd/Decompressor.hpp>
+
+#include <clp_ffi_js/FileDescriptorReader.hpp>
+
+namespace clp_ffi_js::ir {
+/**
+ * A `clp::ReaderInterface` that decompresses a Zstandard-compressed file as it's read, so that only
+ * a bounded chunk of the compressed file is held in memory at a time, regardless of the file's
+ * size.
+ *
+ * NOTE: Seeking backwards restarts decompression from the start of the file.
+ */
+class ZstdFileReader : public clp::ReaderInterface {
+public:
+    // Types
+    using ZstdDecompressor = clp::streaming_compression::zstd::Decompressor;
+
+    // Constants
+    // The number of compressed bytes read from the file at a time.
+    static constexpr size_t cReadBufferCapacity{1024UL * 1024};
+
+    // Constructors
+    /**
+     * Opens the file at the given path for decompression.
+     * @param path
+     * @throw ClpFfiJsException if the file couldn't be opened.
+     */
+    explicit ZstdFileReader(std::string const& path) : m_file_reader{path} {
+        m_zstd_decompressor.open(m_file_reader, cReadBufferCapacity);
+    }
+
+    // Disable copy/move constructors and assignment operators since `ZstdDecompressor` holds a
+    // reference to `m_file_reader`.
+    ZstdFileReader(ZstdFileReader const&) = delete;
+    ZstdFileReader(ZstdFileReader&&) = delete;
+    auto operator=(ZstdFileReader const&) -> ZstdFileReader& = delete;
+    auto operator=(ZstdFileReader&&) -> ZstdFileReader& = delete;
+
+    // Destructor
+    ~ZstdFileReader() override = default;
+
+    // Methods implementing `clp::ReaderInterface`
+    /**
+     * @param buf
+     * @param num_bytes_to_read
+     * @param num_bytes_read Returns the number of bytes read.
+     * @return Forwards `ZstdDecompressor::try_read`'s return values.
+     */
+    [[nodiscard]] auto try_read(char* buf, size_t num_bytes_to_read, size_t& num_bytes_read)
+            -> clp::ErrorCode override {
+        return m_zstd_decompressor.try_read(buf, num_bytes_to_read, num_bytes_read);
+    }
+
+    /**
+     * Seeks within the decompressed stream.
+     * @param pos
+     * @return Forwards `ZstdDecompressor::try_seek_from_begin`'s return values.
+     */
+    [[nodiscard]] auto try_seek_from_begin(size_t pos) -> clp::ErrorCode override {
+        return m_zstd_decompressor.try_seek_from_begin(pos);
+    }
+
+    /**
+     * @param pos Returns the current position in the decompressed stream.
+     * @return Forwards `ZstdDecompressor::try_get_pos`'s return values.
+     */
+    [[nodiscard]] auto try_get_pos(size_t& pos) -> clp::ErrorCode override {
+        return m_zstd_decompressor.try_get_pos(pos);
+    }
+
+private:
+    // Variables
+    FileDescriptorReader m_file_reader;
+    ZstdDecompressor m_zstd_decompressor;
+};
+}  // namespace clp_ffi_js::ir
+
+#endif  // CLP_FFI_JS_IR_ZSTDFILEREADER_HPP
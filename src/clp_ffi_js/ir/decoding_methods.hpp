@@ -1,13 +1,18 @@
 #ifndef CLP_FFI_JS_IR_DECODING_METHODS_HPP
 #define CLP_FFI_JS_IR_DECODING_METHODS_HPP
 
+#include <concepts>
+#include <tuple>
+
 #include <clp/ffi/ir_stream/Deserializer.hpp>
 #include <clp/ffi/ir_stream/IrUnitHandlerReq.hpp>
+#include <clp/ffi/ir_stream/IrUnitType.hpp>
 #include <clp/ffi/ir_stream/search/QueryHandlerReq.hpp>
 #include <clp/ReaderInterface.hpp>
 #include <nlohmann/json.hpp>
 
 #include <clp_ffi_js/ClpFfiJsException.hpp>
+#include <clp_ffi_js/ir/ChunkedZstdReader.hpp>
 #include <clp_ffi_js/ir/StreamReader.hpp>
 #include <clp_ffi_js/ir/StructuredIrStreamReader.hpp>
 
@@ -38,6 +43,62 @@ auto rewind_reader_and_validate_encoding_type(clp::ReaderInterface& reader) -> v
  */
 [[nodiscard]] auto convert_metadata_to_js_object(nlohmann::json const& metadata) -> MetadataTsType;
 
+/**
+ * Deserializes IR units until the stream is exhausted or `should_pause` returns true.
+ *
+ * @tparam ShouldPause
+ * @param deserializer
+ * @param reader
+ * @param should_pause Function called before each IR unit is deserialized, which returns whether to
+ * stop deserializing so that a later call can continue from the same IR unit.
+ * @return Whether the stream has been exhausted, i.e., it's either complete or incomplete.
+ * @throws ClpFfiJsException if an IR unit couldn't be deserialized.
+ */
+template <
+        clp::ffi::ir_stream::IrUnitHandlerReq IrUnitHandlerType,
+        clp::ffi::ir_stream::search::QueryHandlerReq QueryHandlerType,
+        typename ShouldPause
+>
+requires std::predicate<ShouldPause>
+auto deserialize_log_events(
+        clp::ffi::ir_stream::Deserializer<IrUnitHandlerType, QueryHandlerType>& deserializer,
+        clp::ReaderInterface& reader,
+        ShouldPause should_pause
+) -> bool {
+    while (false == deserializer.is_stream_completed()) {
+        if (should_pause()) {
+            return false;
+        }
+        auto const result{deserializer.deserialize_next_ir_unit(reader)};
+        if (false == result.has_error()) {
+            continue;
+        }
+        auto const error{result.error()};
+        if (std::errc::result_out_of_range == error) {
+            SPDLOG_WARN("File contains an incomplete IR stream");
+            return true;
+        }
+        throw ClpFfiJsException{
+                clp::ErrorCode::ErrorCode_Corrupt,
+                __FILENAME__,
+                __LINE__,
+                std::format(
+                        "Failed to deserialize IR unit: {}:{}",
+                        error.category().name(),
+                        error.message()
+                )
+        };
+    }
+    return true;
+}
+
+/**
+ * Deserializes IR units until the stream is exhausted.
+ *
+ * @param deserializer
+ * @param reader
+ * @throws ClpFfiJsException if an IR unit couldn't be deserialized.
+ */
 template <
         clp::ffi::ir_stream::IrUnitHandlerReq IrUnitHandlerType,
         clp::ffi::ir_stream::search::QueryHandlerReq QueryHandlerType
@@ -46,15 +107,60 @@ auto deserialize_log_events(
         clp::ffi::ir_stream::Deserializer<IrUnitHandlerType, QueryHandlerType>& deserializer,
         clp::ReaderInterface& reader
 ) -> void {
+    std::ignore = deserialize_log_events(deserializer, reader, []() { return false; });
+}
+
+/**
+ * Deserializes as many IR units as the data appended to `chunked_reader` so far allows. If the
+ * data runs out in the middle of an IR unit, `chunked_reader` is rewound to the start of the unit
+ * so that a later call can deserialize it once more data has been appended.
+ *
+ * @tparam IrUnitCallback
+ * @tparam ShouldPause
+ * @param deserializer
+ * @param chunked_reader
+ * @param on_ir_unit Function called with the type of each deserialized IR unit, before
+ * `chunked_reader` is checkpointed (so `chunked_reader.get_bytes_since_checkpoint()` returns the
+ * IR unit's bytes).
+ * @param should_pause Function called before each IR unit is deserialized, which returns whether to
+ * stop deserializing so that a later call can continue from the same IR unit.
+ * @return Whether the stream has been exhausted, i.e., it's complete, or it's incomplete and the
+ * end of input has been marked.
+ * @throws ClpFfiJsException if an IR unit couldn't be deserialized.
+ * @throws Propagates `IrUnitCallback`'s exceptions.
+ */
+template <
+        clp::ffi::ir_stream::IrUnitHandlerReq IrUnitHandlerType,
+        clp::ffi::ir_stream::search::QueryHandlerReq QueryHandlerType,
+        typename IrUnitCallback,
+        typename ShouldPause
+>
+requires std::invocable<IrUnitCallback, clp::ffi::ir_stream::IrUnitType>
+         && std::predicate<ShouldPause>
+auto deserialize_available_log_events(
+        clp::ffi::ir_stream::Deserializer<IrUnitHandlerType, QueryHandlerType>& deserializer,
+        ChunkedZstdReader& chunked_reader,
+        IrUnitCallback on_ir_unit,
+        ShouldPause should_pause
+) -> bool {
     while (false == deserializer.is_stream_completed()) {
-        auto const result{deserializer.deserialize_next_ir_unit(reader)};
+        if (should_pause()) {
+            return false;
+        }
+        auto const result{deserializer.deserialize_next_ir_unit(chunked_reader)};
         if (false == result.has_error()) {
+            on_ir_unit(result.value());
+            chunked_reader.checkpoint();
             continue;
         }
         auto const error{result.error()};
         if (std::errc::result_out_of_range == error) {
+            if (false == chunked_reader.is_end_of_input_marked()) {
+                chunked_reader.rewind_to_checkpoint();
+                return false;
+            }
             SPDLOG_WARN("File contains an incomplete IR stream");
-            break;
+            return true;
         }
         throw ClpFfiJsException{
                 clp::ErrorCode::ErrorCode_Corrupt,
@@ -67,6 +173,47 @@ auto deserialize_log_events(
                 )
         };
     }
+    return true;
+}
+
+/**
+ * @see deserialize_available_log_events
+ */
+template <
+        clp::ffi::ir_stream::IrUnitHandlerReq IrUnitHandlerType,
+        clp::ffi::ir_stream::search::QueryHandlerReq QueryHandlerType,
+        typename IrUnitCallback
+>
+requires std::invocable<IrUnitCallback, clp::ffi::ir_stream::IrUnitType>
+auto deserialize_available_log_events(
+        clp::ffi::ir_stream::Deserializer<IrUnitHandlerType, QueryHandlerType>& deserializer,
+        ChunkedZstdReader& chunked_reader,
+        IrUnitCallback on_ir_unit
+) -> bool {
+    return deserialize_available_log_events(
+            deserializer,
+            chunked_reader,
+            on_ir_unit,
+            []() { return false; }
+    );
+}
+
+/**
+ * @see deserialize_available_log_events
+ */
+template <
+        clp::ffi::ir_stream::IrUnitHandlerReq IrUnitHandlerType,
+        clp::ffi::ir_stream::search::QueryHandlerReq QueryHandlerType
+>
+auto deserialize_available_log_events(
+        clp::ffi::ir_stream::Deserializer<IrUnitHandlerType, QueryHandlerType>& deserializer,
+        ChunkedZstdReader& chunked_reader
+) -> bool {
+    return deserialize_available_log_events(
+            deserializer,
+            chunked_reader,
+            []([[maybe_unused]] clp::ffi::ir_stream::IrUnitType ir_unit_type) {}
+    );
 }
 }  // namespace clp_ffi_js::ir
 
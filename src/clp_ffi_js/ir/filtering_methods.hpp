@@ -0,0 +1,139 @@
+#ifndef CLP_FFI_JS_IR_FILTERING_METHODS_HPP
+#define CLP_FFI_JS_IR_FILTERING_METHODS_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <exception>
+#include <type_traits>
+#include <vector>
+
+#ifdef CLP_FFI_JS_ENABLE_PTHREADS
+#include <thread>
+
+#include <clp_ffi_js/ir/PthreadPoolReservation.hpp>
+#endif
+
+namespace clp_ffi_js::ir {
+/**
+ * The number of consecutive items a thread claims at a time in `collect_matching_indices`.
+ */
+constexpr size_t cFilterChunkSize{16UL * 1024};
+
+/**
+ * Collects the indices of the items in `[0, num_items)` that satisfy a predicate.
+ *
+ * In builds with pthreads enabled, the calling thread and as many helper threads as there are free
+ * preallocated workers (see `PthreadPoolReservation`), up to one fewer than the number of hardware
+ * threads, repeatedly claim the next chunk of `cFilterChunkSize` items from a shared counter, so
+ * that threads which finish chunks of cheaper items go on to claim more chunks. Each chunk's
+ * matches are concatenated in order.
+ *
+ * @tparam CreatePredicate
+ * @param num_items
+ * @param create_predicate Function that returns a predicate `(size_t item_idx) -> bool` for a
+ * single thread to use. All predicates are created on the calling thread before any item is
+ * evaluated, so a predicate may own state that isn't thread-safe.
+ * @return The indices of the items that satisfy the predicate, in ascending order.
+ * @throws Propagates `create_predicate`'s and the predicates' exceptions.
+ */
+template <typename CreatePredicate>
+requires std::predicate<std::invoke_result_t<CreatePredicate&>&, size_t>
+auto collect_matching_indices(size_t num_items, CreatePredicate create_predicate)
+        -> std::vector<size_t> {
+    using Predicate = std::invoke_result_t<CreatePredicate&>;
+
+    auto const num_chunks{(num_items + cFilterChunkSize - 1) / cFilterChunkSize};
+    size_t num_threads{1};
+#ifdef CLP_FFI_JS_ENABLE_PTHREADS
+    // Helper threads must run on reserved workers, since a new worker can't start while the thread
+    // that created it is blocked waiting for the filtering to finish, and other workers may be held
+    // by decompression threads or other filters.
+    auto const max_num_threads{std::min<size_t>(
+            std::max(std::thread::hardware_concurrency(), 1U),
+            std::max<size_t>(num_chunks, 1)
+    )};
+    auto const worker_reservation{PthreadPoolReservation::reserve(max_num_threads - 1)};
+    num_threads += worker_reservation.get_num_workers();
+#endif
+
+    std::vector<Predicate> predicates;
+    predicates.reserve(num_threads);
+    for (size_t i{0}; i < num_threads; ++i) {
+        predicates.emplace_back(create_predicate());
+    }
+
+    if (1 == num_threads) {
+        std::vector<size_t> matching_indices;
+        for (size_t item_idx{0}; item_idx < num_items; ++item_idx) {
+            if (predicates.front()(item_idx)) {
+                matching_indices.push_back(item_idx);
+            }
+        }
+        return matching_indices;
+    }
+
+    std::vector<std::vector<size_t>> matching_indices_by_chunk(num_chunks);
+    std::atomic<size_t> next_chunk_idx{0};
+    std::vector<std::exception_ptr> exceptions(num_threads);
+    auto filter_chunks = [&](size_t thread_idx) {
+        auto& predicate{predicates[thread_idx]};
+        try {
+            for (auto chunk_idx{next_chunk_idx.fetch_add(1)}; chunk_idx < num_chunks;
+                 chunk_idx = next_chunk_idx.fetch_add(1))
+            {
+                auto const begin_idx{chunk_idx * cFilterChunkSize};
+                auto const end_idx{std::min(begin_idx + cFilterChunkSize, num_items)};
+                auto& chunk_matching_indices{matching_indices_by_chunk[chunk_idx]};
+                for (auto item_idx{begin_idx}; item_idx < end_idx; ++item_idx) {
+                    if (predicate(item_idx)) {
+                        chunk_matching_indices.push_back(item_idx);
+                    }
+                }
+            }
+        } catch (...) {
+            exceptions[thread_idx] = std::current_exception();
+            // Stop the other threads from claiming more chunks.
+            next_chunk_idx = num_chunks;
+        }
+    };
+
+#ifdef CLP_FFI_JS_ENABLE_PTHREADS
+    std::vector<std::thread> helper_threads;
+    helper_threads.reserve(num_threads - 1);
+    for (size_t thread_idx{1}; thread_idx < num_threads; ++thread_idx) {
+        helper_threads.emplace_back(filter_chunks, thread_idx);
+    }
+#endif
+    filter_chunks(0);
+#ifdef CLP_FFI_JS_ENABLE_PTHREADS
+    for (auto& helper_thread : helper_threads) {
+        helper_thread.join();
+    }
+#endif
+
+    for (auto const& exception : exceptions) {
+        if (nullptr != exception) {
+            std::rethrow_exception(exception);
+        }
+    }
+
+    size_t num_matching_indices{0};
+    for (auto const& chunk_matching_indices : matching_indices_by_chunk) {
+        num_matching_indices += chunk_matching_indices.size();
+    }
+    std::vector<size_t> matching_indices;
+    matching_indices.reserve(num_matching_indices);
+    for (auto const& chunk_matching_indices : matching_indices_by_chunk) {
+        matching_indices.insert(
+                matching_indices.end(),
+                chunk_matching_indices.cbegin(),
+                chunk_matching_indices.cend()
+        );
+    }
+    return matching_indices;
+}
+}  // namespace clp_ffi_js::ir
+
+#endif  // CLP_FFI_JS_IR_FILTERING_METHODS_HPP
@@ -0,0 +1,67 @@
+#include "formatting_methods.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <format>
+#include <sstream>
+#include <string>
+
+#include <clp/ir/types.hpp>
+#include <date/date.h>
+
+#include <clp_ffi_js/ir/LogEventFilterColumns.hpp>
+
+namespace clp_ffi_js::ir {
+auto append_iso8601_timestamp(
+        clp::ir::epoch_time_ms_t timestamp,
+        UtcOffset utc_offset,
+        std::string& output
+) -> void {
+    auto const local_time{
+            date::sys_time<std::chrono::milliseconds>{std::chrono::milliseconds{timestamp}}
+            + utc_offset
+    };
+    auto const local_day{date::floor<date::days>(local_time)};
+    date::year_month_day const date{local_day};
+    date::hh_mm_ss const time_of_day{local_time - local_day};
+    output.append(std::format(
+            "{:04}-{:02}-{:02}T{:02}:{:02}:{:02}.{:03}",
+            static_cast<int>(date.year()),
+            static_cast<unsigned>(date.month()),
+            static_cast<unsigned>(date.day()),
+            time_of_day.hours().count(),
+            time_of_day.minutes().count(),
+            time_of_day.seconds().count(),
+            time_of_day.subseconds().count()
+    ));
+
+    if (0 == utc_offset.count()) {
+        output.push_back('Z');
+        return;
+    }
+    auto const offset_minutes{std::abs(utc_offset.count())};
+    constexpr int cMinutesPerHour{60};
+    output.append(std::format(
+            "{}{:02}:{:02}",
+            utc_offset.count() < 0 ? '-' : '+',
+            offset_minutes / cMinutesPerHour,
+            offset_minutes % cMinutesPerHour
+    ));
+}
+
+auto append_formatted_local_time(
+        std::string const& format,
+        date::local_seconds local_time,
+        UtcOffset utc_offset,
+        std::string& output
+) -> bool {
+    std::ostringstream stream;
+    std::chrono::seconds const offset{utc_offset};
+    date::to_stream(stream, format.c_str(), local_time, nullptr, &offset);
+    if (stream.fail()) {
+        return false;
+    }
+    output.append(stream.view());
+    return true;
+}
+}  // namespace clp_ffi_js::ir
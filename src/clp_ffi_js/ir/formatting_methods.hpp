@@ -0,0 +1,42 @@
+#ifndef CLP_FFI_JS_IR_FORMATTING_METHODS_HPP
+#define CLP_FFI_JS_IR_FORMATTING_METHODS_HPP
+
+#include <string>
+
+#include <clp/ir/types.hpp>
+#include <date/date.h>
+
+#include <clp_ffi_js/ir/LogEventFilterColumns.hpp>
+
+namespace clp_ffi_js::ir {
+/**
+ * Appends a timestamp in ISO 8601 format with millisecond precision, in the time zone of the given
+ * UTC offset (e.g., `2024-05-01T13:04:05.123+02:00`, or `2024-05-01T11:04:05.123Z` in UTC).
+ * @param timestamp
+ * @param utc_offset
+ * @param output
+ */
+auto append_iso8601_timestamp(
+        clp::ir::epoch_time_ms_t timestamp,
+        UtcOffset utc_offset,
+        std::string& output
+) -> void;
+
+/**
+ * Appends a local time formatted with a `date::format` pattern.
+ * @param format A `date::format` pattern. `%z` is formatted with `utc_offset`, whereas `%Z` isn't
+ * supported since time zone abbreviations are unknown.
+ * @param local_time
+ * @param utc_offset The UTC offset of `local_time`.
+ * @param output
+ * @return Whether the local time could be formatted. On failure, `output` is unchanged.
+ */
+[[nodiscard]] auto append_formatted_local_time(
+        std::string const& format,
+        date::local_seconds local_time,
+        UtcOffset utc_offset,
+        std::string& output
+) -> bool;
+}  // namespace clp_ffi_js::ir
+
+#endif  // CLP_FFI_JS_IR_FORMATTING_METHODS_HPP
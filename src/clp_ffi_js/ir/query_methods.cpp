@@ -2,6 +2,7 @@
 
 #include <cstddef>
 #include <format>
+#include <functional>
 #include <memory>
 #include <sstream>
 #include <string>
@@ -13,6 +14,7 @@
 #include <clp/ErrorCode.hpp>
 #include <clp/ffi/ir_stream/decoding_methods.hpp>
 #include <clp/ffi/ir_stream/Deserializer.hpp>
+#include <clp/ffi/ir_stream/search/AstEvaluationResult.hpp>
 #include <clp/ffi/ir_stream/search/QueryHandler.hpp>
 #include <clp/ffi/KeyValuePairLogEvent.hpp>
 #include <clp/ffi/SchemaTree.hpp>
@@ -24,6 +26,8 @@
 
 #include <clp_ffi_js/ClpFfiJsException.hpp>
 #include <clp_ffi_js/ir/decoding_methods.hpp>
+#include <clp_ffi_js/ir/filtering_methods.hpp>
+#include <clp_ffi_js/ir/LogEvents.hpp>
 
 namespace clp_ffi_js::ir {
 namespace {
@@ -74,20 +78,61 @@ auto trivial_new_projected_schema_tree_node_callback(
 ) -> ystdlib::error_handling::Result<void> {
     return ystdlib::error_handling::success();
 }
-}  // namespace
 
-[[nodiscard]] auto
-collect_matched_log_event_indices(clp::ReaderInterface& reader, std::string const& query_string)
-        -> std::vector<size_t> {
+using TrivialQueryHandler = clp::ffi::ir_stream::search::QueryHandler<
+        decltype(&trivial_new_projected_schema_tree_node_callback)
+>;
+
+// The root of a schema tree is never inserted, so resolution starts at the node after it.
+constexpr clp::ffi::SchemaTree::Node::id_t cFirstInsertedNodeId{1};
+
+/**
+ * @param query_string
+ * @return A query handler for the given KQL query.
+ * @throws ClpFfiJsException if the query handler couldn't be created.
+ */
+[[nodiscard]] auto create_query_handler(std::string const& query_string) -> TrivialQueryHandler;
+
+/**
+ * Resolves the query's columns against the schema tree's nodes from `begin_node_id` onwards, in the
+ * order the nodes were inserted (i.e., by ID), as the deserializer would have while deserializing
+ * the stream.
+ * @param query_handler
+ * @param is_auto_generated
+ * @param schema_tree
+ * @param begin_node_id The ID of the first node to resolve the columns against. The columns must
+ * already have been resolved against every inserted node before it.
+ * @throws ClpFfiJsException if the columns couldn't be resolved.
+ */
+auto resolve_columns(
+        TrivialQueryHandler& query_handler,
+        bool is_auto_generated,
+        clp::ffi::SchemaTree const& schema_tree,
+        clp::ffi::SchemaTree::Node::id_t begin_node_id
+) -> void;
+
+/**
+ * @param query_handler A query handler whose columns have been resolved against `log_event`'s
+ * schema trees.
+ * @param log_event
+ * @param log_event_idx
+ * @return Whether `log_event` matches the query.
+ * @throws ClpFfiJsException if the query couldn't be evaluated.
+ */
+[[nodiscard]] auto evaluate_query(
+        TrivialQueryHandler& query_handler,
+        StructuredLogEvent const& log_event,
+        size_t log_event_idx
+) -> bool;
+
+auto create_query_handler(std::string const& query_string) -> TrivialQueryHandler {
     std::istringstream query_string_stream{query_string};
-    auto query_handler_result{
-            clp::ffi::ir_stream::search::
-                    QueryHandler<decltype(&trivial_new_projected_schema_tree_node_callback)>::
-                            create(&trivial_new_projected_schema_tree_node_callback,
-                                   clp_s::search::kql::parse_kql_expression(query_string_stream),
-                                   {},
-                                   false)
-    };
+    auto query_handler_result{TrivialQueryHandler::create(
+            &trivial_new_projected_schema_tree_node_callback,
+            clp_s::search::kql::parse_kql_expression(query_string_stream),
+            {},
+            false
+    )};
 
     if (query_handler_result.has_error()) {
         auto const error_code{query_handler_result.error()};
@@ -102,11 +147,69 @@ collect_matched_log_event_indices(clp::ReaderInterface& reader, std::string cons
                 )
         };
     }
+    return std::move(query_handler_result.value());
+}
+
+auto resolve_columns(
+        TrivialQueryHandler& query_handler,
+        bool is_auto_generated,
+        clp::ffi::SchemaTree const& schema_tree,
+        clp::ffi::SchemaTree::Node::id_t begin_node_id
+) -> void {
+    for (auto node_id{begin_node_id}; node_id < schema_tree.get_size(); ++node_id) {
+        auto const& node{schema_tree.get_node(node_id)};
+        auto const result{query_handler.update_partially_resolved_columns(
+                is_auto_generated,
+                {node.get_parent_id_unsafe(), node.get_key_name(), node.get_type()},
+                node_id
+        )};
+        if (result.has_error()) {
+            auto const error_code{result.error()};
+            throw ClpFfiJsException{
+                    clp::ErrorCode::ErrorCode_Failure,
+                    __FILENAME__,
+                    __LINE__,
+                    std::format(
+                            "Failed to resolve query columns: {} {}",
+                            error_code.category().name(),
+                            error_code.message()
+                    )
+            };
+        }
+    }
+}
+
+auto evaluate_query(
+        TrivialQueryHandler& query_handler,
+        StructuredLogEvent const& log_event,
+        size_t log_event_idx
+) -> bool {
+    auto const result{query_handler.evaluate_kv_pair_log_event(log_event)};
+    if (result.has_error()) {
+        auto const error_code{result.error()};
+        throw ClpFfiJsException{
+                clp::ErrorCode::ErrorCode_Failure,
+                __FILENAME__,
+                __LINE__,
+                std::format(
+                        "Failed to evaluate query on log event {}: {} {}",
+                        log_event_idx,
+                        error_code.category().name(),
+                        error_code.message()
+                )
+        };
+    }
+    return clp::ffi::ir_stream::search::AstEvaluationResult::True == result.value();
+}
+}  // namespace
 
+[[nodiscard]] auto
+collect_matched_log_event_indices(clp::ReaderInterface& reader, std::string const& query_string)
+        -> std::vector<size_t> {
     auto deserializer_result{clp::ffi::ir_stream::make_deserializer(
             reader,
             LogEventIndexIrUnitHandler{},
-            std::move(query_handler_result.value())
+            create_query_handler(query_string)
     )};
 
     if (deserializer_result.has_error()) {
@@ -127,4 +230,81 @@ collect_matched_log_event_indices(clp::ReaderInterface& reader, std::string cons
     deserialize_log_events(deserializer, reader);
     return deserializer.get_ir_unit_handler().get_deserialized_log_event_indices();
 }
+
+auto collect_matched_log_event_indices(
+        LogEvents<StructuredLogEvent> const& log_events,
+        std::string const& query_string,
+        size_t begin_idx
+) -> std::vector<size_t> {
+    auto matched_log_event_indices{collect_matching_indices(log_events.size() - begin_idx, [&]() {
+        // Each thread evaluates the query with its own handler, since evaluation updates the
+        // handler's state.
+        auto query_handler{create_query_handler(query_string)};
+        if (false == log_events.empty()) {
+            // All log events share the deserializer's schema trees, which only ever grow, so the
+            // last log event's trees contain every node referenced by any of the log events.
+            auto const& last_log_event{log_events.get_log_event(log_events.size() - 1)};
+            resolve_columns(
+                    query_handler,
+                    true,
+                    *last_log_event.get_auto_gen_keys_schema_tree(),
+                    cFirstInsertedNodeId
+            );
+            resolve_columns(
+                    query_handler,
+                    false,
+                    *last_log_event.get_user_gen_keys_schema_tree(),
+                    cFirstInsertedNodeId
+            );
+        }
+
+        return [&log_events, begin_idx, query_handler = std::move(query_handler)](
+                       size_t offset
+               ) mutable -> bool {
+            auto const log_event_idx{begin_idx + offset};
+            return evaluate_query(
+                    query_handler,
+                    log_events.get_log_event(log_event_idx),
+                    log_event_idx
+            );
+        };
+    })};
+    for (auto& log_event_idx : matched_log_event_indices) {
+        log_event_idx += begin_idx;
+    }
+    return matched_log_event_indices;
+}
+
+auto collect_matched_log_event_indices(
+        std::function<StructuredLogEvent(size_t)> const& decode_log_event,
+        std::string const& query_string,
+        size_t begin_idx,
+        size_t end_idx
+) -> std::vector<size_t> {
+    auto query_handler{create_query_handler(query_string)};
+    auto next_auto_gen_node_id{cFirstInsertedNodeId};
+    auto next_user_gen_node_id{cFirstInsertedNodeId};
+    std::vector<size_t> matched_log_event_indices;
+    for (auto log_event_idx{begin_idx}; log_event_idx < end_idx; ++log_event_idx) {
+        auto const log_event{decode_log_event(log_event_idx)};
+
+        // The schema trees only ever grow as the stream is decoded, so the columns only need to be
+        // resolved against the nodes inserted since the previous log event.
+        auto const& auto_gen_keys_schema_tree{*log_event.get_auto_gen_keys_schema_tree()};
+        resolve_columns(query_handler, true, auto_gen_keys_schema_tree, next_auto_gen_node_id);
+        next_auto_gen_node_id = static_cast<clp::ffi::SchemaTree::Node::id_t>(
+                auto_gen_keys_schema_tree.get_size()
+        );
+        auto const& user_gen_keys_schema_tree{*log_event.get_user_gen_keys_schema_tree()};
+        resolve_columns(query_handler, false, user_gen_keys_schema_tree, next_user_gen_node_id);
+        next_user_gen_node_id = static_cast<clp::ffi::SchemaTree::Node::id_t>(
+                user_gen_keys_schema_tree.get_size()
+        );
+
+        if (evaluate_query(query_handler, log_event, log_event_idx)) {
+            matched_log_event_indices.push_back(log_event_idx);
+        }
+    }
+    return matched_log_event_indices;
+}
 }  // namespace clp_ffi_js::ir
@@ -1,10 +1,14 @@
 #ifndef CLP_FFI_JS_IR_QUERY_METHODS_HPP
 #define CLP_FFI_JS_IR_QUERY_METHODS_HPP
 
+#include <cstddef>
+#include <functional>
+#include <string>
 #include <vector>
 
 #include <clp/ReaderInterface.hpp>
-#include <ystdlib/containers/Array.hpp>
+
+#include <clp_ffi_js/ir/LogEvents.hpp>
 
 namespace clp_ffi_js::ir {
 /**
@@ -21,6 +25,48 @@ namespace clp_ffi_js::ir {
 auto
 collect_matched_log_event_indices(clp::ReaderInterface& reader, std::string const& query_string)
         -> std::vector<size_t>;
+
+/**
+ * This function evaluates the given `query_string` against the already deserialized log events
+ * from `begin_idx` onwards, without decompressing or deserializing the IR stream again. The query's
+ * columns are resolved once against the log events' schema trees before the log events are
+ * scanned, in parallel in builds with pthreads enabled (see `collect_matching_indices`).
+ *
+ * @param log_events The log events deserialized from an IR stream, in stream order.
+ * @param query_string The query string to match against log events.
+ * @param begin_idx The index of the first log event to evaluate the query against, which must not
+ * exceed `log_events.size()`.
+ * @return A vector of indices (into `log_events`) of the log events that matched the query.
+ * @throws ClpFfiJsException if the Query couldn't be executed.
+ */
+auto collect_matched_log_event_indices(
+        LogEvents<StructuredLogEvent> const& log_events,
+        std::string const& query_string,
+        size_t begin_idx
+) -> std::vector<size_t>;
+
+/**
+ * This function evaluates the given `query_string` against the log events in `[begin_idx,
+ * end_idx)`, which are decoded one at a time by `decode_log_event` (e.g., from the checkpoints of a
+ * reader in windowed mode, which doesn't buffer log events). The query's columns are resolved
+ * against each log event's schema trees as they grow, so only the given log events are decoded.
+ *
+ * @param decode_log_event A function that returns the log event at the given index. It's called
+ * with ascending indices, and the log events it returns must have schema trees with the same node
+ * IDs as the IR stream's.
+ * @param query_string The query string to match against log events.
+ * @param begin_idx The index of the first log event to evaluate the query against.
+ * @param end_idx The index after the last log event to evaluate the query against.
+ * @return A vector of indices of the log events that matched the query.
+ * @throws ClpFfiJsException if the Query couldn't be executed.
+ * @throws Propagates `decode_log_event`'s exceptions.
+ */
+auto collect_matched_log_event_indices(
+        std::function<StructuredLogEvent(size_t)> const& decode_log_event,
+        std::string const& query_string,
+        size_t begin_idx,
+        size_t end_idx
+) -> std::vector<size_t>;
 }  // namespace clp_ffi_js::ir
 
 #endif  // CLP_FFI_JS_IR_QUERY_METHODS_HPP
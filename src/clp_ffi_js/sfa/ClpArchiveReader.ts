@@ -35,6 +35,49 @@ class ClpArchiveReader {
         return new ClpArchiveReader(new module.ClpSfaReader(dataArray));
     }
 
+    /**
+     * Creates a `ClpArchiveReader` instance from SFA archive data that `fill` writes directly into
+     * the WASM heap, avoiding the copy that {@link ClpArchiveReader.create} makes.
+     *
+     * @param size The size of the archive in bytes.
+     * @param fill Callback that writes the archive bytes into the view returned by `getView`. The
+     * view is invalidated if the WASM memory grows, so it should be re-acquired after every
+     * `await`.
+     * @return A promise for a new ClpArchiveReader instance.
+     * @throws {Error} If the archive data cannot be loaded or parsed.
+     * @throws {Error} Propagates `fill`'s exceptions.
+     */
+    static async createInPlace (
+        size: number,
+        fill: (getView: () => Uint8Array) => Promise<void> | void
+    ): Promise<ClpArchiveReader> {
+        const module = await getModule();
+        const inputBuffer = new module.ClpInputBuffer(size);
+        try {
+            await fill(() => inputBuffer.getView());
+
+            return new ClpArchiveReader(module.ClpSfaReader.createFromInputBuffer(inputBuffer));
+        } finally {
+            inputBuffer.delete();
+        }
+    }
+
+    /**
+     * Creates a `ClpArchiveReader` instance from the SFA archive in the given file, which the WASM
+     * module reads directly, without buffering the archive in JavaScript.
+     *
+     * NOTE: This is only available in Node.js.
+     *
+     * @param path The path of the SFA archive on the host's filesystem.
+     * @return A promise for a new ClpArchiveReader instance.
+     * @throws {Error} If the file cannot be read, or the archive cannot be loaded or parsed.
+     */
+    static async createFromFile (path: string): Promise<ClpArchiveReader> {
+        const module = await getModule();
+
+        return new ClpArchiveReader(module.ClpSfaReader.createFromFile(path));
+    }
+
     /**
      * Gets the number of log events in the SFA archive.
      *
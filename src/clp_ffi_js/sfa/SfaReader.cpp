@@ -1,9 +1,9 @@
 #include "SfaReader.hpp"
 
 #include <cstddef>
-#include <cstdint>
 #include <memory>
 #include <stdexcept>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -14,22 +14,42 @@
 #include <spdlog/spdlog.h>
 
 #include <clp_ffi_js/binding_types.hpp>
+#include <clp_ffi_js/FileDescriptorReader.hpp>
+#include <clp_ffi_js/InputBuffer.hpp>
 
 namespace clp_ffi_js::sfa {
 using clp_ffi_js::DataArrayTsType;
+using clp_ffi_js::FileDescriptorReader;
 using clp_ffi_js::StringArrayTsType;
 
 auto SfaReader::create(DataArrayTsType const& data_array) -> std::unique_ptr<SfaReader> {
-    auto const length{data_array["length"].as<size_t>()};
+    auto const length{get_data_array_length(data_array)};
     SPDLOG_INFO("SfaReader::create: got buffer of length={}", length);
 
     // Copy array from JavaScript to C++.
     std::vector<char> data_buffer(length);
-    // NOLINTBEGIN(cppcoreguidelines-pro-type-reinterpret-cast)
-    emscripten::val::module_property("HEAPU8")
-            .call<void>("set", data_array, reinterpret_cast<uintptr_t>(data_buffer.data()));
-    // NOLINTEND(cppcoreguidelines-pro-type-reinterpret-cast)
+    copy_data_array(data_array, data_buffer);
 
+    return create_from_data_buffer(std::move(data_buffer));
+}
+
+auto SfaReader::create_from_input_buffer(clp_ffi_js::InputBuffer& input_buffer)
+        -> std::unique_ptr<SfaReader> {
+    SPDLOG_INFO(
+            "SfaReader::create_from_input_buffer: got buffer of length={}",
+            input_buffer.get_size()
+    );
+    return create_from_data_buffer(input_buffer.release());
+}
+
+auto SfaReader::create_from_file(std::string const& path) -> std::unique_ptr<SfaReader> {
+    SPDLOG_INFO("SfaReader::create_from_file: got path={}", path);
+    // `ClpArchiveReader` only reads archives from memory.
+    return create_from_data_buffer(FileDescriptorReader::read_file(path));
+}
+
+auto SfaReader::create_from_data_buffer(std::vector<char>&& data_buffer)
+        -> std::unique_ptr<SfaReader> {
     auto reader_result{clp_s::ffi::sfa::ClpArchiveReader::create(std::move(data_buffer))};
 
     if (reader_result.has_error()) {
@@ -79,6 +99,18 @@ EMSCRIPTEN_BINDINGS(SfaReader) {
                     &clp_ffi_js::sfa::SfaReader::create,
                     emscripten::return_value_policy::take_ownership()
             )
+            .class_function(
+                    "createFromInputBuffer",
+                    &clp_ffi_js::sfa::SfaReader::create_from_input_buffer,
+                    emscripten::return_value_policy::take_ownership()
+            )
+#ifdef CLP_FFI_JS_ENVIRONMENT_NODE
+            .class_function(
+                    "createFromFile",
+                    &clp_ffi_js::sfa::SfaReader::create_from_file,
+                    emscripten::return_value_policy::take_ownership()
+            )
+#endif
             .function("getEventCount", &clp_ffi_js::sfa::SfaReader::get_event_count)
             .function("getFileNames", &clp_ffi_js::sfa::SfaReader::get_file_names)
             .function("getFileInfos", &clp_ffi_js::sfa::SfaReader::get_file_infos);
@@ -3,12 +3,15 @@
 
 #include <cstdint>
 #include <memory>
+#include <string>
 #include <utility>
+#include <vector>
 
 #include <clp_s/ffi/sfa/ClpArchiveReader.hpp>
 #include <emscripten/val.h>
 
 #include <clp_ffi_js/binding_types.hpp>
+#include <clp_ffi_js/InputBuffer.hpp>
 
 namespace clp_ffi_js::sfa {
 EMSCRIPTEN_DECLARE_VAL_TYPE(FileInfoArrayTsType);
@@ -25,6 +28,31 @@ public:
     [[nodiscard]] static auto create(clp_ffi_js::DataArrayTsType const& data_array)
             -> std::unique_ptr<SfaReader>;
 
+    /**
+     * Creates an `SfaReader` that takes ownership of the given buffer rather than copying it.
+     *
+     * @param input_buffer A buffer containing an SFA archive. It's empty after this call.
+     * @return The created instance.
+     * @throw std::runtime_error if the archive cannot be opened.
+     */
+    [[nodiscard]] static auto create_from_input_buffer(clp_ffi_js::InputBuffer& input_buffer)
+            -> std::unique_ptr<SfaReader>;
+
+    /**
+     * Creates an `SfaReader` from the archive in the given file, reading it directly into the WASM
+     * heap rather than through a JavaScript buffer.
+     *
+     * NOTE: This is only exposed to JavaScript in Node.js builds, where paths refer to the host's
+     * filesystem.
+     *
+     * @param path The path of a file containing an SFA archive.
+     * @return The created instance.
+     * @throw ClpFfiJsException if the file couldn't be read.
+     * @throw std::runtime_error if the archive cannot be opened.
+     */
+    [[nodiscard]] static auto create_from_file(std::string const& path)
+            -> std::unique_ptr<SfaReader>;
+
     [[nodiscard]] auto get_event_count() const -> uint64_t { return m_reader.get_event_count(); }
 
     [[nodiscard]] auto get_file_names() const -> clp_ffi_js::StringArrayTsType;
@@ -32,6 +60,14 @@ public:
     [[nodiscard]] auto get_file_infos() const -> FileInfoArrayTsType;
 
 private:
+    /**
+     * @param data_buffer A buffer containing an SFA archive.
+     * @return The created instance.
+     * @throw std::runtime_error if the archive cannot be opened.
+     */
+    [[nodiscard]] static auto create_from_data_buffer(std::vector<char>&& data_buffer)
+            -> std::unique_ptr<SfaReader>;
+
     explicit SfaReader(clp_s::ffi::sfa::ClpArchiveReader&& reader) : m_reader(std::move(reader)) {}
 
     clp_s::ffi::sfa::ClpArchiveReader m_reader;
@@ -0,0 +1,81 @@
+import {
+    afterEach,
+    beforeAll,
+    describe,
+    expect,
+    it,
+} from "vitest";
+
+import {
+    type ClpStreamReader,
+    createModule,
+    createReader,
+    isNodeRuntime,
+    loadTestData,
+    type MainModule,
+} from "./utils.js";
+
+
+/**
+ * Absolute path to a build of the Node.js module (`ClpFfiJs-node`) from before structured log
+ * events were serialized without `nlohmann::json` values, i.e., one whose messages are dumped from
+ * the result of `KeyValuePairLogEvent::serialize_to_json`. The tests only run if it's set.
+ */
+const BASELINE_MODULE_PATH: unknown =
+
+    // @ts-expect-error TS4111: property comes from index signature
+    import.meta.env.VITE_BASELINE_NODE_MODULE_ABS_PATH;
+
+describe.runIf(isNodeRuntime() && "string" === typeof BASELINE_MODULE_PATH)(
+    "ClpStreamReader baseline messages",
+    () => {
+        let module: MainModule;
+        let baselineModule: MainModule;
+        let readers: ClpStreamReader[] = [];
+
+        beforeAll(async () => {
+            module = await createModule();
+            const {default: factory} = (
+                // eslint-disable-next-line no-inline-comments
+                await import(/* @vite-ignore */ BASELINE_MODULE_PATH as string)
+            ) as {default: () => Promise<MainModule>};
+            baselineModule = await factory();
+        });
+
+        afterEach(() => {
+            for (const reader of readers) {
+                reader.delete();
+            }
+            readers = [];
+        });
+
+        it("should decode the same structured messages as the baseline module", async () => {
+            const data = await loadTestData("structured-cockroachdb.clp.zst");
+            const reader = createReader(module, data);
+            readers.push(reader);
+            const baselineReader = createReader(baselineModule, data);
+            readers.push(baselineReader);
+            const numEvents = baselineReader.deserializeStream();
+            expect(reader.deserializeStream()).toBe(numEvents);
+
+            // The messages recorded by the baseline module are the golden messages, compared as
+            // bytes so that escapes, float digits, and replaced invalid UTF-8 sequences must all
+            // match exactly.
+            const goldenMessages = (baselineReader.decodeRange(0, numEvents, false) ?? [])
+                .map(({message}) => message);
+            expect(goldenMessages.length).toBe(numEvents);
+            expect((reader.decodeRange(0, numEvents, false) ?? []).map(({message}) => message))
+                .toEqual(goldenMessages);
+
+            const binaryResults = reader.decodeRangeBinary(0, numEvents, false);
+            expect(binaryResults).not.toBeNull();
+            const textEncoder = new TextEncoder();
+            goldenMessages.forEach((goldenMessage, idx) => {
+                expect(binaryResults?.messages.subarray(
+                    binaryResults.messageOffsets[idx],
+                    binaryResults.messageOffsets[idx + 1]
+                )).toEqual(textEncoder.encode(goldenMessage));
+            });
+        });
+    }
+);
@@ -6,7 +6,11 @@ import {
     it,
 } from "vitest";
 
-import {loadTestData} from "./utils.js";
+import {
+    getTestDataPath,
+    isNodeRuntime,
+    loadTestData,
+} from "./utils.js";
 
 
 const CLP_JSON_TEST_LOG_FILES_EXPECTED_FILE_COUNT = 9;
@@ -62,6 +66,21 @@ describe("ClpArchiveReader", () => {
         expect(sum).toBe(CLP_JSON_TEST_LOG_FILES_EXPECTED_EVENT_COUNT);
     });
 
+    it("should read sfa archive written in place into the WASM heap", async () => {
+        const data = await loadTestData("postgresql.clp");
+        reader = await ClpArchiveReader.createInPlace(data.length, (getView) => {
+            getView().set(data);
+        });
+
+        expect(reader.getEventCount()).toBe(POSTGRESQL_EXPECTED_EVENT_COUNT);
+    });
+
+    it.runIf(isNodeRuntime())("should read sfa archive from a file", async () => {
+        reader = await ClpArchiveReader.createFromFile(getTestDataPath("cockroachdb.clp"));
+
+        expect(reader.getEventCount()).toBe(COCKROACHDB_EXPECTED_EVENT_COUNT);
+    });
+
     it("should throw when calling getEventCount after close", async () => {
         const closedReader = await createReaderFromArchive("postgresql.clp");
         closedReader.close();
@@ -0,0 +1,130 @@
+import {
+    afterEach,
+    beforeAll,
+    describe,
+    expect,
+    it,
+} from "vitest";
+
+import {DEFAULT_READER_OPTIONS} from "./constants.js";
+import {
+    type ClpMergedStreamReader,
+    type ClpStreamReader,
+    createModule,
+    createReader,
+    getTestDataPath,
+    isNodeRuntime,
+    loadTestData,
+    type MainModule,
+} from "./utils.js";
+
+
+const FILENAMES = [
+    "unstructured-yarn.clp.zst",
+    "structured-cockroachdb.clp.zst",
+];
+
+let module: MainModule;
+
+beforeAll(async () => {
+    module = await createModule();
+});
+
+describe("ClpMergedStreamReader", () => {
+    let mergedReader: ClpMergedStreamReader | null = null;
+    let streamReaders: ClpStreamReader[] = [];
+
+    afterEach(() => {
+        mergedReader?.delete();
+        mergedReader = null;
+        streamReaders.forEach((reader) => {
+            reader.delete();
+        });
+        streamReaders = [];
+    });
+
+    it("should reject an empty list of streams", () => {
+        expect(() => new module.ClpMergedStreamReader([], DEFAULT_READER_OPTIONS)).toThrow();
+    });
+
+    it("should merge the log events of several streams in chronological order", async () => {
+        const dataArrays = await Promise.all(FILENAMES.map(loadTestData));
+        streamReaders = dataArrays.map((data) => createReader(module, data));
+        const streamResults = streamReaders.map((reader) => {
+            const numEvents = reader.deserializeStream();
+            return reader.decodeRange(0, numEvents, false) ?? [];
+        });
+
+        mergedReader = new module.ClpMergedStreamReader(dataArrays, DEFAULT_READER_OPTIONS);
+        expect(mergedReader.getNumStreams()).toBe(FILENAMES.length);
+        const numEvents = mergedReader.deserializeStream();
+        expect(numEvents).toBe(streamResults.reduce((sum, results) => sum + results.length, 0));
+        expect(mergedReader.getNumEventsBuffered()).toBe(numEvents);
+
+        const mergedResults = mergedReader.decodeRange(0, numEvents, false) ?? [];
+        expect(mergedResults.length).toBe(numEvents);
+        mergedResults.forEach((result, idx) => {
+            expect(result.logEventNum).toBe(idx + 1);
+            const {streamId, streamLogEventNum, ...streamResult} = result;
+            expect(streamResult).toEqual({
+                ...streamResults[streamId]?.[streamLogEventNum - 1],
+                logEventNum: idx + 1,
+            });
+            if (0 < idx) {
+                expect((mergedResults[idx - 1] as {timestamp: bigint}).timestamp)
+                    .toBeLessThanOrEqual(result.timestamp);
+            }
+        });
+
+        const middleResult = mergedResults[Math.floor(numEvents / 2)];
+        const nearestIdx = mergedReader.findNearestLogEventByTimestamp(
+            middleResult?.timestamp ?? 0n
+        );
+        expect(mergedResults[nearestIdx ?? 0]?.timestamp).toBe(middleResult?.timestamp);
+        expect(mergedResults[(nearestIdx ?? 0) + 1]?.timestamp ?? Infinity)
+            .toBeGreaterThan(middleResult?.timestamp ?? 0n);
+    });
+
+    it("should map the streams' filtered log events into the merged collection", async () => {
+        const dataArrays = await Promise.all(FILENAMES.map(loadTestData));
+        const selectedLogLevels = [3];
+        streamReaders = dataArrays.map((data) => createReader(module, data));
+        const numFilteredEvents = streamReaders.reduce((sum, reader) => {
+            reader.deserializeStream();
+            reader.filterLogEvents(selectedLogLevels);
+            return sum + (reader.getFilteredLogEventMap()?.length ?? 0);
+        }, 0);
+
+        mergedReader = new module.ClpMergedStreamReader(dataArrays, DEFAULT_READER_OPTIONS);
+        expect(mergedReader.getFilteredLogEventMap()).toBeNull();
+        const numEvents = mergedReader.deserializeStream();
+        mergedReader.filterLogEvents(selectedLogLevels);
+
+        const filteredMap = mergedReader.getFilteredLogEventMap() ?? [];
+        expect(filteredMap.length).toBe(numFilteredEvents);
+        const filteredResults = mergedReader.decodeRange(0, filteredMap.length, true) ?? [];
+        const mergedResults = mergedReader.decodeRange(0, numEvents, false) ?? [];
+        filteredResults.forEach((result, idx) => {
+            expect(selectedLogLevels).toContain(result.logLevel);
+            expect(result).toEqual(mergedResults[filteredMap[idx] ?? 0]);
+        });
+    });
+
+    it.runIf(isNodeRuntime())("should merge streams read from files", async () => {
+        const dataArrays = await Promise.all(FILENAMES.map(loadTestData));
+        const bufferedReader = new module.ClpMergedStreamReader(
+            dataArrays,
+            DEFAULT_READER_OPTIONS
+        );
+        const numEvents = bufferedReader.deserializeStream();
+
+        mergedReader = module.ClpMergedStreamReader.createFromFiles(
+            FILENAMES.map(getTestDataPath),
+            DEFAULT_READER_OPTIONS
+        );
+        expect(mergedReader.deserializeStream()).toBe(numEvents);
+        expect(mergedReader.decodeRange(0, numEvents, false))
+            .toEqual(bufferedReader.decodeRange(0, numEvents, false));
+        bufferedReader.delete();
+    });
+});
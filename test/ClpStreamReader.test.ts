@@ -7,15 +7,21 @@ import {
 } from "vitest";
 
 import {
+    BUILD_INDEX_CLI_PATH,
+    DEFAULT_READER_OPTIONS,
     IR_STREAM_TYPE_STRUCTURED,
     IR_STREAM_TYPE_UNSTRUCTURED,
 } from "./constants.js";
 import {
+    assertNonNull,
     type ClpStreamReader,
     createModule,
     createReader,
+    getTestDataPath,
+    isNodeRuntime,
     loadTestData,
     type MainModule,
+    useReaderFixtures,
 } from "./utils.js";
 
 
@@ -60,4 +66,947 @@ describe("ClpStreamReader", () => {
 
         expect(reader.getIrStreamType()).toBe(module.IrStreamType.UNSTRUCTURED);
     });
+
+    it("should decode structured log events as JSON objects of merged kv-pairs", async () => {
+        const data = await loadTestData("structured-cockroachdb.clp.zst");
+        reader = createReader(module, data);
+        const numEvents = reader.deserializeStream();
+
+        const decodedResults = reader.decodeRange(0, numEvents, false) ?? [];
+        expect(decodedResults.length).toBe(numEvents);
+        for (const {message} of decodedResults) {
+            expect(Object.keys(JSON.parse(message) as object)).toEqual([
+                module.MERGED_KV_PAIRS_AUTO_GENERATED_KEY,
+                module.MERGED_KV_PAIRS_USER_GENERATED_KEY,
+            ]);
+        }
+    });
+
+    it("should decode structured log events as valid UTF-8", async () => {
+        const data = await loadTestData("structured-cockroachdb.clp.zst");
+        reader = createReader(module, data);
+        const numEvents = reader.deserializeStream();
+
+        // Invalid UTF-8 sequences must have been replaced, so the messages' bytes are valid UTF-8.
+        const binaryResults = reader.decodeRangeBinary(0, numEvents, false);
+        assertNonNull(binaryResults);
+        const textDecoder = new TextDecoder("utf-8", {fatal: true});
+        expect(() => textDecoder.decode(binaryResults.messages)).not.toThrow();
+    });
+});
+
+describe("ClpStreamReader input buffers", () => {
+    const {filenames, manage} = useReaderFixtures();
+
+    it("should create a reader that takes ownership of an input buffer", async () => {
+        const data = await loadTestData("unstructured-yarn.clp.zst");
+        const inputBuffer = new module.ClpInputBuffer(data.length);
+        inputBuffer.getView().set(data);
+        const reader = manage(
+            module.ClpStreamReader.createFromInputBuffer(inputBuffer, DEFAULT_READER_OPTIONS)
+        );
+
+        expect(inputBuffer.getSize()).toBe(0);
+        inputBuffer.delete();
+        expect(reader.getIrStreamType()).toBe(module.IrStreamType.UNSTRUCTURED);
+        expect(reader.deserializeStream()).toBeGreaterThan(0);
+    });
+
+    it.runIf(isNodeRuntime()).each(filenames)(
+        "should create a reader that reads %s from a file",
+        async (filename) => {
+            const data = await loadTestData(filename);
+            const bufferedReader = manage(createReader(module, data));
+            const numEvents = bufferedReader.deserializeStream();
+
+            const reader = manage(module.ClpStreamReader.createFromFile(
+                getTestDataPath(filename),
+                DEFAULT_READER_OPTIONS
+            ));
+            expect(reader.deserializeStream()).toBe(numEvents);
+            expect(reader.decodeRange(0, numEvents, false))
+                .toEqual(bufferedReader.decodeRange(0, numEvents, false));
+        }
+    );
+
+    it.runIf(isNodeRuntime())("should reject a file that doesn't exist", () => {
+        expect(() => module.ClpStreamReader.createFromFile(
+            getTestDataPath("nonexistent.clp.zst"),
+            DEFAULT_READER_OPTIONS
+        )).toThrow();
+    });
+});
+
+describe("ClpStreamReader streaming ingestion", () => {
+    // Large enough for the first chunk to contain a whole Zstandard block, and so the preamble.
+    // eslint-disable-next-line no-magic-numbers
+    const CHUNK_SIZE = 256 * 1024;
+    const TRUNCATED_PREAMBLE_SIZE = 4;
+
+    const {filenames, manage} = useReaderFixtures();
+
+    it.each(filenames)("should deserialize %s appended in chunks", async (filename) => {
+        const data = await loadTestData(filename);
+        const fullReader = manage(createReader(module, data));
+        const numEvents = fullReader.deserializeStream();
+
+        const streamingReader = manage(module.ClpStreamReader.createStreaming(
+            data.subarray(0, CHUNK_SIZE),
+            DEFAULT_READER_OPTIONS
+        ));
+        let numEventsBuffered = streamingReader.deserializeStream();
+        for (let offset = CHUNK_SIZE; offset < data.length; offset += CHUNK_SIZE) {
+            streamingReader.appendData(data.subarray(offset, offset + CHUNK_SIZE));
+            const numEventsBufferedAfterAppend = streamingReader.deserializeStream();
+            expect(numEventsBufferedAfterAppend).toBeGreaterThanOrEqual(numEventsBuffered);
+            numEventsBuffered = numEventsBufferedAfterAppend;
+        }
+        streamingReader.markEndOfInput();
+
+        expect(streamingReader.deserializeStream()).toBe(numEvents);
+        expect(streamingReader.decodeRange(0, numEvents, false))
+            .toEqual(fullReader.decodeRange(0, numEvents, false));
+    });
+
+    it.each([
+        ["structured-cockroachdb.clp.zst", null, "*: *error*"],
+        ["structured-cockroachdb.clp.zst", [3], ""],
+        ["unstructured-yarn.clp.zst", [3], "container_*_01_"],
+    ])("should filter %s incrementally as it's appended", async (filename, logLevels, query) => {
+        const data = await loadTestData(filename);
+        const fullReader = manage(createReader(module, data));
+        fullReader.deserializeStream();
+        fullReader.filterLogEvents(logLevels, query);
+        const expectedMap = fullReader.getFilteredLogEventMap() ?? [];
+
+        const streamingReader = manage(module.ClpStreamReader.createStreaming(
+            data.subarray(0, CHUNK_SIZE),
+            DEFAULT_READER_OPTIONS
+        ));
+        streamingReader.filterLogEvents(logLevels, query);
+        for (let offset = CHUNK_SIZE; offset < data.length; offset += CHUNK_SIZE) {
+            const numEventsBuffered = streamingReader.deserializeStream();
+            expect(streamingReader.getFilteredLogEventMap())
+                .toEqual(expectedMap.filter((idx) => idx < numEventsBuffered));
+            streamingReader.appendData(data.subarray(offset, offset + CHUNK_SIZE));
+        }
+        streamingReader.markEndOfInput();
+        streamingReader.deserializeStream();
+
+        expect(streamingReader.getFilteredLogEventMap()).toEqual(expectedMap);
+    });
+
+    it("should reject an initial chunk without the entire preamble", async () => {
+        const data = await loadTestData("structured-cockroachdb.clp.zst");
+
+        expect(() => module.ClpStreamReader.createStreaming(
+            data.subarray(0, TRUNCATED_PREAMBLE_SIZE),
+            DEFAULT_READER_OPTIONS
+        )).toThrow();
+    });
+});
+
+describe("ClpStreamReader incremental deserialization", () => {
+    const MAX_EVENTS = 1000;
+    // eslint-disable-next-line no-magic-numbers
+    const MAX_BYTES = 64 * 1024;
+
+    const {filenames, manage} = useReaderFixtures();
+
+    it.each(filenames)("should deserialize %s in batches", async (filename) => {
+        const data = await loadTestData(filename);
+        const fullReader = manage(createReader(module, data));
+        const numEvents = fullReader.deserializeStream();
+
+        const incrementalReader = manage(createReader(module, data));
+        let progress = incrementalReader.deserializeNext({maxEvents: MAX_EVENTS});
+        expect(progress.numEventsBuffered).toBe(Math.min(MAX_EVENTS, numEvents));
+        expect(incrementalReader.decodeRange(0, progress.numEventsBuffered, false))
+            .toEqual(fullReader.decodeRange(0, progress.numEventsBuffered, false));
+
+        while (false === progress.isDone) {
+            const {numBytesConsumed, numEventsBuffered} = progress;
+            progress = incrementalReader.deserializeNext({maxBytes: MAX_BYTES});
+            expect(progress.numEventsBuffered).toBeGreaterThanOrEqual(numEventsBuffered);
+            expect(progress.numBytesConsumed).toBeGreaterThan(numBytesConsumed);
+        }
+
+        expect(progress.numEventsBuffered).toBe(numEvents);
+        expect(incrementalReader.deserializeStream()).toBe(numEvents);
+        expect(incrementalReader.decodeRange(0, numEvents, false))
+            .toEqual(fullReader.decodeRange(0, numEvents, false));
+    });
+
+    it("should reject non-positive limits", async () => {
+        const data = await loadTestData("unstructured-yarn.clp.zst");
+        const incrementalReader = manage(createReader(module, data));
+
+        expect(() => incrementalReader.deserializeNext({maxEvents: 0})).toThrow();
+    });
+});
+
+describe("ClpStreamReader windowed mode", () => {
+    const CHECKPOINT_INTERVAL = 1000;
+
+    const {filenames, manage} = useReaderFixtures();
+
+    it.each(filenames)("should decode %s from checkpoints", async (filename) => {
+        const data = await loadTestData(filename);
+        const fullReader = manage(createReader(module, data));
+        const numEvents = fullReader.deserializeStream();
+
+        const windowedReader = manage(createReader(module, data, {
+            ...DEFAULT_READER_OPTIONS,
+            checkpointInterval: CHECKPOINT_INTERVAL,
+        }));
+        expect(windowedReader.deserializeStream()).toBe(numEvents);
+
+        // Decode out of order so that both resuming from checkpoints and continuing from the
+        // previously decoded log event are exercised.
+        const tailBeginIdx = Math.max(0, numEvents - CHECKPOINT_INTERVAL);
+        expect(windowedReader.decodeRange(tailBeginIdx, numEvents, false))
+            .toEqual(fullReader.decodeRange(tailBeginIdx, numEvents, false));
+        expect(windowedReader.decodeRange(0, numEvents, false))
+            .toEqual(fullReader.decodeRange(0, numEvents, false));
+    });
+});
+
+describe("ClpStreamReader snapshots", () => {
+    const CHECKPOINT_INTERVAL = 1000;
+    const WINDOWED_READER_OPTIONS = {
+        ...DEFAULT_READER_OPTIONS,
+        checkpointInterval: CHECKPOINT_INTERVAL,
+    };
+
+    const {filenames, manage} = useReaderFixtures();
+
+    it.each(filenames)("should restore a reader for %s from a snapshot", async (filename) => {
+        const data = await loadTestData(filename);
+        const windowedReader = manage(createReader(module, data, WINDOWED_READER_OPTIONS));
+        const numEvents = windowedReader.deserializeStream();
+        const snapshot = windowedReader.serializeSnapshot();
+
+        const restoredReader = manage(module.ClpStreamReader.createFromSnapshot(
+            data,
+            snapshot,
+            WINDOWED_READER_OPTIONS
+        ));
+        expect(restoredReader.getIrStreamType()).toBe(windowedReader.getIrStreamType());
+        expect(restoredReader.getMetadata()).toEqual(windowedReader.getMetadata());
+        expect(restoredReader.getNumEventsBuffered()).toBe(numEvents);
+        expect(restoredReader.deserializeStream()).toBe(numEvents);
+
+        const restoredColumns = restoredReader.getFilterDataColumns();
+        const originalColumns = windowedReader.getFilterDataColumns();
+        expect(Array.from(restoredColumns.logLevels))
+            .toEqual(Array.from(originalColumns.logLevels));
+        expect(Array.from(restoredColumns.timestamps))
+            .toEqual(Array.from(originalColumns.timestamps));
+        expect(Array.from(restoredColumns.utcOffsets))
+            .toEqual(Array.from(originalColumns.utcOffsets));
+
+        expect(restoredReader.decodeRange(0, numEvents, false))
+            .toEqual(windowedReader.decodeRange(0, numEvents, false));
+
+        // eslint-disable-next-line no-magic-numbers
+        const selectedLogLevels = [4, 5];
+        restoredReader.filterLogEvents(selectedLogLevels);
+        windowedReader.filterLogEvents(selectedLogLevels);
+        expect(restoredReader.getFilteredLogEventMap())
+            .toEqual(windowedReader.getFilteredLogEventMap());
+    });
+
+    it("should reject snapshots it can't serialize or restore", async () => {
+        const data = await loadTestData("unstructured-yarn.clp.zst");
+        const otherData = await loadTestData("structured-cockroachdb.clp.zst");
+
+        // Only readers in windowed mode that have deserialized the entire stream have snapshots.
+        const bufferedReader = manage(createReader(module, data));
+        bufferedReader.deserializeStream();
+        expect(() => bufferedReader.serializeSnapshot()).toThrow();
+
+        const windowedReader = manage(createReader(module, data, WINDOWED_READER_OPTIONS));
+        expect(() => windowedReader.serializeSnapshot()).toThrow();
+        windowedReader.deserializeStream();
+        const snapshot = windowedReader.serializeSnapshot();
+
+        expect(() => module.ClpStreamReader.createFromSnapshot(
+            otherData,
+            snapshot,
+            WINDOWED_READER_OPTIONS
+        )).toThrow();
+        expect(() => module.ClpStreamReader.createFromSnapshot(
+            data,
+            snapshot.subarray(0, -1),
+            WINDOWED_READER_OPTIONS
+        )).toThrow();
+    });
+});
+
+describe.runIf(isNodeRuntime())("ClpStreamReader sidecar indexes", () => {
+    const CHECKPOINT_INTERVAL = 1000;
+
+    const {filenames, manage} = useReaderFixtures();
+    let tmpDir: string | null = null;
+
+    afterEach(async () => {
+        if (null !== tmpDir) {
+            const {rm} = await import("node:fs/promises");
+            await rm(tmpDir, {recursive: true, force: true});
+            tmpDir = null;
+        }
+    });
+
+    it.each(filenames)(
+        "should open %s with an index without deserializing it",
+        async (filename) => {
+            const {mkdtemp, readFile} = await import("node:fs/promises");
+            const {tmpdir} = await import("node:os");
+            const {join} = await import("node:path");
+
+            const dir = await mkdtemp(join(tmpdir(), "clp-ffi-js-index-"));
+            tmpDir = dir;
+            const indexPath = join(dir, `${filename}.index`);
+            const streamPath = getTestDataPath(filename);
+            const numEvents = module.ClpStreamReader.buildIndexFile(
+                streamPath,
+                indexPath,
+                DEFAULT_READER_OPTIONS
+            );
+            const index = new Uint8Array(await readFile(indexPath));
+
+            const bufferedReader = manage(createReader(module, await loadTestData(filename)));
+            expect(bufferedReader.deserializeStream()).toBe(numEvents);
+
+            const indexedReader = manage(module.ClpStreamReader.createFromFile(
+                streamPath,
+                {...DEFAULT_READER_OPTIONS, index}
+            ));
+            expect(indexedReader.getNumEventsBuffered()).toBe(numEvents);
+            expect(indexedReader.getLogLevelCounts()).toEqual(bufferedReader.getLogLevelCounts());
+
+            const {timestamps} = bufferedReader.getFilterDataColumns();
+            const targetTs = timestamps[Math.floor(numEvents / 2)] ?? 0n;
+            expect(indexedReader.findNearestLogEventByTimestamp(targetTs))
+                .toBe(bufferedReader.findNearestLogEventByTimestamp(targetTs));
+
+            // eslint-disable-next-line no-magic-numbers
+            const selectedLogLevels = [4, 5];
+            indexedReader.filterLogEvents(selectedLogLevels);
+            bufferedReader.filterLogEvents(selectedLogLevels);
+            expect(indexedReader.getFilteredLogEventMap())
+                .toEqual(bufferedReader.getFilteredLogEventMap());
+            expect(indexedReader.decodeRange(0, numEvents, false))
+                .toEqual(bufferedReader.decodeRange(0, numEvents, false));
+        }
+    );
+
+    it("should open a stream with an index built by the command-line tool", async () => {
+        const {execFile} = await import("node:child_process");
+        const {mkdtemp, readFile} = await import("node:fs/promises");
+        const {tmpdir} = await import("node:os");
+        const {join} = await import("node:path");
+        const {fileURLToPath} = await import("node:url");
+        const {promisify} = await import("node:util");
+
+        const dir = await mkdtemp(join(tmpdir(), "clp-ffi-js-index-"));
+        tmpDir = dir;
+        const cliIndexPath = join(dir, "cli.index");
+        const apiIndexPath = join(dir, "api.index");
+        const streamPath = getTestDataPath("structured-cockroachdb.clp.zst");
+        const cliPath = fileURLToPath(new URL(BUILD_INDEX_CLI_PATH, import.meta.url));
+        const runCli = async (args: string[]) => promisify(execFile)(
+            process.execPath,
+            [cliPath, ...args]
+        );
+
+        await runCli([
+            "--checkpoint-interval",
+            String(CHECKPOINT_INTERVAL),
+            "--log-level-key",
+            "level",
+            "--timestamp-key",
+            "auto-generated.timestamp",
+            streamPath,
+            cliIndexPath,
+        ]);
+        const readerOptions = {
+            logLevelKey: {isAutoGenerated: false, parts: ["level"]},
+            timestampKey: {isAutoGenerated: true, parts: ["timestamp"]},
+            utcOffsetKey: null,
+        };
+        const numEvents = module.ClpStreamReader.buildIndexFile(streamPath, apiIndexPath, {
+            ...readerOptions,
+            checkpointInterval: CHECKPOINT_INTERVAL,
+        });
+        const index = new Uint8Array(await readFile(cliIndexPath));
+        expect(index).toEqual(new Uint8Array(await readFile(apiIndexPath)));
+
+        const indexedReader = manage(module.ClpStreamReader.createFromFile(
+            streamPath,
+            {...readerOptions, index}
+        ));
+        expect(indexedReader.getNumEventsBuffered()).toBe(numEvents);
+        const bufferedReader = manage(
+            createReader(module, await loadTestData("structured-cockroachdb.clp.zst"))
+        );
+        expect(bufferedReader.deserializeStream()).toBe(numEvents);
+        expect(indexedReader.decodeRange(0, numEvents, false))
+            .toEqual(bufferedReader.decodeRange(0, numEvents, false));
+
+        // A prefix without a key path is rejected.
+        await expect(runCli([
+            "--timestamp-key",
+            "auto-generated.",
+            streamPath,
+            cliIndexPath,
+        ])).rejects.toThrow();
+    });
+
+    it("should reject an index built from a different stream", async () => {
+        const {mkdtemp, readFile} = await import("node:fs/promises");
+        const {tmpdir} = await import("node:os");
+        const {join} = await import("node:path");
+
+        const dir = await mkdtemp(join(tmpdir(), "clp-ffi-js-index-"));
+        tmpDir = dir;
+        const indexPath = join(dir, "index");
+        module.ClpStreamReader.buildIndexFile(
+            getTestDataPath("unstructured-yarn.clp.zst"),
+            indexPath,
+            DEFAULT_READER_OPTIONS
+        );
+        const index = new Uint8Array(await readFile(indexPath));
+        const data = await loadTestData("unstructured-yarn.clp.zst");
+
+        expect(() => module.ClpStreamReader.createFromFile(
+            getTestDataPath("structured-cockroachdb.clp.zst"),
+            {...DEFAULT_READER_OPTIONS, index}
+        )).toThrow();
+
+        // Readers in streaming mode can't use an index, even one built from the same stream.
+        expect(() => module.ClpStreamReader.createStreaming(
+            data,
+            {...DEFAULT_READER_OPTIONS, index}
+        )).toThrow();
+    });
+});
+
+describe("ClpStreamReader KQL filtering", () => {
+    const CHECKPOINT_INTERVAL = 1000;
+    const BATCH_SIZE = 700;
+
+    const {manage} = useReaderFixtures();
+
+    it.each([
+        "*: *error*",
+        "NOT *: *error*",
+    ])("should match the same log events for %s in and out of memory", async (kqlFilter) => {
+        const data = await loadTestData("structured-cockroachdb.clp.zst");
+
+        // The buffered reader evaluates the query against its buffered log events, whereas the
+        // windowed reader decodes the log events from its checkpoints.
+        const bufferedReader = manage(createReader(module, data));
+        bufferedReader.deserializeStream();
+        bufferedReader.filterLogEvents(null, kqlFilter);
+
+        const windowedReader = manage(createReader(module, data, {
+            ...DEFAULT_READER_OPTIONS,
+            checkpointInterval: CHECKPOINT_INTERVAL,
+        }));
+        windowedReader.deserializeStream();
+        windowedReader.filterLogEvents(null, kqlFilter);
+
+        expect(bufferedReader.getFilteredLogEventMap())
+            .toEqual(windowedReader.getFilteredLogEventMap());
+    });
+
+    it("should filter a windowed reader incrementally as it's deserialized", async () => {
+        const kqlFilter = "*: *error*";
+        const data = await loadTestData("structured-cockroachdb.clp.zst");
+        const bufferedReader = manage(createReader(module, data));
+        bufferedReader.deserializeStream();
+        bufferedReader.filterLogEvents(null, kqlFilter);
+        const expectedMap = bufferedReader.getFilteredLogEventMap() ?? [];
+
+        // Each batch only evaluates the query against the newly deserialized log events, resuming
+        // from the checkpoint before them.
+        const windowedReader = manage(createReader(module, data, {
+            ...DEFAULT_READER_OPTIONS,
+            checkpointInterval: CHECKPOINT_INTERVAL,
+        }));
+        windowedReader.filterLogEvents(null, kqlFilter);
+        let progress = windowedReader.deserializeNext({maxEvents: BATCH_SIZE});
+        while (false === progress.isDone) {
+            const {numEventsBuffered} = progress;
+            expect(windowedReader.getFilteredLogEventMap())
+                .toEqual(expectedMap.filter((idx) => idx < numEventsBuffered));
+            progress = windowedReader.deserializeNext({maxEvents: BATCH_SIZE});
+        }
+
+        expect(windowedReader.getFilteredLogEventMap()).toEqual(expectedMap);
+    });
+});
+
+describe("ClpStreamReader unstructured wildcard search", () => {
+    const CHECKPOINT_INTERVAL = 1000;
+
+    const {manage} = useReaderFixtures();
+
+    /**
+     * Converts a wildcard query into the equivalent regular expression, including the implicit `*`
+     * surrounding the query.
+     *
+     * @param query
+     * @return The regular expression.
+     */
+    const wildcardQueryToRegExp = (query: string) => new RegExp(
+        query.split("").map((c) => {
+            if ("*" === c) {
+                return "[\\s\\S]*";
+            }
+            if ("?" === c) {
+                return "[\\s\\S]";
+            }
+
+            return c.replace(/[.*+?^${}()|[\]\\]/g, "\\$&");
+        })
+            .join(""),
+        "u"
+    );
+
+    it.each([
+        "INFO",
+        "container_*_01_",
+        "Memory usage of ProcessTree ? for container",
+        "this query matches nothing",
+    ])("should match the same log events for %s as decoding every message", async (query) => {
+        const data = await loadTestData("unstructured-yarn.clp.zst");
+        const bufferedReader = manage(createReader(module, data));
+        const numEvents = bufferedReader.deserializeStream();
+
+        const regExp = wildcardQueryToRegExp(query);
+        const expectedMap = (bufferedReader.decodeRange(0, numEvents, false) ?? [])
+            .map(({message}, idx) => (regExp.test(message) ?
+                idx :
+                null))
+            .filter((idx) => null !== idx);
+        bufferedReader.filterLogEvents(null, query);
+        expect(bufferedReader.getFilteredLogEventMap()).toEqual(expectedMap);
+
+        const windowedReader = manage(createReader(module, data, {
+            ...DEFAULT_READER_OPTIONS,
+            checkpointInterval: CHECKPOINT_INTERVAL,
+        }));
+        windowedReader.deserializeStream();
+        windowedReader.filterLogEvents(null, query);
+        expect(windowedReader.getFilteredLogEventMap()).toEqual(expectedMap);
+
+        const selectedLogLevels = [3];
+        const logLevels = bufferedReader.getFilterDataColumns().logLevels;
+        bufferedReader.filterLogEvents(selectedLogLevels, query);
+        expect(bufferedReader.getFilteredLogEventMap()).toEqual(expectedMap.filter(
+            (idx) => selectedLogLevels.includes(logLevels[idx] ?? 0)
+        ));
+    });
+});
+
+describe("ClpStreamReader filter data columns", () => {
+    const {filenames, manage} = useReaderFixtures();
+
+    it.each(filenames)("should expose the filter data of %s as columns", async (filename) => {
+        const data = await loadTestData(filename);
+        const reader = manage(createReader(module, data));
+        const numEvents = reader.deserializeStream();
+
+        const columns = reader.getFilterDataColumns();
+        expect(columns.logLevels.length).toBe(numEvents);
+        expect(columns.timestamps.length).toBe(numEvents);
+        expect(columns.utcOffsets.length).toBe(numEvents);
+
+        const decodedResults = reader.decodeRange(0, numEvents, false) ?? [];
+        decodedResults.forEach((result, idx) => {
+            expect(columns.logLevels[idx]).toBe(result.logLevel);
+            expect(columns.timestamps[idx]).toBe(result.timestamp);
+        });
+    });
+
+    it.each(filenames)("should count and filter the log levels of %s", async (filename) => {
+        const data = await loadTestData(filename);
+        const reader = manage(createReader(module, data));
+        const numEvents = reader.deserializeStream();
+
+        const logLevels = Array.from(reader.getFilterDataColumns().logLevels);
+        const logLevelCounts = reader.getLogLevelCounts();
+        expect(logLevelCounts.reduce((sum, count) => sum + count, 0)).toBe(numEvents);
+        logLevelCounts.forEach((count, logLevel) => {
+            expect(logLevels.filter((l) => l === logLevel).length).toBe(count);
+        });
+
+        const selectedLogLevels = [1, 3, 5];
+        reader.filterLogEvents(selectedLogLevels);
+        const expectedMap = logLevels
+            .map((logLevel, idx) => (selectedLogLevels.includes(logLevel) ?
+                idx :
+                null))
+            .filter((idx) => null !== idx);
+        expect(reader.getFilteredLogEventMap()).toEqual(expectedMap);
+    });
+
+    it.each(filenames)("should compute the time histogram of %s", async (filename) => {
+        const data = await loadTestData(filename);
+        const reader = manage(createReader(module, data));
+        const numEvents = reader.deserializeStream();
+
+        const timestamps = Array.from(reader.getFilterDataColumns().timestamps);
+        const beginTs = timestamps.reduce((min, ts) => (ts < min ?
+            ts :
+            min));
+        const endTs = 1n + timestamps.reduce((max, ts) => (ts > max ?
+            ts :
+            max));
+        const numBuckets = 10;
+        const numLogLevels = reader.getLogLevelCounts().length;
+
+        expect(reader.getTimeHistogram(beginTs, endTs, numBuckets, true, false)).toBeNull();
+        expect(reader.getTimeHistogram(endTs, beginTs, numBuckets, false, false)).toBeNull();
+
+        const histogram = reader.getTimeHistogram(beginTs, endTs, numBuckets, false, false);
+        const splitHistogram = reader.getTimeHistogram(beginTs, endTs, numBuckets, false, true);
+        expect(histogram?.length).toBe(numBuckets);
+        expect(splitHistogram?.length).toBe(numBuckets * numLogLevels);
+        expect(histogram?.reduce((sum, count) => sum + count, 0)).toBe(numEvents);
+        for (let bucketIdx = 0; bucketIdx < numBuckets; ++bucketIdx) {
+            const bucketCounts = splitHistogram?.subarray(
+                bucketIdx * numLogLevels,
+                (bucketIdx + 1) * numLogLevels
+            );
+            expect(bucketCounts?.reduce((sum, count) => sum + count, 0))
+                .toBe(histogram?.[bucketIdx]);
+        }
+
+        reader.filterLogEvents([3]);
+        const filteredHistogram = reader.getTimeHistogram(beginTs, endTs, numBuckets, true, false);
+        expect(filteredHistogram?.reduce((sum, count) => sum + count, 0))
+            .toBe(reader.getFilteredLogEventMap()?.length);
+    });
+
+    it.each(filenames)(
+        "should find the nearest log events to timestamps in %s",
+        async (filename) => {
+            const data = await loadTestData(filename);
+            const reader = manage(createReader(module, data));
+            reader.deserializeStream();
+
+            const timestamps = Array.from(reader.getFilterDataColumns().timestamps);
+            const isChronological = timestamps.every(
+                (ts, idx) => 0 === idx || (timestamps[idx - 1] as bigint) <= ts
+            );
+            expect(reader.isChronological()).toBe(isChronological);
+
+            // `Array.prototype.sort` is stable, so log events with equal timestamps stay in order.
+            const chronologicalOrder = timestamps
+                .map((_, idx) => idx)
+                .sort((lhs, rhs) => Number(
+                    (timestamps[lhs] as bigint) - (timestamps[rhs] as bigint)
+                ));
+            const sortedTimestamps = chronologicalOrder.map((idx) => timestamps[idx] as bigint);
+            const targets = [
+                (sortedTimestamps.at(0) as bigint) - 1n,
+                ...sortedTimestamps.filter((_, idx) => 0 === idx % 97),
+                (sortedTimestamps.at(-1) as bigint) + 1n,
+            ];
+            for (const target of targets) {
+                const numNotAfter = sortedTimestamps.filter((ts) => ts <= target).length;
+                const expectedIdx = 0 === numNotAfter ?
+                    chronologicalOrder[0] :
+                    chronologicalOrder[numNotAfter - 1];
+                expect(reader.findNearestLogEventByTimestamp(target)).toBe(expectedIdx);
+            }
+        }
+    );
+});
+
+describe("ClpStreamReader binary decoding", () => {
+    const {filenames, manage} = useReaderFixtures();
+
+    it.each(filenames)(
+        "should decode the same log events from %s as decodeRange",
+        async (filename) => {
+            const data = await loadTestData(filename);
+            const reader = manage(createReader(module, data));
+            const numEvents = reader.deserializeStream();
+            reader.filterLogEvents([2, 3, 4, 5]);
+
+            const textDecoder = new TextDecoder();
+            for (const useFilter of [false, true]) {
+                const decodedResults = reader.decodeRange(0, numEvents, useFilter);
+                const binaryResults = reader.decodeRangeBinary(0, numEvents, useFilter);
+                if (null === decodedResults || null === binaryResults) {
+                    expect(binaryResults).toBe(decodedResults);
+                    continue;
+                }
+
+                expect(binaryResults.logEventNums.length).toBe(decodedResults.length);
+                expect(binaryResults.messageOffsets.length).toBe(decodedResults.length + 1);
+                decodedResults.forEach((result, idx) => {
+                    expect(binaryResults.logEventNums[idx]).toBe(result.logEventNum);
+                    expect(binaryResults.logLevels[idx]).toBe(result.logLevel);
+                    expect(binaryResults.timestamps[idx]).toBe(result.timestamp);
+                    expect(BigInt(binaryResults.utcOffsets[idx] ?? 0))
+                        .toBe(BigInt(result.utcOffset));
+                    expect(textDecoder.decode(binaryResults.messages.subarray(
+                        binaryResults.messageOffsets[idx],
+                        binaryResults.messageOffsets[idx + 1]
+                    ))).toBe(result.message);
+                });
+            }
+        }
+    );
+});
+
+describe("ClpStreamReader decoded message cache", () => {
+    const NUM_EVENTS_PER_PAGE = 50;
+
+    const {filenames, manage} = useReaderFixtures();
+
+    it.each(filenames)("should reuse decoded messages of %s", async (filename) => {
+        const reader = manage(createReader(module, await loadTestData(filename)));
+        reader.deserializeStream();
+
+        const firstPage = reader.decodeRange(0, NUM_EVENTS_PER_PAGE, false);
+        expect(reader.getDecodedMessageCacheStats()).toMatchObject({
+            numHits: 0,
+            numMisses: NUM_EVENTS_PER_PAGE,
+            numEntries: NUM_EVENTS_PER_PAGE,
+        });
+        expect(reader.decodeRange(0, NUM_EVENTS_PER_PAGE, false)).toEqual(firstPage);
+        expect(reader.getDecodedMessageCacheStats().numHits).toBe(NUM_EVENTS_PER_PAGE);
+
+        const binaryPage = reader.decodeRangeBinary(0, NUM_EVENTS_PER_PAGE, false);
+        expect(reader.getDecodedMessageCacheStats().numHits).toBe(2 * NUM_EVENTS_PER_PAGE);
+        expect(new TextDecoder().decode(binaryPage?.messages))
+            .toBe(firstPage?.map(({message}) => message).join(""));
+
+        reader.setDecodedMessageCacheCapacity(0);
+        expect(reader.getDecodedMessageCacheStats()).toMatchObject({
+            numEntries: 0,
+            numBytes: 0,
+            capacity: 0,
+        });
+        expect(reader.decodeRange(0, NUM_EVENTS_PER_PAGE, false)).toEqual(firstPage);
+        expect(reader.getDecodedMessageCacheStats()).toMatchObject({
+            numMisses: 2 * NUM_EVENTS_PER_PAGE,
+            numEntries: 0,
+        });
+    });
+});
+
+describe("ClpStreamReader export", () => {
+    const CHUNK_SIZE = 64 * 1024;
+    const NEWLINE = 0x0A;
+    const ISO_8601_TIMESTAMP_PATTERN =
+        /^\d{4}-\d{2}-\d{2}T\d{2}:\d{2}:\d{2}\.\d{3}(?:Z|[+-]\d{2}:\d{2})/;
+
+    const {manage} = useReaderFixtures();
+
+    /**
+     * Exports a reader's collection chunk by chunk.
+     *
+     * @param exportedReader
+     * @param useFilter
+     * @param formatTimestamps
+     * @return The exported lines.
+     */
+    const exportLines = (
+        exportedReader: ClpStreamReader,
+        useFilter: boolean,
+        formatTimestamps: boolean
+    ): string[] => {
+        const textDecoder = new TextDecoder();
+        let text = "";
+        let nextIdx = 0;
+        for (;;) {
+            const chunk = exportedReader.exportChunk(nextIdx, useFilter, {
+                chunkSize: CHUNK_SIZE,
+                formatTimestamps,
+            });
+            if (null === chunk) {
+                throw new Error("Export failed.");
+            }
+            const chunkText = textDecoder.decode(chunk.data);
+            expect(chunkText.endsWith("\n") || chunk.isDone).toBe(true);
+
+            // Only the chunk's last line may extend past the chunk size.
+            const lastLineBeginPos = chunk.data.lastIndexOf(NEWLINE, chunk.data.length - 2) + 1;
+            expect(lastLineBeginPos).toBeLessThan(CHUNK_SIZE);
+            text += chunkText;
+            ({nextIdx} = chunk);
+            if (chunk.isDone) {
+                break;
+            }
+        }
+
+        return text.split("\n").slice(0, -1);
+    };
+
+    it("should export a structured stream as JSON Lines", async () => {
+        const reader = manage(
+            createReader(module, await loadTestData("structured-cockroachdb.clp.zst"))
+        );
+        const numEvents = reader.deserializeStream();
+        const results = reader.decodeRange(0, numEvents, false) ?? [];
+
+        const lines = exportLines(reader, false, false);
+        expect(lines.length).toBe(numEvents);
+        expect(lines.map((line) => JSON.parse(line) as unknown))
+            .toEqual(results.map(({message}) => JSON.parse(message) as unknown));
+
+        const [firstLine] = exportLines(reader, false, true);
+        const {timestamp, ...kvPairs} = JSON.parse(firstLine ?? "") as Record<string, unknown>;
+        expect(timestamp).toMatch(ISO_8601_TIMESTAMP_PATTERN);
+        expect(kvPairs).toEqual(JSON.parse(results[0]?.message ?? ""));
+    });
+
+    it("should export a filtered unstructured stream as text", async () => {
+        const reader = manage(
+            createReader(module, await loadTestData("unstructured-yarn.clp.zst"))
+        );
+        const numEvents = reader.deserializeStream();
+        expect(reader.exportChunk(0, true, {})).toBeNull();
+
+        const lines = exportLines(reader, false, false);
+        expect(lines.join("\n")).toBe(
+            (reader.decodeRange(0, numEvents, false) ?? [])
+                .map(({message}) => message.replace(/\n$/, ""))
+                .join("\n")
+        );
+
+        // eslint-disable-next-line no-magic-numbers
+        reader.filterLogEvents([4, 5]);
+        const filteredResults = reader.decodeRange(
+            0,
+            reader.getFilteredLogEventMap()?.length ?? 0,
+            true
+        ) ?? [];
+        // Messages may span several lines, so only count the lines that start with a timestamp.
+        const filteredLines = exportLines(reader, true, true);
+        expect(filteredLines[0]).toMatch(ISO_8601_TIMESTAMP_PATTERN);
+        expect(filteredLines.filter((line) => ISO_8601_TIMESTAMP_PATTERN.test(line)).length)
+            .toBe(filteredResults.length);
+    });
+
+    it("should reject a non-positive chunk size", async () => {
+        const reader = manage(
+            createReader(module, await loadTestData("unstructured-yarn.clp.zst"))
+        );
+        reader.deserializeStream();
+        expect(() => reader.exportChunk(0, false, {chunkSize: 0})).toThrow();
+    });
+});
+
+describe("ClpStreamReader format templates", () => {
+    const NUM_EVENTS = 20;
+    const ISO_8601_TIMESTAMP_PATTERN =
+        /^\d{4}-\d{2}-\d{2}T\d{2}:\d{2}:\d{2}\.\d{3}(?:Z|[+-]\d{2}:\d{2})$/;
+
+    const {manage} = useReaderFixtures();
+
+    it("should render structured log events with a template", async () => {
+        const reader = manage(
+            createReader(module, await loadTestData("structured-cockroachdb.clp.zst"))
+        );
+        reader.deserializeStream();
+        const results = reader.decodeRange(0, NUM_EVENTS, false) ?? [];
+
+        const userGeneratedKey = module.MERGED_KV_PAIRS_USER_GENERATED_KEY;
+        const userGenKvPairs = results.map(({message}) => (JSON.parse(message) as
+            Record<string, Record<string, unknown>>)[userGeneratedKey] ?? {});
+        const [stringKey] = Object.entries(userGenKvPairs[0] ?? {})
+            .find(([, value]) => "string" === typeof value) ?? [];
+        expect(stringKey).toBeDefined();
+
+        reader.setFormatTemplate(`{{{user-generated.${stringKey}}}}` +
+            "{user-generated.missing-key}|{timestamp}");
+        const renderedResults = reader.decodeRange(0, NUM_EVENTS, false) ?? [];
+        expect(renderedResults.length).toBe(NUM_EVENTS);
+        renderedResults.forEach(({message}, idx) => {
+            const separatorIdx = message.lastIndexOf("|");
+            expect(message.slice(separatorIdx + 1)).toMatch(ISO_8601_TIMESTAMP_PATTERN);
+
+            // Strings are rendered as is, and other values as JSON.
+            const expectedValue = userGenKvPairs[idx]?.[stringKey ?? ""];
+            expect(message.slice(0, separatorIdx)).toBe(`{${"string" === typeof expectedValue ?
+                expectedValue :
+                JSON.stringify(expectedValue) ?? ""}}`);
+        });
+        expect(new TextDecoder().decode(reader.decodeRangeBinary(0, NUM_EVENTS, false)?.messages))
+            .toBe(renderedResults.map(({message}) => message).join(""));
+
+        reader.setFormatTemplate("");
+        expect(reader.decodeRange(0, NUM_EVENTS, false)).toEqual(results);
+    });
+
+    it("should reject invalid patterns", async () => {
+        const reader = manage(
+            createReader(module, await loadTestData("structured-cockroachdb.clp.zst"))
+        );
+        reader.deserializeStream();
+        const results = reader.decodeRange(0, NUM_EVENTS, false);
+        for (const pattern of ["{", "}", "{unknown}", "{user-generated.}", "{timestamp:%Z}"]) {
+            expect(() => reader.setFormatTemplate(pattern)).toThrow();
+        }
+        expect(reader.decodeRange(0, NUM_EVENTS, false)).toEqual(results);
+    });
+
+    it("should only allow clearing the template of unstructured streams", async () => {
+        const reader = manage(
+            createReader(module, await loadTestData("unstructured-yarn.clp.zst"))
+        );
+        expect(() => reader.setFormatTemplate("{level}")).toThrow();
+        expect(() => reader.setFormatTemplate("")).not.toThrow();
+    });
+});
+
+describe("ClpStreamReader key projection", () => {
+    const {manage} = useReaderFixtures();
+
+    it("should only decode the projected kv-pairs", async () => {
+        const data = await loadTestData("structured-cockroachdb.clp.zst");
+        const fullReader = manage(createReader(module, data));
+        const numEvents = fullReader.deserializeStream();
+        const fullResults = fullReader.decodeRange(0, numEvents, false) ?? [];
+
+        const userGeneratedKey = module.MERGED_KV_PAIRS_USER_GENERATED_KEY;
+        const [firstResult] = fullResults;
+        expect(firstResult).toBeDefined();
+        const firstUserGenKvPairs = (JSON.parse(firstResult?.message ?? "{}") as
+            Record<string, Record<string, unknown>>)[userGeneratedKey] ?? {};
+        const [projectedKey] = Object.keys(firstUserGenKvPairs);
+        expect(projectedKey).toBeDefined();
+
+        const projectedReader = manage(createReader(module, data, {
+            ...DEFAULT_READER_OPTIONS,
+            projectionKeys: [{isAutoGenerated: false, parts: [projectedKey ?? ""]}],
+        }));
+        expect(projectedReader.deserializeStream()).toBe(numEvents);
+        const projectedResults = projectedReader.decodeRange(0, numEvents, false) ?? [];
+        expect(projectedResults.length).toBe(numEvents);
+
+        projectedResults.forEach((result, idx) => {
+            const fullKvPairs = JSON.parse(fullResults[idx]?.message ?? "{}") as
+                Record<string, Record<string, unknown>>;
+            const projectedKvPairs = JSON.parse(result.message) as
+                Record<string, Record<string, unknown>>;
+            const expectedUserGenKvPairs: Record<string, unknown> = {};
+            const fullUserGenKvPairs = fullKvPairs[userGeneratedKey] ?? {};
+            if (projectedKey !== undefined && projectedKey in fullUserGenKvPairs) {
+                expectedUserGenKvPairs[projectedKey] = fullUserGenKvPairs[projectedKey];
+            }
+            expect(projectedKvPairs).toEqual({
+                [module.MERGED_KV_PAIRS_AUTO_GENERATED_KEY]: {},
+                [userGeneratedKey]: expectedUserGenKvPairs,
+            });
+        });
+    });
 });
@@ -0,0 +1,163 @@
+import {
+    afterAll,
+    beforeAll,
+    describe,
+    expect,
+    it,
+} from "vitest";
+
+import {DEFAULT_READER_OPTIONS} from "./constants.js";
+import {
+    type ClpStreamReader,
+    isNodeRuntime,
+    loadTestData,
+    type MainModule,
+} from "./utils.js";
+
+
+/**
+ * Absolute path to a Memory64 build of the Node.js module (`ClpFfiJs-node-64`). The scale test only
+ * runs if it's set, since it needs well over 4 GB of memory.
+ */
+const MEMORY64_MODULE_PATH: unknown =
+
+    // @ts-expect-error TS4111: property comes from index signature
+    import.meta.env.VITE_MEMORY64_NODE_MODULE_ABS_PATH;
+
+/**
+ * The size that the generated stream's decompressed IR must exceed, in bytes.
+ */
+// eslint-disable-next-line no-magic-numbers
+const MIN_STREAM_SIZE = 2 ** 32;
+
+/**
+ * Values of the IR protocol's constants used to split a stream into its preamble and log events.
+ */
+const IR_MAGIC_NUMBER_LENGTH = 4;
+const IR_METADATA_LENGTH_UBYTE = 0x11;
+const IR_METADATA_LENGTH_USHORT = 0x12;
+const IR_EOF = 0x00;
+
+/**
+ * Splits a decompressed unstructured IR stream into its preamble and the units that follow it,
+ * excluding the end-of-stream marker.
+ *
+ * @param ir
+ * @return The preamble and the units after it.
+ */
+const splitIrStream = (ir: Uint8Array): {preamble: Uint8Array; body: Uint8Array} => {
+    // The preamble is the magic number, the metadata's encoding type, the metadata's length type,
+    // the metadata's length, and the metadata.
+    const lengthTypeIdx = IR_MAGIC_NUMBER_LENGTH + 1;
+    const view = new DataView(ir.buffer, ir.byteOffset, ir.byteLength);
+    let preambleLength: number;
+    switch (ir[lengthTypeIdx]) {
+        case IR_METADATA_LENGTH_UBYTE:
+            preambleLength = lengthTypeIdx + 2 + view.getUint8(lengthTypeIdx + 1);
+            break;
+        case IR_METADATA_LENGTH_USHORT:
+            preambleLength = lengthTypeIdx + 3 + view.getUint16(lengthTypeIdx + 1);
+            break;
+        default:
+            throw new Error(`Unexpected metadata length type: ${ir[lengthTypeIdx]}`);
+    }
+    expect(ir.at(-1)).toBe(IR_EOF);
+
+    return {
+        preamble: ir.subarray(0, preambleLength),
+        body: ir.subarray(preambleLength, -1),
+    };
+};
+
+describe.runIf(isNodeRuntime() && "string" === typeof MEMORY64_MODULE_PATH)(
+    "ClpStreamReader Memory64 scale test",
+    () => {
+        let module: MainModule;
+        let tmpDir: string | null = null;
+        let streamPath: string;
+        let numRepetitions: number;
+        let reader: ClpStreamReader | null = null;
+        let originalReader: ClpStreamReader | null = null;
+
+        beforeAll(async () => {
+            const {default: factory} = (
+                // eslint-disable-next-line no-inline-comments
+                await import(/* @vite-ignore */ MEMORY64_MODULE_PATH as string)
+            ) as {default: () => Promise<MainModule>};
+            module = await factory();
+
+            // Generate a stream that repeats the log events of a sample stream until its
+            // decompressed size exceeds `MIN_STREAM_SIZE`. Zstandard frames can be concatenated, so
+            // the log events only need to be compressed once.
+            const {mkdtemp, open} = await import("node:fs/promises");
+            const {tmpdir} = await import("node:os");
+            const {join} = await import("node:path");
+            const {zstdCompressSync, zstdDecompressSync} = await import("node:zlib");
+
+            const data = await loadTestData("unstructured-yarn.clp.zst");
+            originalReader = new module.ClpStreamReader(data, DEFAULT_READER_OPTIONS);
+            const {preamble, body} = splitIrStream(new Uint8Array(zstdDecompressSync(data)));
+            numRepetitions = Math.ceil(MIN_STREAM_SIZE / body.length) + 1;
+
+            const dir = await mkdtemp(join(tmpdir(), "clp-ffi-js-memory64-"));
+            tmpDir = dir;
+            streamPath = join(dir, "large.clp.zst");
+            const file = await open(streamPath, "w");
+            try {
+                await file.write(zstdCompressSync(preamble));
+                const compressedBody = zstdCompressSync(body);
+                for (let i = 0; i < numRepetitions; ++i) {
+                    await file.write(compressedBody);
+                }
+                await file.write(zstdCompressSync(Uint8Array.of(IR_EOF)));
+            } finally {
+                await file.close();
+            }
+        });
+
+        afterAll(async () => {
+            reader?.delete();
+            originalReader?.delete();
+            if (null !== tmpDir) {
+                const {rm} = await import("node:fs/promises");
+                await rm(tmpDir, {recursive: true, force: true});
+            }
+        });
+
+        it("should open and filter a stream larger than 4 GB", () => {
+            if (null === originalReader) {
+                throw new Error("The original reader wasn't created.");
+            }
+            const numOriginalEvents = originalReader.deserializeStream();
+            const selectedLogLevels = [4, 5];
+            originalReader.filterLogEvents(selectedLogLevels);
+            const originalMap = originalReader.getFilteredLogEventMap() ?? [];
+            expect(originalMap.length).toBeGreaterThan(0);
+
+            reader = module.ClpStreamReader.createFromFile(streamPath, DEFAULT_READER_OPTIONS);
+            const progress = reader.deserializeNext({maxEvents: null, maxBytes: null});
+            expect(progress.isDone).toBe(true);
+            expect(progress.numBytesConsumed).toBeGreaterThan(MIN_STREAM_SIZE);
+
+            const numEvents = numRepetitions * numOriginalEvents;
+            expect(progress.numEventsBuffered).toBe(numEvents);
+            expect(reader.getNumEventsBuffered()).toBe(numEvents);
+
+            reader.filterLogEvents(selectedLogLevels);
+            const filteredMap = reader.getFilteredLogEventMap() ?? [];
+            expect(filteredMap.length).toBe(numRepetitions * originalMap.length);
+            const lastRepetitionBeginIdx = (numRepetitions - 1) * numOriginalEvents;
+            expect(filteredMap.slice(-originalMap.length))
+                .toEqual(originalMap.map((idx) => lastRepetitionBeginIdx + idx));
+
+            const [lastResult] = reader.decodeRange(numEvents - 1, numEvents, false) ?? [];
+            const [originalLastResult] = originalReader.decodeRange(
+                numOriginalEvents - 1,
+                numOriginalEvents,
+                false
+            ) ?? [];
+            expect(lastResult?.logEventNum).toBe(numEvents);
+            expect(lastResult?.message).toBe(originalLastResult?.message);
+        });
+    }
+);
@@ -0,0 +1,99 @@
+import {
+    afterEach,
+    beforeAll,
+    describe,
+    expect,
+    it,
+} from "vitest";
+
+import {DEFAULT_READER_OPTIONS} from "./constants.js";
+import {
+    type ClpMergedStreamReader,
+    type ClpStreamReader,
+    isNodeRuntime,
+    loadTestData,
+    type MainModule,
+} from "./utils.js";
+
+
+/**
+ * Absolute path to the multithreaded build of the Node.js module (`ClpFfiJs-node-mt`). The tests
+ * only run if it's set.
+ */
+const MT_MODULE_PATH: unknown =
+
+    // @ts-expect-error TS4111: property comes from index signature
+    import.meta.env.VITE_MT_NODE_MODULE_ABS_PATH;
+
+/**
+ * More readers than the default number of preallocated workers (`CLP_FFI_JS_PTHREAD_POOL_SIZE`).
+ */
+const NUM_READERS = 10;
+
+describe.runIf(isNodeRuntime() && "string" === typeof MT_MODULE_PATH)(
+    "ClpStreamReader multithreaded variant",
+    () => {
+        let module: MainModule;
+        let readers: ClpStreamReader[] = [];
+        let mergedReader: ClpMergedStreamReader | null = null;
+
+        beforeAll(async () => {
+            const {default: factory} = (
+                // eslint-disable-next-line no-inline-comments
+                await import(/* @vite-ignore */ MT_MODULE_PATH as string)
+            ) as {default: () => Promise<MainModule>};
+            module = await factory();
+        });
+
+        afterEach(() => {
+            for (const reader of readers) {
+                reader.delete();
+            }
+            readers = [];
+            mergedReader?.delete();
+            mergedReader = null;
+        });
+
+        it("should open more partially deserialized readers than there are workers", async () => {
+            const data = await loadTestData("unstructured-yarn.clp.zst");
+            const referenceReader = new module.ClpStreamReader(data, DEFAULT_READER_OPTIONS);
+            readers.push(referenceReader);
+            const numEvents = referenceReader.deserializeStream();
+            const selectedLogLevels = [4, 5];
+            referenceReader.filterLogEvents(selectedLogLevels);
+            const referenceMap = referenceReader.getFilteredLogEventMap();
+
+            // Each reader's decompression would hold a worker until its stream is fully read.
+            const partialReaders = Array.from({length: NUM_READERS}, () => {
+                const reader = new module.ClpStreamReader(data, DEFAULT_READER_OPTIONS);
+                readers.push(reader);
+                // eslint-disable-next-line no-magic-numbers
+                expect(reader.deserializeNext({maxEvents: 10}).isDone)
+                    .toBe(false);
+
+                return reader;
+            });
+
+            // Filtering while every worker may be in use shouldn't wait for one.
+            const [firstReader] = partialReaders;
+            firstReader?.filterLogEvents(selectedLogLevels);
+            for (const reader of partialReaders) {
+                expect(reader.deserializeStream()).toBe(numEvents);
+            }
+            expect(firstReader?.getFilteredLogEventMap()).toEqual(referenceMap);
+        });
+
+        it("should merge more streams than there are workers", async () => {
+            const data = await loadTestData("unstructured-yarn.clp.zst");
+            const referenceReader = new module.ClpStreamReader(data, DEFAULT_READER_OPTIONS);
+            readers.push(referenceReader);
+            const numEvents = referenceReader.deserializeStream();
+
+            mergedReader = new module.ClpMergedStreamReader(
+                Array.from({length: NUM_READERS}, () => data),
+                DEFAULT_READER_OPTIONS
+            );
+            expect(mergedReader.deserializeStream()).toBe(NUM_READERS * numEvents);
+        });
+    }
+);
@@ -37,6 +37,14 @@ const TEST_DATA_URLS: Readonly<Record<string, string>> = {
         "yarn-ubuntu-resourcemanager-ip-172-31-17-135.log.1.clp.zst",
 };
 
+/**
+ * IR stream fixtures, one of each stream type, that reader tests run against.
+ */
+const IR_STREAM_FIXTURE_FILENAMES: readonly string[] = Object.freeze([
+    "structured-cockroachdb.clp.zst",
+    "unstructured-yarn.clp.zst",
+]);
+
 /**
  * Default path to the Node.js CLP module bundle for tests.
  */
@@ -47,6 +55,11 @@ const DEFAULT_NODE_MODULE_PATH = "../dist/ClpFfiJs-node.js";
  */
 const DEFAULT_WORKER_MODULE_PATH = "../dist/ClpFfiJs-worker.js";
 
+/**
+ * Path to the compiled `clp-ffi-js-build-index` command-line tool, relative to the test directory.
+ */
+const BUILD_INDEX_CLI_PATH = "../dist/clp_ffi_js/cli/build-index.js";
+
 /**
  * Value for `IrStreamType.STRUCTURED`. Matches `StreamType::Structured` in
  * `src/clp_ffi_js/ir/StreamReader.hpp`.
@@ -61,9 +74,11 @@ const IR_STREAM_TYPE_UNSTRUCTURED = 1;
 
 
 export {
+    BUILD_INDEX_CLI_PATH,
     DEFAULT_NODE_MODULE_PATH,
     DEFAULT_READER_OPTIONS,
     DEFAULT_WORKER_MODULE_PATH,
+    IR_STREAM_FIXTURE_FILENAMES,
     IR_STREAM_TYPE_STRUCTURED,
     IR_STREAM_TYPE_UNSTRUCTURED,
     TEST_DATA_DIR_URL,
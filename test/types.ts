@@ -7,6 +7,9 @@ interface ReaderOptions {
     logLevelKey: SchemaTreePath | null;
     timestampKey: SchemaTreePath | null;
     utcOffsetKey: SchemaTreePath | null;
+    checkpointInterval?: number | null;
+    index?: Uint8Array | null;
+    projectionKeys?: SchemaTreePath[] | null;
 }
 
 
@@ -1,14 +1,19 @@
 import type {
+    ClpMergedStreamReader,
     ClpSfaReader,
     ClpStreamReader,
     MainModule,
 } from "clp-ffi-js/node";
-import {expect} from "vitest";
+import {
+    afterEach,
+    expect,
+} from "vitest";
 
 import {
     DEFAULT_NODE_MODULE_PATH,
     DEFAULT_READER_OPTIONS,
     DEFAULT_WORKER_MODULE_PATH,
+    IR_STREAM_FIXTURE_FILENAMES,
     TEST_DATA_DIR_URL,
     TEST_DATA_WEB_BASE_PATH,
 } from "./constants.js";
@@ -124,6 +129,16 @@ const readNodeFile = async (input: string | URL): Promise<Uint8Array> => {
     return new Uint8Array(await readFile(input));
 };
 
+/**
+ * Gets the path of a test data file on disk, for readers that open files directly in Node.js.
+ *
+ * @param filename The name of the file in the test data directory.
+ * @return The file's path.
+ */
+const getTestDataPath = (filename: string): string => {
+    return decodeURIComponent(new URL(filename, TEST_DATA_DIR_URL).pathname);
+};
+
 /**
  * Loads a test data file as a Uint8Array. Test data is pre-downloaded by `globalSetup.ts`.
  * In Node.js, files are read from disk. In browser, files are served by Vite's dev server.
@@ -141,8 +156,50 @@ const loadTestData = async (filename: string): Promise<Uint8Array> => {
     return fetchFile(`${TEST_DATA_WEB_BASE_PATH}${filename}`);
 };
 
+/**
+ * An Embind object, which must be deleted explicitly.
+ */
+interface Deletable {
+    delete: () => void;
+    isDeleted: () => boolean;
+}
+
+/**
+ * Sets up the fixtures shared by the reader tests in the enclosing `describe` block.
+ *
+ * Registers an `afterEach` hook that deletes the readers (or other Embind objects) each test passed
+ * to `manage`, unless the test already deleted them.
+ *
+ * @return An object containing:
+ * - filenames: The IR stream fixtures, one of each stream type, for tests that run against both.
+ * - manage: A function that takes ownership of a reader and returns it.
+ */
+const useReaderFixtures = (): {
+    filenames: readonly string[];
+    manage: <T extends Deletable>(reader: T) => T;
+} => {
+    const readers: Deletable[] = [];
+    afterEach(() => {
+        for (const reader of readers.splice(0)) {
+            if (false === reader.isDeleted()) {
+                reader.delete();
+            }
+        }
+    });
+
+    return {
+        filenames: IR_STREAM_FIXTURE_FILENAMES,
+        manage: (reader) => {
+            readers.push(reader);
+
+            return reader;
+        },
+    };
+};
+
 
 export type {
+    ClpMergedStreamReader,
     ClpSfaReader,
     ClpStreamReader,
     MainModule,
@@ -152,6 +209,9 @@ export {
     createModule,
     createReader,
     fetchFile,
+    getTestDataPath,
+    isNodeRuntime,
     loadTestData,
     readNodeFile,
+    useReaderFixtures,
 };